@@ -35,10 +35,12 @@
 
 #include "XMLaux.h"
 #include "../PrintingHandler.h"
+#include "../Simulation.h"
 
 #include "../../GeneralModel/ExternalComponents.h"
 
 #include <cstdlib>
+#include <math.h>
 #include <sstream>
 #include <vector>
 
@@ -46,11 +48,16 @@ namespace DYTSI_Input {
     Bifurcation::Bifurcation( DYTSI_Input::InputHandler* inputHandler, XERCES_CPP_NAMESPACE::DOMElement* node, int& error)
     : Input( inputHandler, node, error ) {
         std::stringstream* out;
+        pthread_mutex_init(&this->sweepMutex, NULL);
+        this->sweepLog = NULL;
         this->y0.clear();
         this->tSpan = new Range();
         this->speedRange = new Range();
         this->radiusRange = new Range();
         this->Phi_seRange = new Range();
+        this->adaptiveSpeed = false;
+        this->minSpeedStep = 0.0;
+        this->amplitudeJump = 0.1;
 
         XERCES_CPP_NAMESPACE::DOMNodeList* tSpanRangeList = node->getElementsByTagName(
                 XERCES_CPP_NAMESPACE::XMLString::transcode("TSpan"));
@@ -79,6 +86,30 @@ namespace DYTSI_Input {
                     (XERCES_CPP_NAMESPACE::DOMElement*)Phi_seRangeList->item(0), 
                     "StartValue", "EndValue", "StepSize", this->Phi_seRange);
 
+            // Optional: adaptive speed stepping
+            XERCES_CPP_NAMESPACE::DOMElement* speedRangeEl = (XERCES_CPP_NAMESPACE::DOMElement*)speedRangeList->item(0);
+            XERCES_CPP_NAMESPACE::DOMNodeList* minStepList = XMLaux::getElementsByTagName(speedRangeEl, "MinStepSize");
+            XERCES_CPP_NAMESPACE::DOMNodeList* jumpList = XMLaux::getElementsByTagName(speedRangeEl, "AmplitudeJump");
+            if (minStepList->getLength() == 1){
+                this->adaptiveSpeed = true;
+                this->minSpeedStep = XMLaux::setValueToDouble(minStepList->item(0));
+                if (jumpList->getLength() == 1)
+                    this->amplitudeJump = XMLaux::setValueToDouble(jumpList->item(0));
+                if ((this->minSpeedStep <= 0.0) || (this->minSpeedStep > fabs(this->speedRange->getStepSize())) ||
+                        (this->amplitudeJump <= 0.0) ||
+                        (this->radiusRange->getStartValue() != this->radiusRange->getEndValue()) ||
+                        (this->Phi_seRange->getStartValue() != this->Phi_seRange->getEndValue()) ||
+                        !this->getSolver()->isMonitoringConvergence()){
+                    error++;
+                    out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+                    *out << "\t\tError in parsing the input file: " << std::endl;
+                    *out << "\t\tThe adaptive SpeedRange needs 0 < MinStepSize <= |StepSize|, AmplitudeJump > 0, "
+                            << "a single radius and Phi_se and the Convergence element of the solver" << std::endl;
+                    PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+                    delete out;
+                }
+            }
+
             out = new std::stringstream(std::stringstream::in|std::stringstream::out);
             *out << "\t\tLoading Starting Values. \t" << std::flush;
             PrintingHandler::printOut(out, PrintingHandler::STDOUT);
@@ -106,6 +137,26 @@ namespace DYTSI_Input {
                 PrintingHandler::printOut(out, PrintingHandler::STDOUT);
                 delete out;
             }
+
+            // Set up the models and solvers of the concurrent jobs
+            if ((error == 0) && (Simulation::getNJobs() > 1)){
+                SweepContext mainContext = {this->model, this->solver};
+                this->sweepContexts.push_back(mainContext);
+                for (int i = 1; i < Simulation::getNJobs(); i++){
+                    out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+                    *out << "\t\tSetting up job " << i+1 << " of " << Simulation::getNJobs() << std::endl;
+                    PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+                    delete out;
+
+                    SweepContext context;
+                    // The model is copied from the one already set up (no re-parsing, no static loads)
+                    context.model = this->model->clone();
+                    if (context.model == NULL){ error = 1; return; }
+                    context.solver = this->createSolver(context.model, node, error);
+                    if (error) return;
+                    this->sweepContexts.push_back(context);
+                }
+            }
         } else {
             error = 1;
             std::stringstream out;
@@ -120,6 +171,20 @@ namespace DYTSI_Input {
     }
 
     Bifurcation::~Bifurcation() {
+        // The first context is owned by the Input
+        for (unsigned int i = 1; i < this->sweepContexts.size(); i++){
+            delete this->sweepContexts[i].solver;
+            delete this->sweepContexts[i].model;
+        }
+        pthread_mutex_destroy(&this->sweepMutex);
+    }
+
+    double Bifurcation::getCostEstimate(){
+        // One integration over tSpan for each point of the grid, shared among the jobs
+        double nPoints = this->speedRange->getNumberOfSteps() * this->radiusRange->getNumberOfSteps() *
+                this->Phi_seRange->getNumberOfSteps();
+        double nJobs = (this->sweepContexts.size() > 1) ? this->sweepContexts.size() : 1;
+        return nPoints * fabs(this->tSpan->getEndValue() - this->tSpan->getStartValue()) / nJobs;
     }
 
     DYTSI_Solver::Solution* Bifurcation::simulate(){
@@ -188,9 +253,9 @@ namespace DYTSI_Input {
 
             double* yInit;
             if (this->startingValuesUsage == Bifurcation::SV_FIRST) {
-                if ( sol->getSolutionList().size() > 0 ){
+                if ( sol->getNumberOfEntries() > 0 ){
                     // Get the last status
-                    yInit = (sol->getStatusList())[ sol->getStatusList().size() -1 ];
+                    yInit = sol->getLastStatus();
                     sol->addEntry(indexSimulation, this->tSpan->getStartValue(), yInit, 0.0);
                 } else {
                     // Load the starting values
@@ -206,56 +271,64 @@ namespace DYTSI_Input {
             }
 
 
-            exitSpeed = false;
-            while (( ((speed <= this->speedRange->getEndValue()) && (bifSpeed == 1)) ||
-                    ((speed >= this->speedRange->getEndValue()) && (bifSpeed == -1))  || (bifSpeed == 0)) &&
-                    (errCode == GSL_SUCCESS)) {
-
-                radius = this->radiusRange->getStartValue();
-                exitRadius = false;
-                while ((    ((radius <= this->radiusRange->getEndValue()) && (bifRadius == 1)) ||
-                            ((radius >= this->radiusRange->getEndValue()) && (bifRadius == -1))  || (bifRadius == 0))&&
-                            (errCode == GSL_SUCCESS)) {
-
-                    phi_se = this->Phi_seRange->getStartValue();
-                    exitPhi_se = false;
-                    while ((    ((phi_se <= this->Phi_seRange->getEndValue()) && (bifPhi_se == 1)) ||
-                                ((phi_se >= this->Phi_seRange->getEndValue()) && (bifPhi_se == -1)) || (bifPhi_se == 0)) &&
-                            (errCode == GSL_SUCCESS)) {
-
-                        this->getModel()->getExternalComponents()->set_v( speed );
-                        this->getModel()->getExternalComponents()->set_R( radius );
-                        this->getModel()->getExternalComponents()->set_Phi_se( phi_se );
-
-                        if (this->startingValuesUsage == Bifurcation::SV_FIRST) {
-                            // Get the last status
-                            yInit = (sol->getStatusList())[ sol->getStatusList().size() -1 ];
-                        } else if (this->startingValuesUsage == Bifurcation::SV_ALL){
-                            // Load the starting values
-                            yInit = new double[this->getModel()->get_N_DOF()];
-                            for (int i = 0; i < this->getModel()->get_N_DOF(); i++) yInit[i] = this->y0[i];
-                        }
+            if (this->adaptiveSpeed){
+                // Sequential: each step depends on the amplitude of the previous one
+                errCode = this->adaptiveSweep(indexSimulation, yInit, *sol);
+            } else if (this->sweepContexts.size() > 1){
+                // Concurrent sweep
+                errCode = this->sweep(indexSimulation, yInit, *sol);
+            } else {
+                exitSpeed = false;
+                while (( ((speed <= this->speedRange->getEndValue()) && (bifSpeed == 1)) ||
+                        ((speed >= this->speedRange->getEndValue()) && (bifSpeed == -1))  || (bifSpeed == 0)) &&
+                        (errCode == GSL_SUCCESS)) {
+
+                    radius = this->radiusRange->getStartValue();
+                    exitRadius = false;
+                    while ((    ((radius <= this->radiusRange->getEndValue()) && (bifRadius == 1)) ||
+                                ((radius >= this->radiusRange->getEndValue()) && (bifRadius == -1))  || (bifRadius == 0))&&
+                                (errCode == GSL_SUCCESS)) {
+
+                        phi_se = this->Phi_seRange->getStartValue();
+                        exitPhi_se = false;
+                        while ((    ((phi_se <= this->Phi_seRange->getEndValue()) && (bifPhi_se == 1)) ||
+                                    ((phi_se >= this->Phi_seRange->getEndValue()) && (bifPhi_se == -1)) || (bifPhi_se == 0)) &&
+                                (errCode == GSL_SUCCESS)) {
+
+                            this->getModel()->getExternalComponents()->set_v( speed );
+                            this->getModel()->getExternalComponents()->set_R( radius );
+                            this->getModel()->getExternalComponents()->set_Phi_se( phi_se );
+
+                            if (this->startingValuesUsage == Bifurcation::SV_FIRST) {
+                                // Get the last status
+                                yInit = sol->getLastStatus();
+                            } else if (this->startingValuesUsage == Bifurcation::SV_ALL){
+                                // Load the starting values
+                                yInit = new double[this->getModel()->get_N_DOF()];
+                                for (int i = 0; i < this->getModel()->get_N_DOF(); i++) yInit[i] = this->y0[i];
+                            }
                         
-                        errCode = this->getSolver()->solve(indexSimulation, yInit, this->tSpan, *sol);
-                        indexSimulation++;
+                            errCode = this->getSolver()->solve(indexSimulation, yInit, this->tSpan, *sol);
+                            indexSimulation++;
+
+                            if (bifPhi_se == 0)
+                                break;
+                            else
+                                phi_se += this->Phi_seRange->getStepSize();
 
-                        if (bifPhi_se == 0)
+                        }
+
+                        if (bifRadius == 0)
                             break;
                         else
-                            phi_se += this->Phi_seRange->getStepSize();
-
+                            radius += this->radiusRange->getStepSize();
                     }
 
-                    if (bifRadius == 0)
+                    if (bifSpeed == 0)
                         break;
                     else
-                        radius += this->radiusRange->getStepSize();
+                        speed += this->speedRange->getStepSize();
                 }
-
-                if (bifSpeed == 0)
-                    break;
-                else
-                    speed += this->speedRange->getStepSize();
             }
         }
 
@@ -268,4 +341,315 @@ namespace DYTSI_Input {
 
         return sol;
     }
+
+    /**
+     * Sweep the speed range with adaptive steps (radius and Phi_se at their start
+     * values). A run whose amplitude jumps with respect to the last accepted speed
+     * is kept in the output but not accepted: the step is halved and the next run
+     * starts again from the last accepted speed, until the step is MinStepSize.
+     * Every run takes the next index, as in the fixed step sweep.
+     * yFirst is the starting status of the first run.
+     */
+    int Bifurcation::adaptiveSweep(int& index, double* yFirst, DYTSI_Solver::Solution& sol){
+        std::stringstream* out;
+        int n_dof = this->getModel()->get_N_DOF();
+        int errCode = GSL_SUCCESS;
+
+        double startSpeed = this->speedRange->getStartValue();
+        double endSpeed = this->speedRange->getEndValue();
+        double direction = (endSpeed >= startSpeed) ? 1.0 : -1.0;
+        double coarseStep = fabs(this->speedRange->getStepSize());
+        double step = coarseStep;
+
+        this->getModel()->getExternalComponents()->set_R( this->radiusRange->getStartValue() );
+        this->getModel()->getExternalComponents()->set_Phi_se( this->Phi_seRange->getStartValue() );
+
+        // Starting status of the runs: last status of the accepted speed (SV_FIRST) or y0 (SV_ALL)
+        std::vector<double> yAccepted(yFirst, yFirst + n_dof);
+        if (this->startingValuesUsage == Bifurcation::SV_ALL)
+            yAccepted.assign(this->y0.begin(), this->y0.end());
+
+        DYTSI_Solver::RunSummary accepted;
+        double speed = startSpeed;
+        bool first = true;
+        while (errCode == GSL_SUCCESS){
+            double nextSpeed = speed;
+            if (!first){
+                nextSpeed = speed + direction * step;
+                // Do not step past the end of the range
+                if (direction * (nextSpeed - endSpeed) > -1e-9 * coarseStep)
+                    nextSpeed = endSpeed;
+            }
+
+            this->getModel()->getExternalComponents()->set_v( nextSpeed );
+            errCode = this->getSolver()->solve(index, &yAccepted[0], this->tSpan, sol);
+            index++;
+            if (errCode != GSL_SUCCESS)
+                break;
+
+            DYTSI_Solver::RunSummary run = sol.getRunList().back();
+            bool jump = !first && this->isAmplitudeJump(accepted, run);
+            if (jump && (step > this->minSpeedStep)){
+                step = (0.5 * step > this->minSpeedStep) ? 0.5 * step : this->minSpeedStep;
+
+                out = new std::stringstream(std::stringstream::in | std::stringstream::out);
+                *out << "\t Amplitude jump between speed " << speed << " and " << nextSpeed
+                        << ": speed step refined to " << step << std::endl;
+                PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+                delete out;
+                continue;
+            }
+
+            // Accept the speed, going back to coarser steps while the amplitude is steady
+            if (!first && !jump && (step < coarseStep))
+                step = (2.0 * step < coarseStep) ? 2.0 * step : coarseStep;
+            accepted = run;
+            speed = nextSpeed;
+            first = false;
+            if (this->startingValuesUsage == Bifurcation::SV_FIRST)
+                memcpy(&yAccepted[0], sol.getLastStatus(), n_dof * sizeof(double));
+
+            if (speed == endSpeed)
+                break;
+        }
+
+        return errCode;
+    }
+
+    /**
+     * True if the amplitudes of the runs a and b differ by more than the relative
+     * AmplitudeJump (the stable runs have amplitude 0).
+     */
+    bool Bifurcation::isAmplitudeJump(const DYTSI_Solver::RunSummary& a, const DYTSI_Solver::RunSummary& b){
+        double aAmplitude = fabs(a.amplitude);
+        double bAmplitude = fabs(b.amplitude);
+        double maxAmplitude = (aAmplitude > bAmplitude) ? aAmplitude : bAmplitude;
+        return (maxAmplitude > 0.0) && (fabs(aAmplitude - bAmplitude) > this->amplitudeJump * maxAmplitude);
+    }
+
+    /**
+     * List the grid points in the order of the sequential sweep, grouped by speed.
+     */
+    void Bifurcation::buildGrid(int firstIndex, std::vector< std::vector<SweepPoint> >& speedLines){
+        double speed = this->speedRange->getStartValue();
+        double endSpeed = this->speedRange->getEndValue();
+        double endRadius = this->radiusRange->getEndValue();
+        double endPhi_se = this->Phi_seRange->getEndValue();
+
+        // bif... is -1 if the values goes downward, 0 if they don't change, 1 if they go upward
+        int bifSpeed = (speed == endSpeed) ? 0 : ((speed > endSpeed) ? -1 : 1);
+        int bifRadius = (this->radiusRange->getStartValue() == endRadius) ? 0 :
+            ((this->radiusRange->getStartValue() > endRadius) ? -1 : 1);
+        int bifPhi_se = (this->Phi_seRange->getStartValue() == endPhi_se) ? 0 :
+            ((this->Phi_seRange->getStartValue() > endPhi_se) ? -1 : 1);
+
+        int index = firstIndex;
+        speedLines.clear();
+        while (((speed <= endSpeed) && (bifSpeed == 1)) || ((speed >= endSpeed) && (bifSpeed == -1)) || (bifSpeed == 0)) {
+            std::vector<SweepPoint> line;
+
+            double radius = this->radiusRange->getStartValue();
+            while (((radius <= endRadius) && (bifRadius == 1)) || ((radius >= endRadius) && (bifRadius == -1)) || (bifRadius == 0)) {
+
+                double phi_se = this->Phi_seRange->getStartValue();
+                while (((phi_se <= endPhi_se) && (bifPhi_se == 1)) || ((phi_se >= endPhi_se) && (bifPhi_se == -1)) || (bifPhi_se == 0)) {
+                    SweepPoint point = {index, speed, radius, phi_se};
+                    line.push_back(point);
+                    index++;
+
+                    if (bifPhi_se == 0)
+                        break;
+                    else
+                        phi_se += this->Phi_seRange->getStepSize();
+                }
+
+                if (bifRadius == 0)
+                    break;
+                else
+                    radius += this->radiusRange->getStepSize();
+            }
+            speedLines.push_back(line);
+
+            if (bifSpeed == 0)
+                break;
+            else
+                speed += this->speedRange->getStepSize();
+        }
+    }
+
+    /**
+     * Sweep the grid with one job for each context. The calling thread takes
+     * part in the sweep and returns when all the segments have been written.
+     * yFirst is the starting status of the first segment.
+     */
+    int Bifurcation::sweep(int firstIndex, double* yFirst, DYTSI_Solver::Solution& sol){
+        std::stringstream* out;
+
+        std::vector< std::vector<SweepPoint> > speedLines;
+        this->buildGrid(firstIndex, speedLines);
+
+        double* yStart = new double[this->getModel()->get_N_DOF()];
+        for (int i = 0; i < this->getModel()->get_N_DOF(); i++) yStart[i] = this->y0[i];
+
+        // Split the grid in segments
+        this->segments.clear();
+        if (this->startingValuesUsage == Bifurcation::SV_ALL){
+            for (unsigned int i = 0; i < speedLines.size(); i++){
+                for (unsigned int j = 0; j < speedLines[i].size(); j++){
+                    SweepSegment* segment = new SweepSegment();
+                    segment->points.push_back(speedLines[i][j]);
+                    this->segments.push_back(segment);
+                }
+            }
+        } else if (this->startingValuesUsage == Bifurcation::SV_FIRST) {
+            unsigned int nChunks = this->sweepContexts.size();
+            if (nChunks > speedLines.size()) nChunks = speedLines.size();
+            unsigned int line = 0;
+            for (unsigned int i = 0; i < nChunks; i++){
+                // Balance the number of speeds in the chunks
+                unsigned int chunkSize = (speedLines.size() - line) / (nChunks - i);
+                SweepSegment* segment = new SweepSegment();
+                for (unsigned int l = line; l < line + chunkSize; l++)
+                    segment->points.insert(segment->points.end(), speedLines[l].begin(), speedLines[l].end());
+                line += chunkSize;
+                this->segments.push_back(segment);
+            }
+        }
+        for (unsigned int i = 0; i < this->segments.size(); i++){
+            this->segments[i]->position = i;
+            this->segments[i]->yInit = (i == 0) ? yFirst : yStart;
+            this->segments[i]->sol = NULL;
+            this->segments[i]->errCode = GSL_SUCCESS;
+            this->segments[i]->done = false;
+        }
+
+        out = new std::stringstream(std::stringstream::in | std::stringstream::out);
+        *out << "\t Concurrent sweep: " << this->segments.size() << " segments on "
+                << this->sweepContexts.size() << " jobs" << std::endl;
+        PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+        delete out;
+
+        this->freeContexts.clear();
+        for (unsigned int i = 0; i < this->sweepContexts.size(); i++){
+            this->sweepContexts[i].solver->setVerbose(false);
+            this->freeContexts.push_back(&this->sweepContexts[i]);
+        }
+        this->nextSegment = 0;
+        this->failedSegment = this->segments.size();
+        this->sweepSolution = &sol;
+        // The jobs run on the threads of the pool, which do not share the buffer of the caller
+        this->sweepLog = NULL;
+        if (PrintingHandler::isBuffering())
+            this->sweepLog = new std::stringstream(std::stringstream::in | std::stringstream::out);
+
+        // Run the segments
+        DYTSI_Modelling::WorkerPool pool(this->sweepContexts.size() - 1);
+        DYTSI_Modelling::WorkerPool::TaskGroup group;
+        for (unsigned int i = 0; i < this->segments.size(); i++)
+            pool.fork(group, this, this->segments[i]);
+        pool.join(group);
+
+        if (this->sweepLog != NULL){
+            PrintingHandler::printOut(this->sweepLog, PrintingHandler::STDOUT);
+            delete this->sweepLog;
+            this->sweepLog = NULL;
+        }
+
+        int errCode = GSL_SUCCESS;
+        if (this->failedSegment < this->segments.size())
+            errCode = this->segments[this->failedSegment]->errCode;
+
+        for (unsigned int i = 0; i < this->sweepContexts.size(); i++)
+            this->sweepContexts[i].solver->setVerbose(true);
+        for (unsigned int i = 0; i < this->segments.size(); i++){
+            if (this->segments[i]->sol != NULL)
+                delete this->segments[i]->sol;
+            delete this->segments[i];
+        }
+        this->segments.clear();
+        delete [] yStart;
+
+        return errCode;
+    }
+
+    /**
+     * Integrate the points of a segment (arg) on a free context.
+     */
+    void Bifurcation::Execute(void* arg){
+        SweepSegment* segment = (SweepSegment*) arg;
+
+        // Skip the segments following a failure, as the sequential sweep does
+        pthread_mutex_lock(&this->sweepMutex);
+        if (segment->position > this->failedSegment){
+            segment->done = true;
+            pthread_mutex_unlock(&this->sweepMutex);
+            return;
+        }
+        SweepContext* context = this->freeContexts.back();
+        this->freeContexts.pop_back();
+        pthread_mutex_unlock(&this->sweepMutex);
+
+        // The entries are kept in memory until all the previous segments are written
+        segment->sol = new DYTSI_Solver::Solution(context->model, NULL);
+        double* yInit = segment->yInit;
+        for (unsigned int i = 0; i < segment->points.size(); i++){
+            SweepPoint& point = segment->points[i];
+            context->model->getExternalComponents()->set_v( point.speed );
+            context->model->getExternalComponents()->set_R( point.radius );
+            context->model->getExternalComponents()->set_Phi_se( point.phi_se );
+
+            segment->errCode = context->solver->solve(point.index, yInit, this->tSpan, *segment->sol);
+            if (segment->errCode != GSL_SUCCESS){
+                // Drop the points that will not be integrated
+                segment->points.resize(i+1);
+                break;
+            }
+
+            if (this->startingValuesUsage == Bifurcation::SV_FIRST) {
+                // Get the last status
+                yInit = segment->sol->getLastStatus();
+            }
+        }
+
+        pthread_mutex_lock(&this->sweepMutex);
+        this->freeContexts.push_back(context);
+        segment->done = true;
+        if ((segment->errCode != GSL_SUCCESS) && (segment->position < this->failedSegment))
+            this->failedSegment = segment->position;
+        this->flushSegments();
+        pthread_mutex_unlock(&this->sweepMutex);
+    }
+
+    /**
+     * Write the completed segments that follow the last written one.
+     * Called with the sweep mutex locked.
+     */
+    void Bifurcation::flushSegments(){
+        std::stringstream* out;
+        while ((this->nextSegment < this->segments.size()) && (this->nextSegment <= this->failedSegment) &&
+                this->segments[this->nextSegment]->done){
+            SweepSegment* segment = this->segments[this->nextSegment];
+
+            this->sweepSolution->append(*segment->sol);
+            delete segment->sol;
+            segment->sol = NULL;
+
+            out = new std::stringstream(std::stringstream::in | std::stringstream::out);
+            for (unsigned int i = 0; i < segment->points.size(); i++){
+                *out << "\t Point " << segment->points[i].index << ": Speed " << segment->points[i].speed
+                        << ", Radius " << segment->points[i].radius << ", Phi_se " << segment->points[i].phi_se;
+                if ((segment->errCode != GSL_SUCCESS) && (i == segment->points.size() - 1))
+                    *out << "\t[FAILED]" << std::endl;
+                else
+                    *out << "\t[DONE]" << std::endl;
+            }
+            if (this->sweepLog != NULL)
+                *this->sweepLog << out->str();
+            else
+                PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+            delete out;
+
+            this->nextSegment++;
+        }
+    }
 }
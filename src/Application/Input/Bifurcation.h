@@ -37,14 +37,34 @@
 #include "Input.h"
 #include "Range.h"
 
+#include "../../GeneralModel/WorkerPool.h"
+
 #include <xercesc/dom/DOM.hpp>
 #include <xercesc/dom/DOMNode.hpp>
 
+#include <pthread.h>
+#include <sstream>
 #include <vector>
 
 namespace DYTSI_Input {
 
-    class Bifurcation : public Input{
+    /**
+     * Bifurcation analysis over the speed x radius x Phi_se grid.
+     *
+     * When more than one job is requested (-j N) the grid is swept concurrently,
+     * each job working on its own copy of the model and of the solver:
+     * with SV_ALL every grid point is an independent job, with SV_FIRST the
+     * speed axis is split in N chunks, each one doing its own continuation
+     * starting from the starting values. The entries are written to the output
+     * in the same order of the sequential sweep.
+     *
+     * If the SpeedRange has a MinStepSize (and the solver a Convergence element)
+     * the speed axis is swept adaptively at fixed radius and Phi_se: StepSize is
+     * the coarse step, halved down to MinStepSize when the limit cycle amplitude
+     * of two consecutive speeds differs by more than AmplitudeJump (relative,
+     * default 0.1), and doubled back once the amplitude is steady again.
+     */
+    class Bifurcation : public Input, public DYTSI_Modelling::Task{
     public:
         enum StartingValuesUsage {SV_FIRST, SV_ALL};
 
@@ -52,12 +72,60 @@ namespace DYTSI_Input {
         virtual ~Bifurcation();
 
         DYTSI_Solver::Solution* simulate();
+        double getCostEstimate();
+
+        // Implementation of virtual Task methods
+        void Execute(void* arg);
     private:
         StartingValuesUsage startingValuesUsage;
         Range* tSpan;
         Range* speedRange;
         Range* radiusRange;
         Range* Phi_seRange;
+
+        // Adaptive speed stepping
+        bool adaptiveSpeed;
+        double minSpeedStep;
+        double amplitudeJump;
+
+        // Model and solver owned by one of the concurrent jobs
+        struct SweepContext {
+            DYTSI_Modelling::GeneralModel* model;
+            DYTSI_Solver::Solver* solver;
+        };
+
+        struct SweepPoint {
+            int index;
+            double speed;
+            double radius;
+            double phi_se;
+        };
+
+        // Consecutive grid points integrated by one job
+        struct SweepSegment {
+            unsigned int position; // Position in the output ordering
+            std::vector<SweepPoint> points;
+            double* yInit;
+            DYTSI_Solver::Solution* sol; // Entries waiting to be written
+            int errCode;
+            bool done;
+        };
+
+        std::vector<SweepContext> sweepContexts;
+        std::vector<SweepContext*> freeContexts;
+        std::vector<SweepSegment*> segments;
+        unsigned int nextSegment; // First segment not written yet
+        unsigned int failedSegment; // First segment that failed
+        DYTSI_Solver::Solution* sweepSolution;
+        // Progress of the sweep, collected for the calling thread if its output is buffered
+        std::stringstream* sweepLog;
+        pthread_mutex_t sweepMutex;
+
+        void buildGrid(int firstIndex, std::vector< std::vector<SweepPoint> >& speedLines);
+        int sweep(int firstIndex, double* yFirst, DYTSI_Solver::Solution& sol);
+        void flushSegments();
+        int adaptiveSweep(int& index, double* yFirst, DYTSI_Solver::Solution& sol);
+        bool isAmplitudeJump(const DYTSI_Solver::RunSummary& a, const DYTSI_Solver::RunSummary& b);
     };
 }
 
@@ -0,0 +1,280 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+
+#include "CriticalSpeed.h"
+
+#include "XMLaux.h"
+#include "../PrintingHandler.h"
+
+#include "../../GeneralModel/ExternalComponents.h"
+
+#include <math.h>
+#include <string.h>
+#include <sstream>
+#include <vector>
+
+namespace DYTSI_Input{
+    CriticalSpeed::CriticalSpeed( DYTSI_Input::InputHandler* inputHandler, XERCES_CPP_NAMESPACE::DOMElement* el, int& error)
+    : Input( inputHandler, el, error ) {
+        std::stringstream* out;
+        this->y0.clear();
+        this->tSpan = new Range();
+        this->speedRange = new Range();
+
+        XERCES_CPP_NAMESPACE::DOMNodeList* tSpanRangeList = XMLaux::getElementsByTagName(el, "TSpan");
+        XERCES_CPP_NAMESPACE::DOMNodeList* speedRangeList = XMLaux::getElementsByTagName(el, "SpeedRange");
+        XERCES_CPP_NAMESPACE::DOMNodeList* radiusList = XMLaux::getElementsByTagName(el, "Radius");
+        XERCES_CPP_NAMESPACE::DOMNodeList* Phi_seList = XMLaux::getElementsByTagName(el, "Phi_se");
+        XERCES_CPP_NAMESPACE::DOMNodeList* speedToleranceList = XMLaux::getElementsByTagName(el, "SpeedTolerance");
+        XERCES_CPP_NAMESPACE::DOMNodeList* startingValuesList = XMLaux::getElementsByTagName(el, "StartingValues");
+
+        if ((speedRangeList->getLength() == 1) && (radiusList->getLength() == 1) &&
+                (Phi_seList->getLength() == 1) && (speedToleranceList->getLength() == 1) &&
+                (startingValuesList->getLength() == 1) && (tSpanRangeList->getLength() == 1)){
+            error += XMLaux::setRange(
+                    (XERCES_CPP_NAMESPACE::DOMElement*)tSpanRangeList->item(0), "StartValue", "EndValue", "", this->tSpan);
+            error += XMLaux::setRange(
+                    (XERCES_CPP_NAMESPACE::DOMElement*)speedRangeList->item(0),
+                    "StartValue", "EndValue", "StepSize", this->speedRange);
+            this->radius = XMLaux::setValueToDouble(radiusList->item(0));
+            this->Phi_se = XMLaux::setValueToDouble(Phi_seList->item(0));
+            this->speedTolerance = XMLaux::setValueToDouble(speedToleranceList->item(0));
+
+            if ((this->speedRange->getStartValue() >= this->speedRange->getEndValue()) ||
+                    (fabs(this->speedRange->getStepSize()) <= 0.0) || (this->speedTolerance <= 0.0) ||
+                    !this->getSolver()->isMonitoringConvergence()){
+                error++;
+                out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+                *out << "\t\tError in parsing the input file: " << std::endl;
+                *out << "\t\tThe CriticalSpeed input needs StartValue < EndValue and StepSize != 0 in SpeedRange, "
+                        << "SpeedTolerance > 0 and the Convergence element of the solver" << std::endl;
+                PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+                delete out;
+                return;
+            }
+
+            out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+            *out << "\t\tLoading Starting Values. \t" << std::flush;
+            PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+            delete out;
+            error += this->getModel()->setStartingValues((XERCES_CPP_NAMESPACE::DOMElement*)startingValuesList->item(0), this->y0);
+            if (error > 0){
+                out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+                *out << "[FAILED]" << std::endl;
+                PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+                delete out;
+            } else {
+                out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+                *out << "[DONE]" << std::endl;
+                PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+                delete out;
+            }
+        } else {
+            error = 1;
+            std::stringstream out;
+            out << "Error in parsing the input file: " << std::endl;
+            out << "\t " << this->getTestName() << ": The CriticalSpeed input has not the proper number of arguments." << std::endl;
+            out << "\t \t SpeedRange Size: \t" << speedRangeList->getLength() << std::endl;
+            out << "\t \t Radius Size: \t" << radiusList->getLength() << std::endl;
+            out << "\t \t Phi_se Size: \t" << Phi_seList->getLength() << std::endl;
+            out << "\t \t SpeedTolerance Size: \t" << speedToleranceList->getLength() << std::endl;
+            out << "\t \t StartingValue Size: \t" << startingValuesList->getLength() << std::endl;
+            PrintingHandler::printOut(&out, PrintingHandler::STDERR);
+        }
+    }
+
+    CriticalSpeed::~CriticalSpeed() {
+    }
+
+    double CriticalSpeed::getCostEstimate(){
+        // Bracketing over the range and two bisections
+        double range = this->speedRange->getEndValue() - this->speedRange->getStartValue();
+        double step = fabs(this->speedRange->getStepSize());
+        double nBisections = ceil(log(step / this->speedTolerance) / log(2.0));
+        if (nBisections < 0.0) nBisections = 0.0;
+        double nProbes = ceil(range / step) + 1.0 + 2.0 * nBisections;
+        return nProbes * fabs(this->tSpan->getEndValue() - this->tSpan->getStartValue());
+    }
+
+    DYTSI_Solver::Solution* CriticalSpeed::simulate(){
+        int indexSimulation = 0;
+        int errCode = GSL_SUCCESS;
+        int n_dof = this->getModel()->get_N_DOF();
+
+        std::stringstream* out;
+
+        // Create a new solution structure
+        DYTSI_Solver::Solution* sol = new DYTSI_Solver::Solution(this->getModel(), this->getOutputHandler());
+
+        out = new std::stringstream(std::stringstream::in | std::stringstream::out);
+        *out << std::endl << "#####################################" << std::endl;
+        *out << "\t Critical Speed Analysis: " << this->getTestName() << std::endl;
+        PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+        delete out;
+
+        this->getModel()->getExternalComponents()->set_R(this->radius);
+        this->getModel()->getExternalComponents()->set_Phi_se(this->Phi_se);
+
+        double startSpeed = this->speedRange->getStartValue();
+        double endSpeed = this->speedRange->getEndValue();
+        double step = fabs(this->speedRange->getStepSize());
+
+        std::vector<double> yPerturbed(this->y0.begin(), this->y0.end());
+        // Last status of the lowest sustaining speed found
+        std::vector<double> yHunting(n_dof);
+        bool sustained = false;
+
+        // Linear critical speed: bracket upward from the perturbed equilibrium
+        double lower = startSpeed;
+        double upper = startSpeed;
+        bool linearFound = false;
+        double speed = startSpeed;
+        while (errCode == GSL_SUCCESS){
+            errCode = this->probe(indexSimulation, speed, &yPerturbed[0], *sol, sustained);
+            if (errCode != GSL_SUCCESS)
+                break;
+            if (sustained){
+                upper = speed;
+                linearFound = true;
+                memcpy(&yHunting[0], sol->getLastStatus(), n_dof * sizeof(double));
+                break;
+            }
+            lower = speed;
+            if (speed >= endSpeed)
+                break;
+            speed = (speed + step < endSpeed) ? speed + step : endSpeed;
+        }
+        bool linearBracketed = linearFound && (upper > lower);
+
+        // Bisection of the bracket
+        while (linearBracketed && (errCode == GSL_SUCCESS) && (upper - lower > this->speedTolerance)){
+            speed = 0.5 * (lower + upper);
+            errCode = this->probe(indexSimulation, speed, &yPerturbed[0], *sol, sustained);
+            if (errCode != GSL_SUCCESS)
+                break;
+            if (sustained){
+                upper = speed;
+                memcpy(&yHunting[0], sol->getLastStatus(), n_dof * sizeof(double));
+            } else {
+                lower = speed;
+            }
+        }
+        double linearLower = lower;
+        double linearUpper = upper;
+
+        // Nonlinear critical speed: bracket downward continuing the hunting motion
+        bool nonlinearBracketed = false;
+        if (linearFound && (errCode == GSL_SUCCESS)){
+            upper = linearUpper;
+            speed = upper;
+            while ((errCode == GSL_SUCCESS) && (speed > startSpeed)){
+                speed = (speed - step > startSpeed) ? speed - step : startSpeed;
+                errCode = this->probe(indexSimulation, speed, &yHunting[0], *sol, sustained);
+                if (errCode != GSL_SUCCESS)
+                    break;
+                if (sustained){
+                    upper = speed;
+                    memcpy(&yHunting[0], sol->getLastStatus(), n_dof * sizeof(double));
+                } else {
+                    lower = speed;
+                    nonlinearBracketed = true;
+                    break;
+                }
+            }
+
+            while (nonlinearBracketed && (errCode == GSL_SUCCESS) && (upper - lower > this->speedTolerance)){
+                speed = 0.5 * (lower + upper);
+                errCode = this->probe(indexSimulation, speed, &yHunting[0], *sol, sustained);
+                if (errCode != GSL_SUCCESS)
+                    break;
+                if (sustained){
+                    upper = speed;
+                    memcpy(&yHunting[0], sol->getLastStatus(), n_dof * sizeof(double));
+                } else {
+                    lower = speed;
+                }
+            }
+        }
+
+        // Ending the critical speed analysis
+        out = new std::stringstream(std::stringstream::in | std::stringstream::out);
+        *out << std::endl << "\t Probes: " << indexSimulation << std::endl;
+        if (errCode != GSL_SUCCESS)
+            *out << "\t The analysis stopped on a failed probe" << std::endl;
+        if (linearBracketed)
+            *out << "\t Linear critical speed: " << linearUpper << "\t[" << linearLower << ", " << linearUpper << "]" << std::endl;
+        else if (linearFound)
+            *out << "\t Linear critical speed: below " << startSpeed << std::endl;
+        else if (errCode == GSL_SUCCESS)
+            *out << "\t Linear critical speed: above " << endSpeed << std::endl;
+        if (nonlinearBracketed)
+            *out << "\t Nonlinear critical speed: " << upper << "\t[" << lower << ", " << upper << "]" << std::endl;
+        else if (linearFound && (errCode == GSL_SUCCESS))
+            *out << "\t Nonlinear critical speed: below " << upper << std::endl;
+        *out << std::endl << "\t Critical Speed Analysis: " << this->getTestName() << "\t[DONE]"<< std::endl;
+        *out << "#####################################" << std::endl;
+        PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+        delete out;
+
+        return sol;
+    }
+
+    /**
+     * Integrate one probe at speed from yStart with the next index.
+     * sustained tells if the motion does not decay.
+     */
+    int CriticalSpeed::probe(int& index, double speed, double* yStart, DYTSI_Solver::Solution& sol, bool& sustained){
+        this->getModel()->getExternalComponents()->set_v(speed);
+        int errCode = this->getSolver()->solve(index, yStart, this->tSpan, sol);
+        index++;
+        if (errCode != GSL_SUCCESS)
+            return errCode;
+
+        sustained = this->isSustained(sol.getRunList().back());
+
+        std::stringstream* out = new std::stringstream(std::stringstream::in | std::stringstream::out);
+        *out << "\t Probe " << index - 1 << ": Speed " << speed << "\t" << (sustained ? "[SUSTAINED]" : "[DECAYING]") << std::endl;
+        PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+        delete out;
+
+        return errCode;
+    }
+
+    /**
+     * Stable runs decay and periodic runs sustain. The undecided runs sustain if
+     * the amplitude of their cycles is not shrinking.
+     */
+    bool CriticalSpeed::isSustained(const DYTSI_Solver::RunSummary& summary){
+        switch (summary.runClass){
+            case DYTSI_Solver::RUN_STABLE:
+                return false;
+            case DYTSI_Solver::RUN_PERIODIC:
+                return true;
+            default:
+                return summary.growth >= 1.0;
+        }
+    }
+}
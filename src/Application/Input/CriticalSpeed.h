@@ -0,0 +1,76 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+
+#ifndef CRITICALSPEED_H
+#define	CRITICALSPEED_H
+
+#include "Input.h"
+#include "Range.h"
+
+#include <xercesc/dom/DOM.hpp>
+#include <xercesc/dom/DOMNode.hpp>
+
+#include <vector>
+
+namespace DYTSI_Input {
+
+    /**
+     * Location of the linear and of the nonlinear critical speed by bracketing
+     * and bisection on the speed, at fixed radius and Phi_se.
+     *
+     * Each probe is a transient over TSpan classified by the Convergence monitor
+     * of the solver as decaying (stable, or undecided with shrinking cycles) or
+     * sustaining (periodic, or undecided with growing cycles):
+     *  - linear critical speed: the probes start from the StartingValues (a perturbed
+     *    equilibrium). The speed is increased by the StepSize of SpeedRange from its
+     *    StartValue until a probe sustains, then the bracket is bisected;
+     *  - nonlinear critical speed: the probes continue from the hunting state of the
+     *    closest sustaining speed. The speed is decreased from the linear critical
+     *    speed until a probe decays, then the bracket is bisected.
+     * The bisections stop when the bracket is narrower than SpeedTolerance.
+     * Every probe is written to the output with its own index.
+     */
+    class CriticalSpeed : public Input {
+    public:
+        CriticalSpeed( DYTSI_Input::InputHandler* inputHandler, XERCES_CPP_NAMESPACE::DOMElement* el, int& error);
+        virtual ~CriticalSpeed();
+
+        DYTSI_Solver::Solution* simulate();
+        double getCostEstimate();
+    private:
+        Range* tSpan;
+        Range* speedRange;
+        double radius;
+        double Phi_se;
+        double speedTolerance;
+
+        int probe(int& index, double speed, double* yStart, DYTSI_Solver::Solution& sol, bool& sustained);
+        bool isSustained(const DYTSI_Solver::RunSummary& summary);
+    };
+}
+
+#endif	/* CRITICALSPEED_H */
+
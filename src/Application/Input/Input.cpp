@@ -77,77 +77,8 @@ namespace DYTSI_Input{
         xmlInputFile.close();
 
         // Setting up the model
-        error = 0;
-        XERCES_CPP_NAMESPACE::DOMNodeList* modelsList = node->getElementsByTagName(
-                XERCES_CPP_NAMESPACE::XMLString::transcode("Model"));
-        if (modelsList->getLength() == 1){
-            XERCES_CPP_NAMESPACE::DOMElement* model =
-                    (XERCES_CPP_NAMESPACE::DOMElement*)modelsList->item(0);
-            XERCES_CPP_NAMESPACE::DOMNodeList* cooperriderList = model->getElementsByTagName(
-                XERCES_CPP_NAMESPACE::XMLString::transcode("CooperriderModel"));
-            XERCES_CPP_NAMESPACE::DOMNodeList* cooperriderOrthogonalList = model->getElementsByTagName(
-                XERCES_CPP_NAMESPACE::XMLString::transcode("CooperriderOrthogonalModel"));
-            XERCES_CPP_NAMESPACE::DOMNodeList* cooperriderOrthogonalAsymmetricList = model->getElementsByTagName(
-                XERCES_CPP_NAMESPACE::XMLString::transcode("CooperriderOrthogonalAsymmetricModel"));
-            XERCES_CPP_NAMESPACE::DOMNodeList* cooperriderOrthoAsymFixedList = model->getElementsByTagName(
-                XERCES_CPP_NAMESPACE::XMLString::transcode("CooperriderOrthoAsymFixedModel"));
-
-            if (cooperriderList->getLength() == 1){
-                out = new std::stringstream(std::stringstream::in|std::stringstream::out);
-                *out << "\t\tCooperrider Model. " << std::endl;
-                PrintingHandler::printOut(out,PrintingHandler::STDOUT);
-                delete out;
-
-                XERCES_CPP_NAMESPACE::DOMElement* cooperrider =
-                        (XERCES_CPP_NAMESPACE::DOMElement*)cooperriderList->item(0);
-                this->model = new DYTSI_Models::CooperriderModel();
-                this->model->setup(cooperrider);
-            } else if (cooperriderOrthogonalList->getLength() == 1) {
-                out = new std::stringstream(std::stringstream::in|std::stringstream::out);
-                *out << "\t\tCooperrider Orthogonal Model. " << std::endl;
-                PrintingHandler::printOut(out,PrintingHandler::STDOUT);
-                delete out;
-
-                XERCES_CPP_NAMESPACE::DOMElement* cooperrider =
-                        (XERCES_CPP_NAMESPACE::DOMElement*)cooperriderOrthogonalList->item(0);
-                this->model = new DYTSI_Models::CooperriderOrthogonalModel();
-                this->model->setup(cooperrider);
-            } else if (cooperriderOrthogonalAsymmetricList->getLength() == 1) {
-                out = new std::stringstream(std::stringstream::in|std::stringstream::out);
-                *out << "\t\tCooperrider Orthogonal Asymmetric Model. " << std::endl;
-                PrintingHandler::printOut(out,PrintingHandler::STDOUT);
-                delete out;
-
-                XERCES_CPP_NAMESPACE::DOMElement* cooperrider =
-                        (XERCES_CPP_NAMESPACE::DOMElement*)cooperriderOrthogonalAsymmetricList->item(0);
-                this->model = new DYTSI_Models::CooperriderOrthogonalAsymmetricModel();
-                this->model->setup(cooperrider);
-            } else if (cooperriderOrthoAsymFixedList->getLength() == 1) {
-                out = new std::stringstream(std::stringstream::in|std::stringstream::out);
-                *out << "\t\tCooperrider Orthogonal Asymmetric Fixed Model. " << std::endl;
-                PrintingHandler::printOut(out,PrintingHandler::STDOUT);
-                delete out;
-
-                XERCES_CPP_NAMESPACE::DOMElement* cooperrider =
-                        (XERCES_CPP_NAMESPACE::DOMElement*)cooperriderOrthoAsymFixedList->item(0);
-                this->model = new DYTSI_Models::CooperriderOrthoAsymFixedModel();
-                this->model->setup(cooperrider);
-            } else {
-                std::stringstream out;
-                out << "Error in parsing the input file: " << std::endl;
-                out << "\t " << this->testName << ": The model in this test is not defined properly." << std::endl;
-                PrintingHandler::printOut(&out, PrintingHandler::STDERR);
-                error = 1;
-                return;
-            }
-        } else {
-            std::stringstream out;
-            out << "Error in parsing the input file: " << std::endl;
-            out << "\t " << this->testName << ": The model in this test is not defined properly." << std::endl;
-            PrintingHandler::printOut(&out, PrintingHandler::STDERR);
-            error = 1;
-            return;
-        }
+        this->model = this->createModel(node, error);
+        if (error) return;
 
         // Setting up the transient curve
         this->transientCurve = new DYTSI_Input::TransientCurve();
@@ -229,6 +160,159 @@ namespace DYTSI_Input{
         }
 
         // Setting up the Solver
+        this->solver = this->createSolver(this->model, node, error);
+        if (error) return;
+
+        // Setting up the OutputHandler
+        XERCES_CPP_NAMESPACE::DOMNodeList* outputList = node->getElementsByTagName(
+                XERCES_CPP_NAMESPACE::XMLString::transcode("Output"));
+        if (outputList->getLength() == 1){
+            XERCES_CPP_NAMESPACE::DOMElement* outputEl = (XERCES_CPP_NAMESPACE::DOMElement*)outputList->item(0);
+
+            // Output Handler construction
+            out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+            *out << "\t\tOutput Handler Construction" << std::flush;
+            PrintingHandler::printOut(out,PrintingHandler::STDOUT);
+            delete out;
+
+            this->outputHandler = new DYTSI_Output::OutputHandler(this, outputEl, error);
+
+            if (error){
+                out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+                *out << "\t[FAILED]" << std::endl;
+                *out << "Error Code: " << error << std::endl;
+                PrintingHandler::printOut(out,PrintingHandler::STDOUT);
+                delete out;
+                error = 1;
+                return;
+            } else {
+                out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+                *out << "\t[DONE]" << std::endl;
+                PrintingHandler::printOut(out,PrintingHandler::STDOUT);
+                delete out;
+            }
+
+        } else {
+            out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+            *out << "\t\tThe Output property is not defined properly." << std::endl;
+            PrintingHandler::printOut(out,PrintingHandler::STDOUT);
+            delete out;
+            error = 1;
+            return;
+        }
+    }
+
+    Input::~Input() {
+    }
+
+    DYTSI_Modelling::GeneralModel* Input::getModel(){
+        return this->model;
+    }
+
+    DYTSI_Input::InputHandler* Input::getInputHandler(){
+        return this->inputHandler;
+    }
+
+    DYTSI_Solver::Solver* Input::getSolver(){
+        return this->solver;
+    }
+
+    DYTSI_Output::OutputHandler* Input::getOutputHandler(){
+        return this->outputHandler;
+    }
+
+    /**
+     * Build a new model from the Model element of the test.
+     * It is called by the constructor and by the inputs that need
+     * more than one instance of the model (e.g. parallel sweeps).
+     */
+    DYTSI_Modelling::GeneralModel* Input::createModel(XERCES_CPP_NAMESPACE::DOMElement* node, int& error){
+        std::stringstream* out;
+        DYTSI_Modelling::GeneralModel* gm = NULL;
+
+        error = 0;
+        XERCES_CPP_NAMESPACE::DOMNodeList* modelsList = node->getElementsByTagName(
+                XERCES_CPP_NAMESPACE::XMLString::transcode("Model"));
+        if (modelsList->getLength() == 1){
+            XERCES_CPP_NAMESPACE::DOMElement* model =
+                    (XERCES_CPP_NAMESPACE::DOMElement*)modelsList->item(0);
+            XERCES_CPP_NAMESPACE::DOMNodeList* cooperriderList = model->getElementsByTagName(
+                XERCES_CPP_NAMESPACE::XMLString::transcode("CooperriderModel"));
+            XERCES_CPP_NAMESPACE::DOMNodeList* cooperriderOrthogonalList = model->getElementsByTagName(
+                XERCES_CPP_NAMESPACE::XMLString::transcode("CooperriderOrthogonalModel"));
+            XERCES_CPP_NAMESPACE::DOMNodeList* cooperriderOrthogonalAsymmetricList = model->getElementsByTagName(
+                XERCES_CPP_NAMESPACE::XMLString::transcode("CooperriderOrthogonalAsymmetricModel"));
+            XERCES_CPP_NAMESPACE::DOMNodeList* cooperriderOrthoAsymFixedList = model->getElementsByTagName(
+                XERCES_CPP_NAMESPACE::XMLString::transcode("CooperriderOrthoAsymFixedModel"));
+
+            if (cooperriderList->getLength() == 1){
+                out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+                *out << "\t\tCooperrider Model. " << std::endl;
+                PrintingHandler::printOut(out,PrintingHandler::STDOUT);
+                delete out;
+
+                XERCES_CPP_NAMESPACE::DOMElement* cooperrider =
+                        (XERCES_CPP_NAMESPACE::DOMElement*)cooperriderList->item(0);
+                gm = new DYTSI_Models::CooperriderModel();
+                gm->setup(cooperrider);
+            } else if (cooperriderOrthogonalList->getLength() == 1) {
+                out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+                *out << "\t\tCooperrider Orthogonal Model. " << std::endl;
+                PrintingHandler::printOut(out,PrintingHandler::STDOUT);
+                delete out;
+
+                XERCES_CPP_NAMESPACE::DOMElement* cooperrider =
+                        (XERCES_CPP_NAMESPACE::DOMElement*)cooperriderOrthogonalList->item(0);
+                gm = new DYTSI_Models::CooperriderOrthogonalModel();
+                gm->setup(cooperrider);
+            } else if (cooperriderOrthogonalAsymmetricList->getLength() == 1) {
+                out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+                *out << "\t\tCooperrider Orthogonal Asymmetric Model. " << std::endl;
+                PrintingHandler::printOut(out,PrintingHandler::STDOUT);
+                delete out;
+
+                XERCES_CPP_NAMESPACE::DOMElement* cooperrider =
+                        (XERCES_CPP_NAMESPACE::DOMElement*)cooperriderOrthogonalAsymmetricList->item(0);
+                gm = new DYTSI_Models::CooperriderOrthogonalAsymmetricModel();
+                gm->setup(cooperrider);
+            } else if (cooperriderOrthoAsymFixedList->getLength() == 1) {
+                out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+                *out << "\t\tCooperrider Orthogonal Asymmetric Fixed Model. " << std::endl;
+                PrintingHandler::printOut(out,PrintingHandler::STDOUT);
+                delete out;
+
+                XERCES_CPP_NAMESPACE::DOMElement* cooperrider =
+                        (XERCES_CPP_NAMESPACE::DOMElement*)cooperriderOrthoAsymFixedList->item(0);
+                gm = new DYTSI_Models::CooperriderOrthoAsymFixedModel();
+                gm->setup(cooperrider);
+            } else {
+                std::stringstream out;
+                out << "Error in parsing the input file: " << std::endl;
+                out << "\t " << this->testName << ": The model in this test is not defined properly." << std::endl;
+                PrintingHandler::printOut(&out, PrintingHandler::STDERR);
+                error = 1;
+                return NULL;
+            }
+        } else {
+            std::stringstream out;
+            out << "Error in parsing the input file: " << std::endl;
+            out << "\t " << this->testName << ": The model in this test is not defined properly." << std::endl;
+            PrintingHandler::printOut(&out, PrintingHandler::STDERR);
+            error = 1;
+            return NULL;
+        }
+
+        return gm;
+    }
+
+    /**
+     * Build and setup a new solver, working on the model gm, from the Solver
+     * element of the test.
+     */
+    DYTSI_Solver::Solver* Input::createSolver(DYTSI_Modelling::GeneralModel* gm, XERCES_CPP_NAMESPACE::DOMElement* node, int& error){
+        std::stringstream* out;
+        DYTSI_Solver::Solver* solver = NULL;
+
         XERCES_CPP_NAMESPACE::DOMNodeList* solverList = node->getElementsByTagName(
                 XERCES_CPP_NAMESPACE::XMLString::transcode("Solver"));
         if (solverList->getLength() == 1){
@@ -245,7 +329,7 @@ namespace DYTSI_Input{
                 *out << "\t\tSolver Construction: \"Implicit Bulirsch-Stoer\"" << std::flush;
                 PrintingHandler::printOut(out,PrintingHandler::STDOUT);
                 delete out;
-                this->solver = new DYTSI_Solver::BulirschStoerSolver(this->model, solverEl, error);
+                solver = new DYTSI_Solver::BulirschStoerSolver(gm, solverEl, error);
                 if (error){
                     out = new std::stringstream(std::stringstream::in|std::stringstream::out);
                     *out << "\t[FAILED]" << std::endl;
@@ -253,7 +337,7 @@ namespace DYTSI_Input{
                     PrintingHandler::printOut(out,PrintingHandler::STDOUT);
                     delete out;
                     error = 1;
-                    return;
+                    return NULL;
                 } else {
                     out = new std::stringstream(std::stringstream::in|std::stringstream::out);
                     *out << "\t[DONE]" << std::endl;
@@ -266,7 +350,7 @@ namespace DYTSI_Input{
                 *out << "\t\tSolver Setup: \"Implicit Bulirsch-Stoer\"" << std::flush;
                 PrintingHandler::printOut(out,PrintingHandler::STDOUT);
                 delete out;
-                error += this->solver->setup();
+                error += solver->setup();
                 if (error){
                     out = new std::stringstream(std::stringstream::in|std::stringstream::out);
                     *out << "\t[FAILED]" << std::endl;
@@ -274,7 +358,7 @@ namespace DYTSI_Input{
                     PrintingHandler::printOut(out,PrintingHandler::STDOUT);
                     delete out;
                     error = 1;
-                    return;
+                    return NULL;
                 } else {
                     out = new std::stringstream(std::stringstream::in|std::stringstream::out);
                     *out << "\t[DONE]" << std::endl;
@@ -287,7 +371,7 @@ namespace DYTSI_Input{
                 *out << "\t\tSolver Construction: \"BDF Method\"" << std::flush;
                 PrintingHandler::printOut(out,PrintingHandler::STDOUT);
                 delete out;
-                this->solver = new DYTSI_Solver::BDFSolver(this->model, solverEl, error);
+                solver = new DYTSI_Solver::BDFSolver(gm, solverEl, error);
                 if (error){
                     out = new std::stringstream(std::stringstream::in|std::stringstream::out);
                     *out << "\t[FAILED]" << std::endl;
@@ -295,7 +379,7 @@ namespace DYTSI_Input{
                     PrintingHandler::printOut(out,PrintingHandler::STDOUT);
                     delete out;
                     error = 1;
-                    return;
+                    return NULL;
                 } else {
                     out = new std::stringstream(std::stringstream::in|std::stringstream::out);
                     *out << "\t[DONE]" << std::endl;
@@ -308,7 +392,7 @@ namespace DYTSI_Input{
                 *out << "\t\tSolver Setup: \"BDF method\"" << std::flush;
                 PrintingHandler::printOut(out,PrintingHandler::STDOUT);
                 delete out;
-                error += this->solver->setup();
+                error += solver->setup();
                 if (error){
                     out = new std::stringstream(std::stringstream::in|std::stringstream::out);
                     *out << "\t[FAILED]" << std::endl;
@@ -316,7 +400,7 @@ namespace DYTSI_Input{
                     PrintingHandler::printOut(out,PrintingHandler::STDOUT);
                     delete out;
                     error = 1;
-                    return;
+                    return NULL;
                 } else {
                     out = new std::stringstream(std::stringstream::in|std::stringstream::out);
                     *out << "\t[DONE]" << std::endl;
@@ -329,7 +413,7 @@ namespace DYTSI_Input{
                 *out << "\t\tSolver Construction: \"Implicit Runge-Kutta 4th\"" << std::flush;
                 PrintingHandler::printOut(out,PrintingHandler::STDOUT);
                 delete out;
-                this->solver = new DYTSI_Solver::RK4ImplicitAtGaussianPoints(this->model, solverEl, error);
+                solver = new DYTSI_Solver::RK4ImplicitAtGaussianPoints(gm, solverEl, error);
                 if (error){
                     out = new std::stringstream(std::stringstream::in|std::stringstream::out);
                     *out << "\t[FAILED]" << std::endl;
@@ -337,7 +421,7 @@ namespace DYTSI_Input{
                     PrintingHandler::printOut(out,PrintingHandler::STDOUT);
                     delete out;
                     error = 1;
-                    return;
+                    return NULL;
                 } else {
                     out = new std::stringstream(std::stringstream::in|std::stringstream::out);
                     *out << "\t[DONE]" << std::endl;
@@ -350,7 +434,7 @@ namespace DYTSI_Input{
                 *out << "\t\tSolver Setup: \"Implicit Runge-Kutta 4th\"" << std::flush;
                 PrintingHandler::printOut(out,PrintingHandler::STDOUT);
                 delete out;
-                error += this->solver->setup();
+                error += solver->setup();
                 if (error){
                     out = new std::stringstream(std::stringstream::in|std::stringstream::out);
                     *out << "\t[FAILED]" << std::endl;
@@ -358,7 +442,7 @@ namespace DYTSI_Input{
                     PrintingHandler::printOut(out,PrintingHandler::STDOUT);
                     delete out;
                     error = 1;
-                    return;
+                    return NULL;
                 } else {
                     out = new std::stringstream(std::stringstream::in|std::stringstream::out);
                     *out << "\t[DONE]" << std::endl;
@@ -371,7 +455,7 @@ namespace DYTSI_Input{
                 *out << "\t\tSolver Construction: \"RKF34\"" << std::flush;
                 PrintingHandler::printOut(out,PrintingHandler::STDOUT);
                 delete out;
-                this->solver = new DYTSI_Solver::SDIRKSolver(this->model, solverEl, error, RKF34);
+                solver = new DYTSI_Solver::SDIRKSolver(gm, solverEl, error, RKF34);
                 if (error){
                     out = new std::stringstream(std::stringstream::in|std::stringstream::out);
                     *out << "\t[FAILED]" << std::endl;
@@ -379,7 +463,7 @@ namespace DYTSI_Input{
                     PrintingHandler::printOut(out,PrintingHandler::STDOUT);
                     delete out;
                     error = 1;
-                    return;
+                    return NULL;
                 } else {
                     out = new std::stringstream(std::stringstream::in|std::stringstream::out);
                     *out << "\t[DONE]" << std::endl;
@@ -392,7 +476,7 @@ namespace DYTSI_Input{
                 *out << "\t\tSolver Setup: \"RKF34\"" << std::flush;
                 PrintingHandler::printOut(out,PrintingHandler::STDOUT);
                 delete out;
-                error += this->solver->setup();
+                error += solver->setup();
                 if (error){
                     out = new std::stringstream(std::stringstream::in|std::stringstream::out);
                     *out << "\t[FAILED]" << std::endl;
@@ -400,7 +484,7 @@ namespace DYTSI_Input{
                     PrintingHandler::printOut(out,PrintingHandler::STDOUT);
                     delete out;
                     error = 1;
-                    return;
+                    return NULL;
                 } else {
                     out = new std::stringstream(std::stringstream::in|std::stringstream::out);
                     *out << "\t[DONE]" << std::endl;
@@ -413,7 +497,7 @@ namespace DYTSI_Input{
                 *out << "\t\tSolver Construction: \"SDIRK\"" << std::flush;
                 PrintingHandler::printOut(out,PrintingHandler::STDOUT);
                 delete out;
-                this->solver = new DYTSI_Solver::SDIRKSolver(this->model, solverEl, error, NT1);
+                solver = new DYTSI_Solver::SDIRKSolver(gm, solverEl, error, NT1);
                 if (error){
                     out = new std::stringstream(std::stringstream::in|std::stringstream::out);
                     *out << "\t[FAILED]" << std::endl;
@@ -421,7 +505,7 @@ namespace DYTSI_Input{
                     PrintingHandler::printOut(out,PrintingHandler::STDOUT);
                     delete out;
                     error = 1;
-                    return;
+                    return NULL;
                 } else {
                     out = new std::stringstream(std::stringstream::in|std::stringstream::out);
                     *out << "\t[DONE]" << std::endl;
@@ -434,7 +518,7 @@ namespace DYTSI_Input{
                 *out << "\t\tSolver Setup: \"SDIRK\"" << std::flush;
                 PrintingHandler::printOut(out,PrintingHandler::STDOUT);
                 delete out;
-                error += this->solver->setup();
+                error += solver->setup();
                 if (error){
                     out = new std::stringstream(std::stringstream::in|std::stringstream::out);
                     *out << "\t[FAILED]" << std::endl;
@@ -442,7 +526,7 @@ namespace DYTSI_Input{
                     PrintingHandler::printOut(out,PrintingHandler::STDOUT);
                     delete out;
                     error = 1;
-                    return;
+                    return NULL;
                 } else {
                     out = new std::stringstream(std::stringstream::in|std::stringstream::out);
                     *out << "\t[DONE]" << std::endl;
@@ -455,7 +539,7 @@ namespace DYTSI_Input{
                 *out << "\t\tSolver Construction: \"SDIRK\"" << std::flush;
                 PrintingHandler::printOut(out,PrintingHandler::STDOUT);
                 delete out;
-                this->solver = new DYTSI_Solver::SDIRKSolver(this->model, solverEl, error, JKT);
+                solver = new DYTSI_Solver::SDIRKSolver(gm, solverEl, error, JKT);
                 if (error){
                     out = new std::stringstream(std::stringstream::in|std::stringstream::out);
                     *out << "\t[FAILED]" << std::endl;
@@ -463,7 +547,7 @@ namespace DYTSI_Input{
                     PrintingHandler::printOut(out,PrintingHandler::STDOUT);
                     delete out;
                     error = 1;
-                    return;
+                    return NULL;
                 } else {
                     out = new std::stringstream(std::stringstream::in|std::stringstream::out);
                     *out << "\t[DONE]" << std::endl;
@@ -476,7 +560,7 @@ namespace DYTSI_Input{
                 *out << "\t\tSolver Setup: \"SDIRK\"" << std::flush;
                 PrintingHandler::printOut(out,PrintingHandler::STDOUT);
                 delete out;
-                error += this->solver->setup();
+                error += solver->setup();
                 if (error){
                     out = new std::stringstream(std::stringstream::in|std::stringstream::out);
                     *out << "\t[FAILED]" << std::endl;
@@ -484,7 +568,7 @@ namespace DYTSI_Input{
                     PrintingHandler::printOut(out,PrintingHandler::STDOUT);
                     delete out;
                     error = 1;
-                    return;
+                    return NULL;
                 } else {
                     out = new std::stringstream(std::stringstream::in|std::stringstream::out);
                     *out << "\t[DONE]" << std::endl;
@@ -497,7 +581,7 @@ namespace DYTSI_Input{
                 PrintingHandler::printOut(out,PrintingHandler::STDOUT);
                 delete out;
                 error = 1;
-                return;
+                return NULL;
             }
         } else {
             out = new std::stringstream(std::stringstream::in|std::stringstream::out);
@@ -505,65 +589,10 @@ namespace DYTSI_Input{
             PrintingHandler::printOut(out,PrintingHandler::STDOUT);
             delete out;
             error = 1;
-            return;
+            return NULL;
         }
 
-        // Setting up the OutputHandler
-        XERCES_CPP_NAMESPACE::DOMNodeList* outputList = node->getElementsByTagName(
-                XERCES_CPP_NAMESPACE::XMLString::transcode("Output"));
-        if (outputList->getLength() == 1){
-            XERCES_CPP_NAMESPACE::DOMElement* outputEl = (XERCES_CPP_NAMESPACE::DOMElement*)outputList->item(0);
-
-            // Output Handler construction
-            out = new std::stringstream(std::stringstream::in|std::stringstream::out);
-            *out << "\t\tOutput Handler Construction" << std::flush;
-            PrintingHandler::printOut(out,PrintingHandler::STDOUT);
-            delete out;
-
-            this->outputHandler = new DYTSI_Output::OutputHandler(this, outputEl, error);
-
-            if (error){
-                out = new std::stringstream(std::stringstream::in|std::stringstream::out);
-                *out << "\t[FAILED]" << std::endl;
-                *out << "Error Code: " << error << std::endl;
-                PrintingHandler::printOut(out,PrintingHandler::STDOUT);
-                delete out;
-                error = 1;
-                return;
-            } else {
-                out = new std::stringstream(std::stringstream::in|std::stringstream::out);
-                *out << "\t[DONE]" << std::endl;
-                PrintingHandler::printOut(out,PrintingHandler::STDOUT);
-                delete out;
-            }
-
-        } else {
-            out = new std::stringstream(std::stringstream::in|std::stringstream::out);
-            *out << "\t\tThe Output property is not defined properly." << std::endl;
-            PrintingHandler::printOut(out,PrintingHandler::STDOUT);
-            delete out;
-            error = 1;
-            return;
-        }
-    }
-
-    Input::~Input() {
-    }
-
-    DYTSI_Modelling::GeneralModel* Input::getModel(){
-        return this->model;
-    }
-
-    DYTSI_Input::InputHandler* Input::getInputHandler(){
-        return this->inputHandler;
-    }
-
-    DYTSI_Solver::Solver* Input::getSolver(){
-        return this->solver;
-    }
-
-    DYTSI_Output::OutputHandler* Input::getOutputHandler(){
-        return this->outputHandler;
+        return solver;
     }
 
     int Input::coverTransientCurve(int index, DYTSI_Solver::Solution &sol,
@@ -61,11 +61,16 @@ namespace DYTSI_Input{
         DYTSI_Output::OutputHandler* getOutputHandler();
 
         virtual DYTSI_Solver::Solution* simulate() = 0;
+        // Estimated cost of the test (integrated time), used to schedule the longest tests first
+        virtual double getCostEstimate() = 0;
 
         int coverTransientCurve( int index, DYTSI_Solver::Solution &sol,
             double speedSim, double radiusSim, double Phi_seSim);
         
     protected:
+        DYTSI_Modelling::GeneralModel* createModel(XERCES_CPP_NAMESPACE::DOMElement* node, int& error);
+        DYTSI_Solver::Solver* createSolver(DYTSI_Modelling::GeneralModel* gm, XERCES_CPP_NAMESPACE::DOMElement* node, int& error);
+
         char* testName;
         DYTSI_Modelling::GeneralModel* model;
         DYTSI_Input::TransientCurve* transientCurve;
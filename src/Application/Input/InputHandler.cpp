@@ -37,6 +37,7 @@
 #include "Transient.h"
 #include "Bifurcation.h"
 #include "Ramping.h"
+#include "CriticalSpeed.h"
 
 #include "../PrintingHandler.h"
 #include "XMLaux.h"
@@ -99,6 +100,7 @@ namespace DYTSI_Input{
         XERCES_CPP_NAMESPACE::DOMNodeList* transientTests = root->getElementsByTagName(XERCES_CPP_NAMESPACE::XMLString::transcode("Transient"));
         XERCES_CPP_NAMESPACE::DOMNodeList* bifurcationTests = root->getElementsByTagName(XERCES_CPP_NAMESPACE::XMLString::transcode("Bifurcation"));
         XERCES_CPP_NAMESPACE::DOMNodeList* rampingTests = root->getElementsByTagName(XERCES_CPP_NAMESPACE::XMLString::transcode("Ramping"));
+        XERCES_CPP_NAMESPACE::DOMNodeList* criticalSpeedTests = root->getElementsByTagName(XERCES_CPP_NAMESPACE::XMLString::transcode("CriticalSpeed"));
 
         for ( unsigned int i = 0; i < transientTests->getLength(); i++ ){
             int error = 0;
@@ -130,6 +132,16 @@ namespace DYTSI_Input{
 				return true;
 		}
 
+        for ( unsigned int i = 0; i < criticalSpeedTests->getLength(); i++ ){
+            int error = 0;
+            XERCES_CPP_NAMESPACE::DOMElement* el = (XERCES_CPP_NAMESPACE::DOMElement*)criticalSpeedTests->item(i);
+            Input* criticalSpeed = new CriticalSpeed(this, el, error);
+            if (error == 0)
+                this->inputList.push_back(criticalSpeed);
+            else
+                return true;
+        }
+
         return false;
     }
 
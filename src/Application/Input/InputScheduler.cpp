@@ -0,0 +1,93 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+
+#include "InputScheduler.h"
+
+#include "../PrintingHandler.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace DYTSI_Input {
+
+    static bool compareCostEstimate(Input* a, Input* b){
+        return a->getCostEstimate() > b->getCostEstimate();
+    }
+
+    InputScheduler::InputScheduler(int nConcurrentTests) {
+        this->nConcurrentTests = nConcurrentTests;
+    }
+
+    InputScheduler::~InputScheduler() {
+    }
+
+    /**
+     * Simulate all the inputs. With one concurrent test (or one input) they are
+     * simulated in order by the calling thread, as in the sequential mode.
+     * @param inputList
+     */
+    void InputScheduler::run(std::vector<Input*> inputList){
+        if ((this->nConcurrentTests <= 1) || (inputList.size() <= 1)){
+            for (unsigned int i = 0; i < inputList.size(); i++)
+                inputList[i]->simulate();
+            return;
+        }
+
+        // Longest tests first, such that the total time is close to the one of the longest test
+        std::stable_sort(inputList.begin(), inputList.end(), compareCostEstimate);
+
+        int nThreads = this->nConcurrentTests;
+        if (nThreads > (int) inputList.size()) nThreads = inputList.size();
+
+        std::stringstream* out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+        *out << "Running " << inputList.size() << " tests on " << nThreads << " threads" << std::endl;
+        PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+        delete out;
+
+        // The calling thread takes part to the execution while joining
+        DYTSI_Modelling::WorkerPool pool(nThreads - 1);
+        DYTSI_Modelling::WorkerPool::TaskGroup group;
+        std::vector<InputTask> tasks(inputList.size());
+        for (unsigned int i = 0; i < inputList.size(); i++){
+            tasks[i].input = inputList[i];
+            pool.fork(group, &tasks[i], NULL);
+        }
+        pool.join(group);
+    }
+
+    void InputScheduler::InputTask::Execute(void*){
+        PrintingHandler::startBuffering();
+        this->input->simulate();
+        std::string log = PrintingHandler::stopBuffering();
+
+        std::stringstream* out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+        *out << "================ Test: " << this->input->getTestName() << " ================" << std::endl;
+        *out << log;
+        *out << "================ End of Test: " << this->input->getTestName() << " ================" << std::endl;
+        PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+        delete out;
+    }
+}
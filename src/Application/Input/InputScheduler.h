@@ -0,0 +1,62 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+
+#ifndef INPUTSCHEDULER_H
+#define	INPUTSCHEDULER_H
+
+#include "Input.h"
+
+#include "../../GeneralModel/WorkerPool.h"
+
+#include <string>
+#include <vector>
+
+namespace DYTSI_Input {
+
+    /**
+     * Runs the tests of the input files on a bounded pool of threads, longest
+     * estimated test first. The console output of each test is buffered and
+     * printed as a single block once the test is finished.
+     */
+    class InputScheduler {
+    public:
+        InputScheduler(int nConcurrentTests);
+        virtual ~InputScheduler();
+
+        void run(std::vector<Input*> inputList);
+
+    private:
+        class InputTask : public DYTSI_Modelling::Task {
+        public:
+            Input* input;
+            void Execute(void*);
+        };
+
+        int nConcurrentTests;
+    };
+}
+
+#endif	/* INPUTSCHEDULER_H */
@@ -0,0 +1,225 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+#include "RSGEOTableCache.h"
+
+#include "../PrintingHandler.h"
+
+#include <sstream>
+#include <string.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+namespace DYTSI_Input{
+
+    static const char CACHE_MAGIC[8] = {'D','Y','T','S','I','R','S','G'};
+    static const uint64_t CACHE_ALIGN = 64;
+
+    // The mapped caches stay mapped for the life of the process (the tables built on them are
+    // shared by the models), and are unmapped at exit
+    class CacheMappings {
+    public:
+        ~CacheMappings(){
+            for (unsigned int i = 0; i < this->addrs.size(); i++)
+                munmap(this->addrs[i], this->sizes[i]);
+        }
+        void add(void* addr, size_t size){
+            this->addrs.push_back(addr);
+            this->sizes.push_back(size);
+        }
+    private:
+        std::vector<void*> addrs;
+        std::vector<size_t> sizes;
+    };
+    static CacheMappings cacheMappings;
+
+    static uint64_t alignOffset(uint64_t offset){
+        return (offset + CACHE_ALIGN - 1) / CACHE_ALIGN * CACHE_ALIGN;
+    }
+
+    // True if count items of the given size starting at offset lie in the mapping
+    // (written such that it cannot overflow)
+    static bool fitsMapping(uint64_t offset, uint64_t count, uint64_t size, uint64_t mapSize){
+        return offset <= mapSize && count <= (mapSize - offset) / size;
+    }
+
+    std::string RSGEOTableCache::getCachePath(std::string path){
+        return path + ".cache";
+    }
+
+    bool RSGEOTableCache::sourceInfo(std::string path, uint64_t& size, int64_t& mtime, int64_t& mtimeNsec){
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0)
+            return false;
+        size = (uint64_t) st.st_size;
+#if defined(__APPLE__)
+        mtime = (int64_t) st.st_mtimespec.tv_sec;
+        mtimeNsec = (int64_t) st.st_mtimespec.tv_nsec;
+#elif defined(st_mtime)
+        // st_mtime is a macro on st_mtim where the nanoseconds are available (glibc, BSD)
+        mtime = (int64_t) st.st_mtim.tv_sec;
+        mtimeNsec = (int64_t) st.st_mtim.tv_nsec;
+#else
+        mtime = (int64_t) st.st_mtime;
+        mtimeNsec = 0;
+#endif
+        return true;
+    }
+
+    bool RSGEOTableCache::load(std::string path, DYTSI_Modelling::InterpolationTypes interpType,
+            std::vector<DYTSI_Modelling::RSGEOTable*>& rsgList){
+        uint64_t srcSize;
+        int64_t srcMTime, srcMTimeNsec;
+        if (!sourceInfo(path, srcSize, srcMTime, srcMTimeNsec))
+            return false;
+
+        std::string cachePath = getCachePath(path);
+        int fd = open(cachePath.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(FileHeader)){
+            close(fd);
+            return false;
+        }
+        size_t mapSize = (size_t) st.st_size;
+        void* addr = mmap(NULL, mapSize, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (addr == MAP_FAILED)
+            return false;
+        const char* base = (const char*) addr;
+
+        // Validate the header against the source
+        const FileHeader* header = (const FileHeader*) base;
+        bool valid = (memcmp(header->magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0) &&
+                header->version == VERSION &&
+                header->interpType == (int32_t) interpType &&
+                header->sourceSize == srcSize &&
+                header->sourceMTime == srcMTime &&
+                header->sourceMTimeNsec == srcMTimeNsec &&
+                fitsMapping(sizeof(FileHeader), header->nTables, sizeof(TableHeader), mapSize);
+        const TableHeader* tables = (const TableHeader*) (base + sizeof(FileHeader));
+        for (uint32_t t = 0; valid && t < header->nTables; t++){
+            int32_t nRows = tables[t].nRows;
+            int32_t nCols = tables[t].nCols;
+            // The columns up to RSG_qN are read by the wheel sets (RSG_Kry is computed)
+            valid = nRows > 1 && nCols >= DYTSI_Modelling::RSGEOTable::RSG_Kry &&
+                    fitsMapping(tables[t].tableOffset, (uint64_t) nCols * nRows, sizeof(double), mapSize) &&
+                    fitsMapping(tables[t].coeffsOffset, (uint64_t) (nRows - 1) * nCols, 4 * sizeof(double), mapSize);
+        }
+        if (!valid){
+            munmap(addr, mapSize);
+            return false;
+        }
+
+        // Build the tables on the mapped memory
+        for (uint32_t t = 0; t < header->nTables; t++){
+            int nRows = tables[t].nRows;
+            int nCols = tables[t].nCols;
+            double* columns = (double*) (base + tables[t].tableOffset);
+            double** table = new double*[nCols];
+            for (int j = 0; j < nCols; j++)
+                table[j] = &(columns[(size_t) j * nRows]);
+            const double* coeffs = (const double*) (base + tables[t].coeffsOffset);
+            rsgList.push_back(new DYTSI_Modelling::RSGEOTable(table, coeffs, nRows, nCols,
+                    tables[t].maxDispl, interpType));
+            delete [] table;
+        }
+        cacheMappings.add(addr, mapSize);
+
+        std::stringstream* out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+        *out << "\t\t\tRSGEO tables mapped from " << cachePath << " (" << header->nTables << " tables)" << std::endl;
+        PrintingHandler::printOut(out,PrintingHandler::STDOUT);
+        delete out;
+
+        return true;
+    }
+
+    bool RSGEOTableCache::write(std::string path, DYTSI_Modelling::InterpolationTypes interpType,
+            std::vector<DYTSI_Modelling::RSGEOTable*>& tables){
+        FileHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        header.version = VERSION;
+        header.nTables = tables.size();
+        header.interpType = (int32_t) interpType;
+        if (!sourceInfo(path, header.sourceSize, header.sourceMTime, header.sourceMTimeNsec))
+            return false;
+
+        // Layout: headers, then columns and coefficients of each table (aligned)
+        std::vector<TableHeader> tableHeaders(tables.size());
+        uint64_t offset = sizeof(FileHeader) + tables.size() * sizeof(TableHeader);
+        for (unsigned int t = 0; t < tables.size(); t++){
+            uint64_t nRows = tables[t]->get_N_ROWS_RSGEO();
+            uint64_t nCols = tables[t]->get_N_COLS_RSGEO();
+            memset(&tableHeaders[t], 0, sizeof(TableHeader));
+            tableHeaders[t].nRows = nRows;
+            tableHeaders[t].nCols = nCols;
+            tableHeaders[t].maxDispl = tables[t]->get_MAX_DISPL();
+            tableHeaders[t].tableOffset = alignOffset(offset);
+            tableHeaders[t].coeffsOffset = alignOffset(tableHeaders[t].tableOffset + nCols * nRows * sizeof(double));
+            offset = tableHeaders[t].coeffsOffset + (nRows - 1) * nCols * 4 * sizeof(double);
+        }
+
+        // Write to a temporary file and rename it, so that concurrent runs never map a partial cache
+        std::stringstream tmpPath;
+        tmpPath << getCachePath(path) << ".tmp" << getpid();
+        FILE* f = fopen(tmpPath.str().c_str(), "wb");
+        if (f == NULL)
+            return false;
+
+        bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+        if (!tableHeaders.empty())
+            ok = ok && fwrite(&tableHeaders[0], sizeof(TableHeader), tableHeaders.size(), f) == tableHeaders.size();
+        uint64_t written = sizeof(FileHeader) + tables.size() * sizeof(TableHeader);
+        const char zeros[CACHE_ALIGN] = {0};
+        for (unsigned int t = 0; ok && t < tables.size(); t++){
+            int nRows = tableHeaders[t].nRows;
+            int nCols = tableHeaders[t].nCols;
+
+            ok = ok && fwrite(zeros, 1, tableHeaders[t].tableOffset - written, f) == tableHeaders[t].tableOffset - written;
+            const double* const* table = tables[t]->getTable();
+            for (int j = 0; ok && j < nCols; j++)
+                ok = fwrite(table[j], sizeof(double), nRows, f) == (size_t) nRows;
+            written = tableHeaders[t].tableOffset + (uint64_t) nCols * nRows * sizeof(double);
+
+            ok = ok && fwrite(zeros, 1, tableHeaders[t].coeffsOffset - written, f) == tableHeaders[t].coeffsOffset - written;
+            size_t nCoeffs = (size_t) (nRows - 1) * nCols * 4;
+            ok = ok && fwrite(tables[t]->getCoefficients(), sizeof(double), nCoeffs, f) == nCoeffs;
+            written = tableHeaders[t].coeffsOffset + nCoeffs * sizeof(double);
+        }
+        ok = (fclose(f) == 0) && ok;
+
+        if (!ok || rename(tmpPath.str().c_str(), getCachePath(path).c_str()) != 0){
+            unlink(tmpPath.str().c_str());
+            return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,86 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+#ifndef RSGEOTABLECACHE_H
+#define	RSGEOTABLECACHE_H
+
+#include "../../GeneralModel/RSGEOTable.h"
+#include "../../GeneralModel/enumDeclarations.h"
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace DYTSI_Input{
+
+    /**
+     * Binary cache of the RSGEO files, written next to the source (path + ".cache").
+     * It contains, for each table of the file, the columns and the interleaved
+     * polynomial coefficients of the interpolants (see RSGEOTable), so that it
+     * can be mapped read-only and used without parsing or interpolating. The cache is valid
+     * for the same version, interpolation type, size and modification time of the source.
+     */
+    class RSGEOTableCache {
+    public:
+        static const uint32_t VERSION = 2;
+
+        static std::string getCachePath(std::string path);
+
+        // Map the cache of the RSGEO file path and build the tables on it.
+        // Returns false if the cache is missing or stale.
+        static bool load(std::string path, DYTSI_Modelling::InterpolationTypes interpType,
+                std::vector<DYTSI_Modelling::RSGEOTable*>& rsgList);
+
+        // Write the cache of the tables read from path. Returns false if it cannot be written
+        // (e.g. read-only directory): the tables are then just not cached.
+        static bool write(std::string path, DYTSI_Modelling::InterpolationTypes interpType,
+                std::vector<DYTSI_Modelling::RSGEOTable*>& tables);
+
+    private:
+        struct FileHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t nTables;
+            int32_t interpType;
+            uint32_t reserved;
+            uint64_t sourceSize;
+            int64_t sourceMTime;
+            int64_t sourceMTimeNsec;
+        };
+
+        struct TableHeader {
+            int32_t nRows;
+            int32_t nCols;
+            double maxDispl;
+            uint64_t tableOffset;
+            uint64_t coeffsOffset;
+        };
+
+        // Size, modification time of the source
+        static bool sourceInfo(std::string path, uint64_t& size, int64_t& mtime, int64_t& mtimeNsec);
+    };
+}
+
+#endif	/* RSGEOTABLECACHE_H */
@@ -35,6 +35,7 @@
 
 #include "../PrintingHandler.h"
 #include "../miscellaneous.h"
+#include "RSGEOTableCache.h"
 
 #include "../../GeneralModel/enumDeclarations.h"
 
@@ -53,6 +54,11 @@ namespace DYTSI_Input{
     }
 
     void RSGEOTableReader::read(std::vector<DYTSI_Modelling::RSGEOTable*>& rsgList, std::string pathS, char tabDelimiter){
+        read(rsgList, pathS, tabDelimiter, DYTSI_Modelling::INTP_LINEAR);
+    }
+
+    void RSGEOTableReader::read(std::vector<DYTSI_Modelling::RSGEOTable*>& rsgList, std::string pathS, char tabDelimiter,
+            DYTSI_Modelling::InterpolationTypes interpType){
         struct stat stFileInfo;
         int N_COLS_RSGEO;
         int N_ROWS_RSGEO;
@@ -63,17 +69,22 @@ namespace DYTSI_Input{
         PrintingHandler::printOut(out,PrintingHandler::STDOUT);
         delete out;
 
+        // Tables already parsed and interpolated by a previous run
+        if (RSGEOTableCache::load(pathS, interpType, rsgList))
+            return;
+
         if (stat(pathS.c_str(),&stFileInfo)==0){
             int counter = 0;
             int counterRSGEO = 0;
             int startingPosition;
+            std::vector<DYTSI_Modelling::RSGEOTable*> fileTables;
 
             // Open the file
             std::ifstream rsgeofile(pathS.c_str());
             std::string line;
             while (std::getline(rsgeofile,line)) {
                 counterRSGEO++;
-                
+
                 // Find the first delimiter
                 char delim = (line.c_str())[0];
                 while ( delim != tabDelimiter && std::getline(rsgeofile,line) ){
@@ -84,10 +95,10 @@ namespace DYTSI_Input{
 
                 // Count the colums
                 std::getline(rsgeofile,line);
-                std::stringstream *lineStream = new std::stringstream(line,std::stringstream::in);
+                std::stringstream lineStream(line,std::stringstream::in);
                 std::string entry;
                 counter = 0;
-                while( *lineStream >> entry ) counter++;
+                while( lineStream >> entry ) counter++;
                 N_COLS_RSGEO = counter;
                 startingPosition = rsgeofile.tellg();
 
@@ -109,30 +120,53 @@ namespace DYTSI_Input{
                 double val;
                 for( int i = 0; i < N_ROWS_RSGEO; i++){
                   std::getline(rsgeofile,line);
-                  lineStream = new std::stringstream(line,std::stringstream::in);
+                  std::stringstream rowStream(line,std::stringstream::in);
                   for ( int j = 0; j < N_COLS_RSGEO; j++){
-                    *lineStream >> val;
+                    rowStream >> val;
                     rsgeo_table[j][i] = val;
                     if ((i==0) && (j==0)) MAX_DISPL = fabs(val);
                   }
                 }
-                DYTSI_Modelling::RSGEOTable* rsgeo = new DYTSI_Modelling::RSGEOTable(rsgeo_table,N_ROWS_RSGEO,N_COLS_RSGEO,MAX_DISPL);
+                DYTSI_Modelling::RSGEOTable* rsgeo = new DYTSI_Modelling::RSGEOTable(
+                        rsgeo_table,N_ROWS_RSGEO,N_COLS_RSGEO,MAX_DISPL, interpType);
                 rsgList.push_back(rsgeo);
+                fileTables.push_back(rsgeo);
+            }
+
+            // Cache the tables for the next runs
+            if (!fileTables.empty() && !RSGEOTableCache::write(pathS, interpType, fileTables)){
+                out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+                *out << "\t\t\tWarning: the RSGEO cache " << RSGEOTableCache::getCachePath(pathS)
+                        << " cannot be written" << std::endl;
+                PrintingHandler::printOut(out,PrintingHandler::STDOUT);
+                delete out;
             }
         }
     }
 
     void RSGEOTableReader::read(std::vector<DYTSI_Modelling::RSGEOTable*>& rsgList, XERCES_CPP_NAMESPACE::DOMNode* node, char tabDelimiter){
-        std::stringstream* out = new std::stringstream(std::stringstream::in|std::stringstream::out);
-        
+        std::string filePath;
+        DYTSI_Modelling::InterpolationTypes interpType;
+        if (!readPathNode(node, filePath, interpType))
+            return;
+
+        // Read and interpolate the RSGEO tables
+        read(rsgList, filePath, tabDelimiter, interpType);
+    }
+
+    bool RSGEOTableReader::readPathNode(XERCES_CPP_NAMESPACE::DOMNode* node, std::string& filePath,
+            DYTSI_Modelling::InterpolationTypes& interpType){
+        std::stringstream* out;
+
         // Read the path and the interpolation type
-        std::string filePath = XMLaux::setValueToString(node);
+        filePath = XMLaux::setValueToString(node);
         XERCES_CPP_NAMESPACE::DOMNamedNodeMap *pAttributes = node->getAttributes();
+        XMLCh* interpName = XERCES_CPP_NAMESPACE::XMLString::transcode("Interp");
         XERCES_CPP_NAMESPACE::DOMAttr* interpAttribute =
-                (XERCES_CPP_NAMESPACE::DOMAttr*)pAttributes->getNamedItem(
-                XERCES_CPP_NAMESPACE::XMLString::transcode("Interp"));
+                (XERCES_CPP_NAMESPACE::DOMAttr*)pAttributes->getNamedItem(interpName);
+        XERCES_CPP_NAMESPACE::XMLString::release(&interpName);
         char* interpTypeStr = XERCES_CPP_NAMESPACE::XMLString::transcode(interpAttribute->getValue());
-        DYTSI_Modelling::InterpolationTypes interpType;
+        bool found = true;
         if (strcmp(interpTypeStr,"linear") == 0){
             interpType = DYTSI_Modelling::INTP_LINEAR;
         } else if (strcmp(interpTypeStr,"cspline") == 0) {
@@ -144,78 +178,10 @@ namespace DYTSI_Input{
             *out << "\t\tThe interpolation type " << interpTypeStr << " doesn't exists." << std::endl;
             PrintingHandler::printOut(out,PrintingHandler::STDOUT);
             delete out;
-            return;
-        }
-
-        // Read and interplate RSGEO tables
-        struct stat stFileInfo;
-        int N_COLS_RSGEO;
-        int N_ROWS_RSGEO;
-        double MAX_DISPL;
-
-        *out << "\t\t\tReading RSGEO file " << filePath << "\n" << std::flush;
-        PrintingHandler::printOut(out,PrintingHandler::STDOUT);
-        delete out;
-
-        if (stat(filePath.c_str(),&stFileInfo)==0){
-            int counter = 0;
-            int counterRSGEO = 0;
-            int startingPosition;
-
-            // Open the file
-            std::ifstream rsgeofile(filePath.c_str());
-            std::string line;
-            while (std::getline(rsgeofile,line)) {
-                counterRSGEO++;
-
-                // Find the first delimiter
-                char delim = (line.c_str())[0];
-                while ( delim != tabDelimiter && std::getline(rsgeofile,line) ){
-                    delim = (line.c_str())[0];
-                }
-                if (delim != tabDelimiter)
-                    break;
-
-                // Count the colums
-                std::getline(rsgeofile,line);
-                std::stringstream *lineStream = new std::stringstream(line,std::stringstream::in);
-                std::string entry;
-                counter = 0;
-                while( *lineStream >> entry ) counter++;
-                N_COLS_RSGEO = counter;
-                startingPosition = rsgeofile.tellg();
-
-                // Count the rows
-                delim = ' ';
-                counter = 0;
-                while( (delim != tabDelimiter) && std::getline(rsgeofile,line) ){
-                    delim = (line.c_str())[0];
-                    counter++;
-                }
-                N_ROWS_RSGEO = counter-1;
-
-                // Allocate the RSGEO TABLE
-                double** rsgeo_table;
-                doubleMatrixAlloc(rsgeo_table,N_COLS_RSGEO,N_ROWS_RSGEO);
-                // Start reading
-                rsgeofile.clear();
-                rsgeofile.seekg(startingPosition);
-                double val;
-                for( int i = 0; i < N_ROWS_RSGEO; i++){
-                  std::getline(rsgeofile,line);
-                  lineStream = new std::stringstream(line,std::stringstream::in);
-                  for ( int j = 0; j < N_COLS_RSGEO; j++){
-                    *lineStream >> val;
-                    rsgeo_table[j][i] = val;
-                    if ((i==0) && (j==0)) MAX_DISPL = fabs(val);
-                  }
-                }
-                DYTSI_Modelling::RSGEOTable* rsgeo = new DYTSI_Modelling::RSGEOTable(
-                        rsgeo_table,N_ROWS_RSGEO,N_COLS_RSGEO,MAX_DISPL, interpType);
-                rsgList.push_back(rsgeo);
-            }
+            found = false;
         }
-
+        XERCES_CPP_NAMESPACE::XMLString::release(&interpTypeStr);
+        return found;
     }
 
 }
@@ -50,6 +50,12 @@ namespace DYTSI_Input{
 
         static void read(std::vector<DYTSI_Modelling::RSGEOTable*>& rsgList, std::string path, char tabDelimiter);
         static void read(std::vector<DYTSI_Modelling::RSGEOTable*>& rsgList, XERCES_CPP_NAMESPACE::DOMNode* node, char tabDelimiter);
+        // Read the tables of the file (from its binary cache if valid, see RSGEOTableCache)
+        static void read(std::vector<DYTSI_Modelling::RSGEOTable*>& rsgList, std::string path, char tabDelimiter,
+                DYTSI_Modelling::InterpolationTypes interpType);
+        // Path and interpolation type (attribute Interp) of an RSGEO_Path node, false if not valid
+        static bool readPathNode(XERCES_CPP_NAMESPACE::DOMNode* node, std::string& filePath,
+                DYTSI_Modelling::InterpolationTypes& interpType);
     private:
 
     };
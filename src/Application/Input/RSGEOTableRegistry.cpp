@@ -0,0 +1,75 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+#include "RSGEOTableRegistry.h"
+#include "RSGEOTableReader.h"
+
+#include <limits.h>
+#include <stdlib.h>
+
+namespace DYTSI_Input{
+
+    RSGEOTableRegistry::RegistryMap RSGEOTableRegistry::tables;
+    pthread_mutex_t RSGEOTableRegistry::mutex = PTHREAD_MUTEX_INITIALIZER;
+
+    RSGEOTableRegistry::RSGEOTableRegistry() {
+    }
+
+    RSGEOTableRegistry::~RSGEOTableRegistry() {
+    }
+
+    void RSGEOTableRegistry::get(std::vector<const DYTSI_Modelling::RSGEOTable*>& rsgList, std::string path,
+            char tabDelimiter, DYTSI_Modelling::InterpolationTypes interpType){
+        // The same file can be referred with different paths
+        char resolved[PATH_MAX];
+        std::string key = (realpath(path.c_str(), resolved) != NULL) ? std::string(resolved) : path;
+
+        // The lock is held during the reading, so that concurrent requests of the same
+        // tables wait for the first one instead of reading the file again
+        pthread_mutex_lock(&mutex);
+        RegistryMap::iterator it = tables.find(RegistryKey(key, (int) interpType));
+        if (it == tables.end()){
+            std::vector<DYTSI_Modelling::RSGEOTable*> readList;
+            RSGEOTableReader::read(readList, path, tabDelimiter, interpType);
+            std::vector<const DYTSI_Modelling::RSGEOTable*> sharedList(readList.begin(), readList.end());
+            // Failed readings (empty list) are not stored, so that they are reported again
+            if (sharedList.size() > 0)
+                tables[RegistryKey(key, (int) interpType)] = sharedList;
+            rsgList.insert(rsgList.end(), sharedList.begin(), sharedList.end());
+        } else {
+            rsgList.insert(rsgList.end(), it->second.begin(), it->second.end());
+        }
+        pthread_mutex_unlock(&mutex);
+    }
+
+    void RSGEOTableRegistry::get(std::vector<const DYTSI_Modelling::RSGEOTable*>& rsgList, XERCES_CPP_NAMESPACE::DOMNode* node,
+            char tabDelimiter){
+        std::string filePath;
+        DYTSI_Modelling::InterpolationTypes interpType;
+        if (RSGEOTableReader::readPathNode(node, filePath, interpType))
+            get(rsgList, filePath, tabDelimiter, interpType);
+    }
+
+}
@@ -0,0 +1,68 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+#ifndef RSGEOTABLEREGISTRY_H
+#define	RSGEOTABLEREGISTRY_H
+
+#include "../../GeneralModel/RSGEOTable.h"
+#include "../../GeneralModel/enumDeclarations.h"
+
+#include "XMLaux.h"
+
+#include <pthread.h>
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace DYTSI_Input{
+    /*
+     * Process-wide registry of the RSGEO tables. The tables of a file are read once
+     * for each (path, interpolation type) and handed out as read-only shared handles
+     * to all the models (and to all the tests of an input file), also from concurrent
+     * threads. The tables live until the end of the process.
+     */
+    class RSGEOTableRegistry {
+    public:
+        static void get(std::vector<const DYTSI_Modelling::RSGEOTable*>& rsgList, std::string path,
+                char tabDelimiter, DYTSI_Modelling::InterpolationTypes interpType = DYTSI_Modelling::INTP_LINEAR);
+        // Path and interpolation type from the RSGEO_Path node of the model
+        static void get(std::vector<const DYTSI_Modelling::RSGEOTable*>& rsgList, XERCES_CPP_NAMESPACE::DOMNode* node,
+                char tabDelimiter);
+
+    private:
+        RSGEOTableRegistry();
+        virtual ~RSGEOTableRegistry();
+
+        typedef std::pair<std::string, int> RegistryKey;
+        typedef std::map<RegistryKey, std::vector<const DYTSI_Modelling::RSGEOTable*> > RegistryMap;
+
+        static RegistryMap tables;
+        static pthread_mutex_t mutex;
+    };
+}
+
+#endif	/* RSGEOTABLEREGISTRY_H */
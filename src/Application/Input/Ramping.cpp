@@ -39,6 +39,7 @@
 #include "../../GeneralModel/ExternalComponents.h"
 
 #include <cstdlib>
+#include <math.h>
 #include <sstream>
 #include <vector>
 
@@ -130,6 +131,15 @@ namespace DYTSI_Input {
     Ramping::~Ramping() {
     }
 
+    double Ramping::getCostEstimate(){
+        // One ramp (from the starting to the ending speed) for each radius and Phi_se
+        double nRamps = this->radiusRange->getNumberOfSteps() * this->Phi_seRange->getNumberOfSteps();
+        double rampTime = fabs(this->speedRange->getEndValue() - this->speedRange->getStartValue());
+        if (this->speedRange->getCoeff() != 0.0)
+            rampTime /= fabs(this->speedRange->getCoeff());
+        return nRamps * rampTime;
+    }
+
     DYTSI_Solver::Solution* Ramping::simulate(){
         int indexSimulation = 0;
         int errCode = GSL_SUCCESS;
@@ -191,9 +201,9 @@ namespace DYTSI_Input {
             this->getModel()->getExternalComponents()->set_Phi_se( phi_se );
 
             double* yInit;
-            if ( sol->getSolutionList().size() > 0 ){
+            if ( sol->getNumberOfEntries() > 0 ){
 				// Get the last status
-				yInit = (sol->getStatusList())[ sol->getStatusList().size() -1 ];
+				yInit = sol->getLastStatus();
 				sol->addEntry(indexSimulation, 0.0, yInit, 0.0);
 			} else {
 				// Load the starting values
@@ -217,7 +227,7 @@ namespace DYTSI_Input {
 					this->getModel()->getExternalComponents()->set_R( radius );
 					this->getModel()->getExternalComponents()->set_Phi_se( phi_se );
 
-					yInit = (sol->getStatusList())[ sol->getStatusList().size() -1 ];
+					yInit = sol->getLastStatus();
 
 					errCode = this->getSolver()->solveRamping(indexSimulation, yInit, this->speedRange, *sol);
 					indexSimulation++;
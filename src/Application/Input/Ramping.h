@@ -51,6 +51,7 @@ namespace DYTSI_Input {
         virtual ~Ramping();
 
         DYTSI_Solver::Solution* simulate();
+        double getCostEstimate();
     private:
         Range* speedRange;
         Range* radiusRange;
@@ -33,6 +33,8 @@
 
 #include "Range.h"
 
+#include <math.h>
+
 namespace DYTSI_Input {
     Range::Range() {
         this->startValue = 0.0;
@@ -60,6 +62,16 @@ namespace DYTSI_Input {
 		return this->params;
 	}
 
+    /**
+     * Number of values covered going from the start value to the end value
+     * with the step size (1 if the range is a single value).
+     */
+    int Range::getNumberOfSteps() const{
+        if ((this->stepSize == 0.0) || (this->startValue == this->endValue))
+            return 1;
+        return (int) floor( fabs(this->endValue - this->startValue) / fabs(this->stepSize) + 1e-9 ) + 1;
+    }
+
     void Range::setStartValue( double val ){
         this->startValue = val;
     }
@@ -45,6 +45,7 @@ namespace DYTSI_Input{
         double getStepSize() const;
         double getCoeff() const;
         void * getParams() const;
+        int getNumberOfSteps() const;
         void setStartValue( double val );
         void setEndValue( double val );
         void setStepSize( double val );
@@ -39,6 +39,7 @@
 #include "../../GeneralModel/ExternalComponents.h"
 
 #include <cstdlib>
+#include <math.h>
 #include <sstream>
 #include <vector>
 #include <iosfwd>
@@ -123,6 +124,10 @@ namespace DYTSI_Input{
         }
     }
 
+    double Transient::getCostEstimate(){
+        return fabs(this->tSpan->getEndValue() - this->tSpan->getStartValue());
+    }
+
     DYTSI_Solver::Solution* Transient::simulate(){
         int indexSimulation = 0;
         int errCode = GSL_SUCCESS;
@@ -153,9 +158,9 @@ namespace DYTSI_Input{
             this->getModel()->getExternalComponents()->set_Phi_se(this->Phi_se);
 
             double* yInit;
-            if ( sol->getSolutionList().size() > 0 ){
+            if ( sol->getNumberOfEntries() > 0 ){
                 // Get the last status
-                yInit = (sol->getStatusList())[ sol->getStatusList().size() -1 ];
+                yInit = sol->getLastStatus();
             } else {
                 // Init with the starting conditions
                 yInit = new double[this->getModel()->get_N_DOF()];
@@ -50,6 +50,7 @@ namespace DYTSI_Input {
         virtual ~Transient();
 
         DYTSI_Solver::Solution* simulate();
+        double getCostEstimate();
     private:
         Range* tSpan;
         double speed;
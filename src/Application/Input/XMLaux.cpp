@@ -65,14 +65,29 @@ void XMLaux::getElementsNodeByName(
     }
 }
 
+/**
+ * Descendant elements of el with the given tag name (the transcoded name is released).
+ */
+XERCES_CPP_NAMESPACE::DOMNodeList* XMLaux::getElementsByTagName(
+            XERCES_CPP_NAMESPACE::DOMElement* el, const char* name){
+    XMLCh* tagName = XERCES_CPP_NAMESPACE::XMLString::transcode(name);
+    XERCES_CPP_NAMESPACE::DOMNodeList* list = el->getElementsByTagName(tagName);
+    XERCES_CPP_NAMESPACE::XMLString::release(&tagName);
+    return list;
+}
+
 double XMLaux::setValueToDouble(xercesc_3_1::DOMNode* node){
     char* value = XERCES_CPP_NAMESPACE::XMLString::transcode(node->getFirstChild()->getNodeValue());
-    return atof(value);
+    double val = atof(value);
+    XERCES_CPP_NAMESPACE::XMLString::release(&value);
+    return val;
 }
 
 std::string XMLaux::setValueToString(xercesc_3_1::DOMNode* node){
     char* value = XERCES_CPP_NAMESPACE::XMLString::transcode(node->getFirstChild()->getNodeValue());
-    return std::string(value);
+    std::string val(value);
+    XERCES_CPP_NAMESPACE::XMLString::release(&value);
+    return val;
 }
 
 bool XMLaux::loadStringProperty(
@@ -68,6 +68,8 @@ public:
     static bool loadStringAttribute(XERCES_CPP_NAMESPACE::DOMElement* el,
                 const char* attributeName, std::string &attr);
 
+    static XERCES_CPP_NAMESPACE::DOMNodeList* getElementsByTagName(
+                XERCES_CPP_NAMESPACE::DOMElement* el, const char* name);
     static void getElementsNodeByName(
                 std::vector<XERCES_CPP_NAMESPACE::DOMNode*>& elementsVector,
                 XERCES_CPP_NAMESPACE::DOMNode* node, const char* name);
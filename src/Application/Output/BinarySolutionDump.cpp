@@ -0,0 +1,86 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+
+/*
+ * DYTSIbin2tab: converts a binary solution file (Format BIN) to the TAB format.
+ *
+ * Usage: DYTSIbin2tab <input.bin> [<output>]
+ *
+ * The output is written to the standard output if no output file is given.
+ */
+#include "BinarySolutionReader.h"
+
+#include <stdio.h>
+#include <vector>
+
+using namespace DYTSI_Output;
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2 || argc > 3){
+        fprintf(stderr, "Usage: %s <input.bin> [<output>]\n", argv[0]);
+        return 1;
+    }
+
+    BinarySolutionReader reader;
+    if (!reader.open(argv[1])){
+        fprintf(stderr, "Error: %s is not a valid binary solution file\n", argv[1]);
+        return 1;
+    }
+
+    FILE* out = stdout;
+    if (argc == 3){
+        out = fopen(argv[2], "w");
+        if (out == NULL){
+            fprintf(stderr, "Error: the output file %s cannot be opened\n", argv[2]);
+            return 1;
+        }
+    }
+
+    // Header
+    int nColumns = reader.getNumberOfColumns();
+    const std::vector<std::string>& names = reader.getColumnNames();
+    for (int c = 0; c < nColumns; c++)
+        fprintf(out, "\"%s\"\t", names[c].c_str());
+    fprintf(out, "\n");
+
+    // Entries, chunk by chunk
+    std::vector<BinarySolutionReader::ColumnView> columns(nColumns);
+    for (int chunk = 0; chunk < reader.getNumberOfChunks(); chunk++){
+        for (int c = 0; c < nColumns; c++)
+            columns[c] = reader.getColumn(chunk, c);
+        for (int i = 0; i < reader.getChunkRows(chunk); i++){
+            for (int c = 0; c < nColumns; c++)
+                fprintf(out, "%.10e\t", columns[c].data[i]);
+            fprintf(out, "\n");
+        }
+    }
+
+    int err = ferror(out);
+    if (out != stdout)
+        err |= fclose(out);
+    return (err != 0) ? 1 : 0;
+}
@@ -0,0 +1,94 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+#ifndef BINARYSOLUTIONFORMAT_H
+#define	BINARYSOLUTIONFORMAT_H
+
+#include <stdint.h>
+
+namespace DYTSI_Output {
+
+    /**
+     * Layout of the binary solution files (Format BIN, see BinarySolutionWriter and
+     * BinarySolutionReader). All the fields are little-endian and 8 bytes aligned:
+     *
+     *   FileHeader
+     *   column names (null terminated, padded to 8 bytes, FileHeader::namesSize bytes)
+     *   chunks: ChunkHeader followed by nColumns blocks of nRows doubles (one per column)
+     *   index: one ChunkIndexEntry per chunk
+     *   FileFooter
+     *
+     * A chunk holds consecutive entries of the same run index (Index column). The index
+     * and the footer are rewritten after each chunk, so a file that was not closed is
+     * complete up to its last flush. If the footer is not valid (e.g. the process was
+     * killed while writing) the chunks are scanned from the first one (see ChunkHeader::magic).
+     */
+    namespace BinarySolutionFormat {
+        static const char FILE_MAGIC[8] = {'D','Y','T','S','I','S','O','L'};
+        static const char FOOTER_MAGIC[8] = {'D','Y','T','S','I','E','N','D'};
+        static const uint32_t CHUNK_MAGIC = 0x4B4E4843; // "CHNK"
+        static const uint32_t VERSION = 1;
+
+        struct FileHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t nColumns;
+            uint32_t indexColumn;   // Column of the run index
+            uint32_t namesSize;
+            uint64_t firstChunkOffset;
+        };
+
+        struct ChunkHeader {
+            uint32_t magic;
+            int32_t runIndex;
+            uint32_t nRows;
+            uint32_t reserved;
+        };
+
+        struct ChunkIndexEntry {
+            uint64_t offset;        // Offset of the ChunkHeader
+            int32_t runIndex;
+            uint32_t nRows;
+        };
+
+        struct FileFooter {
+            uint64_t indexOffset;
+            uint64_t nChunks;
+            uint64_t nRows;
+            char magic[8];
+        };
+
+        inline bool hostIsLittleEndian(){
+            const uint32_t one = 1;
+            return *((const unsigned char*) &one) == 1;
+        }
+
+        inline uint64_t alignOffset(uint64_t offset){
+            return (offset + 7) / 8 * 8;
+        }
+    }
+}
+
+#endif	/* BINARYSOLUTIONFORMAT_H */
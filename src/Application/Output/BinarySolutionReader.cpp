@@ -0,0 +1,186 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+#include "BinarySolutionReader.h"
+
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+namespace DYTSI_Output {
+
+    using namespace BinarySolutionFormat;
+
+    BinarySolutionReader::BinarySolutionReader() {
+        this->base = NULL;
+        this->mapSize = 0;
+        this->nRows = 0;
+    }
+
+    BinarySolutionReader::~BinarySolutionReader() {
+        this->close();
+    }
+
+    bool BinarySolutionReader::open(const std::string& path){
+        this->close();
+        if (!hostIsLittleEndian())
+            return false;
+
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(FileHeader)){
+            ::close(fd);
+            return false;
+        }
+        size_t size = (size_t) st.st_size;
+        void* addr = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED)
+            return false;
+        this->base = (const char*) addr;
+        this->mapSize = size;
+
+        const FileHeader* header = (const FileHeader*) this->base;
+        bool valid = (memcmp(header->magic, FILE_MAGIC, sizeof(FILE_MAGIC)) == 0) &&
+                header->version == VERSION &&
+                header->indexColumn < header->nColumns &&
+                header->firstChunkOffset == sizeof(FileHeader) + header->namesSize &&
+                header->firstChunkOffset <= size;
+        if (!valid){
+            this->close();
+            return false;
+        }
+
+        // Column names
+        const char* name = this->base + sizeof(FileHeader);
+        const char* namesEnd = name + header->namesSize;
+        for (uint32_t c = 0; c < header->nColumns; c++){
+            const char* end = (const char*) memchr(name, '\0', namesEnd - name);
+            if (end == NULL){
+                this->close();
+                return false;
+            }
+            this->columnNames.push_back(std::string(name, end));
+            name = end + 1;
+        }
+
+        // Chunks from the index, or from the chunks themselves if the footer is not valid
+        if (!this->readIndex(header->firstChunkOffset) && !this->scanChunks(header->firstChunkOffset)){
+            this->close();
+            return false;
+        }
+        return true;
+    }
+
+    void BinarySolutionReader::close(){
+        if (this->base != NULL)
+            munmap((void*) this->base, this->mapSize);
+        this->base = NULL;
+        this->mapSize = 0;
+        this->columnNames.clear();
+        this->chunks.clear();
+        this->nRows = 0;
+    }
+
+    bool BinarySolutionReader::validChunk(uint64_t offset, uint32_t& nChunkRows){
+        if (offset + sizeof(ChunkHeader) > this->mapSize)
+            return false;
+        const ChunkHeader* chunk = (const ChunkHeader*) (this->base + offset);
+        nChunkRows = chunk->nRows;
+        return chunk->magic == CHUNK_MAGIC &&
+                offset + sizeof(ChunkHeader) + (uint64_t) this->columnNames.size() * nChunkRows * sizeof(double) <= this->mapSize;
+    }
+
+    bool BinarySolutionReader::readIndex(uint64_t firstChunkOffset){
+        if (this->mapSize < firstChunkOffset + sizeof(FileFooter))
+            return false;
+        const FileFooter* footer = (const FileFooter*) (this->base + this->mapSize - sizeof(FileFooter));
+        if (memcmp(footer->magic, FOOTER_MAGIC, sizeof(FOOTER_MAGIC)) != 0 ||
+                footer->indexOffset < firstChunkOffset ||
+                footer->indexOffset + footer->nChunks * sizeof(ChunkIndexEntry) + sizeof(FileFooter) != this->mapSize)
+            return false;
+
+        const ChunkIndexEntry* index = (const ChunkIndexEntry*) (this->base + footer->indexOffset);
+        long rows = 0;
+        for (uint64_t i = 0; i < footer->nChunks; i++){
+            uint32_t nChunkRows;
+            if (!this->validChunk(index[i].offset, nChunkRows) || nChunkRows != index[i].nRows){
+                this->chunks.clear();
+                return false;
+            }
+            this->chunks.push_back(index[i]);
+            rows += nChunkRows;
+        }
+        this->nRows = rows;
+        return true;
+    }
+
+    bool BinarySolutionReader::scanChunks(uint64_t firstChunkOffset){
+        uint64_t offset = firstChunkOffset;
+        uint32_t nChunkRows;
+        this->chunks.clear();
+        this->nRows = 0;
+        while (this->validChunk(offset, nChunkRows)){
+            ChunkIndexEntry entry;
+            entry.offset = offset;
+            entry.runIndex = ((const ChunkHeader*) (this->base + offset))->runIndex;
+            entry.nRows = nChunkRows;
+            this->chunks.push_back(entry);
+            this->nRows += nChunkRows;
+            offset += sizeof(ChunkHeader) + (uint64_t) this->columnNames.size() * nChunkRows * sizeof(double);
+        }
+        return true;
+    }
+
+    int BinarySolutionReader::getColumnIndex(const std::string& name){
+        for (unsigned int c = 0; c < this->columnNames.size(); c++)
+            if (this->columnNames[c] == name)
+                return c;
+        return -1;
+    }
+
+    BinarySolutionReader::ColumnView BinarySolutionReader::getColumn(int chunk, int column){
+        const ChunkIndexEntry& entry = this->chunks[chunk];
+        const double* values = (const double*) (this->base + entry.offset + sizeof(ChunkHeader));
+        ColumnView view;
+        view.data = &values[(size_t) column * entry.nRows];
+        view.size = entry.nRows;
+        view.runIndex = entry.runIndex;
+        return view;
+    }
+
+    std::vector<BinarySolutionReader::ColumnView> BinarySolutionReader::getColumnViews(int column, int runIndex){
+        std::vector<ColumnView> views;
+        for (unsigned int i = 0; i < this->chunks.size(); i++)
+            if (runIndex < 0 || this->chunks[i].runIndex == runIndex)
+                views.push_back(this->getColumn(i, column));
+        return views;
+    }
+}
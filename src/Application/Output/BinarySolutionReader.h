@@ -0,0 +1,88 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+#ifndef BINARYSOLUTIONREADER_H
+#define	BINARYSOLUTIONREADER_H
+
+#include "BinarySolutionFormat.h"
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+namespace DYTSI_Output {
+
+    /**
+     * Reader of the binary solution files for the post-processing (see BinarySolutionFormat).
+     * The file is mapped read-only and the columns are handed out as views on the
+     * mapping, without copies: the views are valid until close(). It depends only on
+     * the C++ and POSIX libraries and it is not linked in DYTSI: it is built in the
+     * DYTSIbin2tab tool (see BinarySolutionDump.cpp).
+     */
+    class BinarySolutionReader {
+    public:
+        // Values of one column in one chunk
+        struct ColumnView {
+            const double* data;
+            int size;
+            int runIndex;
+        };
+
+        BinarySolutionReader();
+        virtual ~BinarySolutionReader();
+
+        // Map the file. Returns false if it is not a valid binary solution file.
+        bool open(const std::string& path);
+        void close();
+
+        int getNumberOfColumns(){ return columnNames.size(); }
+        const std::vector<std::string>& getColumnNames(){ return columnNames; }
+        // Column with the given name, -1 if not found
+        int getColumnIndex(const std::string& name);
+
+        int getNumberOfChunks(){ return chunks.size(); }
+        long getNumberOfRows(){ return nRows; }
+        int getChunkRunIndex(int chunk){ return chunks[chunk].runIndex; }
+        int getChunkRows(int chunk){ return chunks[chunk].nRows; }
+
+        // Column of one chunk
+        ColumnView getColumn(int chunk, int column);
+        // Column over all the chunks (runIndex < 0), or over the chunks of one run
+        std::vector<ColumnView> getColumnViews(int column, int runIndex = -1);
+
+    private:
+        const char* base;
+        size_t mapSize;
+        std::vector<std::string> columnNames;
+        std::vector<BinarySolutionFormat::ChunkIndexEntry> chunks;
+        long nRows;
+
+        bool readIndex(uint64_t firstChunkOffset);
+        bool scanChunks(uint64_t firstChunkOffset);
+        bool validChunk(uint64_t offset, uint32_t& nChunkRows);
+    };
+}
+
+#endif	/* BINARYSOLUTIONREADER_H */
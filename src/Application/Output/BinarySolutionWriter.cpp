@@ -0,0 +1,188 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+#include "BinarySolutionWriter.h"
+
+#include "../PrintingHandler.h"
+
+#include <sstream>
+#include <string.h>
+
+namespace DYTSI_Output {
+
+    using namespace BinarySolutionFormat;
+
+    BinarySolutionWriter::BinarySolutionWriter() {
+        this->file = NULL;
+        this->nColumns = 0;
+        this->indexColumn = 0;
+        this->chunkRows = 0;
+        this->chunkRunIndex = 0;
+        this->dataEnd = 0;
+        this->nRows = 0;
+    }
+
+    BinarySolutionWriter::~BinarySolutionWriter() {
+        this->close();
+    }
+
+    bool BinarySolutionWriter::open(const std::string& path, const std::vector<std::string>& columnNames,
+            const std::string& indexName){
+        this->close();
+
+        std::stringstream* out;
+        if (!hostIsLittleEndian()){
+            out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+            *out << "Error: the binary output format is supported on little-endian hosts only" << std::endl;
+            PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+            delete out;
+            return false;
+        }
+
+        int indexColumn = -1;
+        for (unsigned int c = 0; c < columnNames.size(); c++)
+            if (columnNames[c] == indexName)
+                indexColumn = c;
+        if (indexColumn < 0){
+            out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+            *out << "Error: the index column " << indexName << " is not in the solution" << std::endl;
+            PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+            delete out;
+            return false;
+        }
+
+        this->file = fopen(path.c_str(), "w+b");
+        if (this->file == NULL){
+            out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+            *out << "Error: the output file " << path << " cannot be opened" << std::endl;
+            PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+            delete out;
+            return false;
+        }
+
+        this->nColumns = columnNames.size();
+        this->indexColumn = indexColumn;
+
+        // Names, null terminated and padded to 8 bytes
+        std::string names;
+        for (int c = 0; c < this->nColumns; c++){
+            names += columnNames[c];
+            names += '\0';
+        }
+        names.resize(alignOffset(names.size()), '\0');
+
+        FileHeader header;
+        memset(&header, 0, sizeof(FileHeader));
+        memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+        header.version = VERSION;
+        header.nColumns = this->nColumns;
+        header.indexColumn = this->indexColumn;
+        header.namesSize = names.size();
+        header.firstChunkOffset = sizeof(FileHeader) + names.size();
+        fwrite(&header, sizeof(FileHeader), 1, this->file);
+        fwrite(names.data(), 1, names.size(), this->file);
+
+        this->chunk.assign((size_t) this->nColumns * CHUNK_ROWS, 0.0);
+        this->chunkRows = 0;
+        this->chunkIndex.clear();
+        this->dataEnd = header.firstChunkOffset;
+        this->nRows = 0;
+        this->writeIndex();
+        return true;
+    }
+
+    void BinarySolutionWriter::addEntry(const double* entry){
+        if (this->file == NULL)
+            return;
+
+        int runIndex = (int) entry[this->indexColumn];
+        if (this->chunkRows == CHUNK_ROWS || (this->chunkRows > 0 && runIndex != this->chunkRunIndex))
+            this->writeChunk();
+        if (this->chunkRows == 0)
+            this->chunkRunIndex = runIndex;
+
+        double* dst = &this->chunk[this->chunkRows];
+        for (int c = 0; c < this->nColumns; c++)
+            dst[(size_t) c * CHUNK_ROWS] = entry[c];
+        this->chunkRows++;
+    }
+
+    void BinarySolutionWriter::writeChunk(){
+        if (this->chunkRows == 0)
+            return;
+
+        // The chunk takes the place of the previous index
+        fseeko(this->file, (off_t) this->dataEnd, SEEK_SET);
+        ChunkHeader header;
+        header.magic = CHUNK_MAGIC;
+        header.runIndex = this->chunkRunIndex;
+        header.nRows = this->chunkRows;
+        header.reserved = 0;
+        fwrite(&header, sizeof(ChunkHeader), 1, this->file);
+        for (int c = 0; c < this->nColumns; c++)
+            fwrite(&this->chunk[(size_t) c * CHUNK_ROWS], sizeof(double), this->chunkRows, this->file);
+
+        ChunkIndexEntry entry;
+        entry.offset = this->dataEnd;
+        entry.runIndex = this->chunkRunIndex;
+        entry.nRows = this->chunkRows;
+        this->chunkIndex.push_back(entry);
+
+        this->dataEnd += sizeof(ChunkHeader) + (uint64_t) this->nColumns * this->chunkRows * sizeof(double);
+        this->nRows += this->chunkRows;
+        this->chunkRows = 0;
+
+        // The file stays readable through the footer
+        this->writeIndex();
+    }
+
+    void BinarySolutionWriter::writeIndex(){
+        fseeko(this->file, (off_t) this->dataEnd, SEEK_SET);
+        if (this->chunkIndex.size() > 0)
+            fwrite(&this->chunkIndex[0], sizeof(ChunkIndexEntry), this->chunkIndex.size(), this->file);
+
+        FileFooter footer;
+        footer.indexOffset = this->dataEnd;
+        footer.nChunks = this->chunkIndex.size();
+        footer.nRows = this->nRows;
+        memcpy(footer.magic, FOOTER_MAGIC, sizeof(FOOTER_MAGIC));
+        fwrite(&footer, sizeof(FileFooter), 1, this->file);
+    }
+
+    void BinarySolutionWriter::flush(){
+        if (this->file == NULL)
+            return;
+        this->writeChunk();
+        fflush(this->file);
+    }
+
+    void BinarySolutionWriter::close(){
+        if (this->file == NULL)
+            return;
+        this->flush();
+        fclose(this->file);
+        this->file = NULL;
+    }
+}
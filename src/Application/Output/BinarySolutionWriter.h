@@ -0,0 +1,76 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+#ifndef BINARYSOLUTIONWRITER_H
+#define	BINARYSOLUTIONWRITER_H
+
+#include "BinarySolutionFormat.h"
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+namespace DYTSI_Output {
+
+    /**
+     * Writer of the binary solution files (see BinarySolutionFormat). The entries are
+     * collected by columns in memory and written as one chunk when CHUNK_ROWS entries
+     * are collected, when the run index changes or at flush().
+     */
+    class BinarySolutionWriter {
+    public:
+        BinarySolutionWriter();
+        virtual ~BinarySolutionWriter();
+
+        static const int CHUNK_ROWS = 4096;
+
+        // Create the file with the names of the columns. The run index is the column
+        // named indexName. Returns false on failure or if there is no such column.
+        bool open(const std::string& path, const std::vector<std::string>& columnNames,
+                const std::string& indexName);
+        bool isOpen(){ return file != NULL; }
+        void addEntry(const double* entry);
+        // Write the collected entries, the index and the footer
+        void flush();
+        void close();
+
+    private:
+        FILE* file;
+        int nColumns;
+        int indexColumn;
+        // Collected entries, column c at chunk[c * CHUNK_ROWS]
+        std::vector<double> chunk;
+        int chunkRows;
+        int chunkRunIndex;
+        std::vector<BinarySolutionFormat::ChunkIndexEntry> chunkIndex;
+        uint64_t dataEnd;
+        uint64_t nRows;
+
+        void writeChunk();
+        void writeIndex();
+    };
+}
+
+#endif	/* BINARYSOLUTIONWRITER_H */
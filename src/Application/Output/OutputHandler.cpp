@@ -37,6 +37,10 @@
 #include "../Input/XMLaux.h"
 #include "../Input/InputHandler.h"
 #include "../PrintingHandler.h"
+#include "ScientificFormat.h"
+
+#include <math.h>
+#include <string.h>
 
 #include <string>
 #include <iosfwd>
@@ -50,11 +54,14 @@ namespace DYTSI_Output {
     char TAB_NEWENTRY[] = "\n";
     const char OUTPUT_FILE_NAME[] = "output";
     const char OUTPUT_FILE_EXT[] = ".dat";
+    const char OUTPUT_BINARY_FILE_EXT[] = ".bin";
+    const char INDEX_COLUMN_NAME[] = "Index";
     const char JACOBIAN_DIR_NAME[] = "Jacobians";
     const char JACOBIAN_FILE_NAME[] = "jac";
     const char JACOBIAN_FILE_EXT[] = ".dat";
+    const char RUNS_FILE_NAME[] = "runs.dat";
 
-    const std::string* OutputHandler::FormatTypeNames[N_FORMAT_TYPE] = { new std::string("TAB") };
+    const std::string* OutputHandler::FormatTypeNames[N_FORMAT_TYPE] = { new std::string("TAB"), new std::string("BIN") };
 
     const std::string* OutputHandler::PlottingTypeNames[N_PLOTTING_TYPE] = { new std::string("NONE"), new std::string("GNUPlot") };
 
@@ -93,9 +100,59 @@ namespace DYTSI_Output {
             error = 2;
             return;
         }
+
+        // Optional: number of runs whose last state is kept in memory. The entries are
+        // only written to the output, unless 0 is given (the whole history is kept)
+        this->storedRuns = 1;
+        XERCES_CPP_NAMESPACE::DOMNodeList* storedRunsList = XMLaux::getElementsByTagName(node, "StoredRuns");
+        if (storedRunsList->getLength() == 1){
+            double storedRuns = XMLaux::setValueToDouble(storedRunsList->item(0));
+            if (storedRuns < 0.0 || storedRuns != floor(storedRuns)){
+                error = 3;
+                return;
+            }
+            this->storedRuns = (int) storedRuns;
+        }
+
+        this->solFile = NULL;
+        this->solBuffer = NULL;
+        this->lastFlush = 0;
+        this->runsFileStarted = false;
     }
 
     OutputHandler::~OutputHandler() {
+        this->closeSolutionFile();
+    }
+
+    void OutputHandler::closeSolutionFile(){
+        this->binaryWriter.close();
+        if (this->solFile != NULL){
+            fclose(this->solFile);
+            this->solFile = NULL;
+        }
+        if (this->solBuffer != NULL){
+            delete [] this->solBuffer;
+            this->solBuffer = NULL;
+        }
+    }
+
+    void OutputHandler::flush(){
+        if (this->solFile != NULL)
+            fflush(this->solFile);
+        this->binaryWriter.flush();
+        this->lastFlush = time(NULL);
+    }
+
+    void OutputHandler::writeLine(const char* begin, size_t size){
+        if (this->solFile == NULL)
+            return;
+        fwrite(begin, 1, size, this->solFile);
+        // Partial results are visible also during long runs
+        time_t now = time(NULL);
+        if (now - this->lastFlush >= FLUSH_INTERVAL){
+            fflush(this->solFile);
+            this->lastFlush = now;
+        }
     }
 
     void OutputHandler::reset(){
@@ -105,11 +162,28 @@ namespace DYTSI_Output {
 
         // Reset the solution file
         std::stringstream* filePath = new std::stringstream(std::stringstream::in | std::stringstream::out);
-        *filePath << path->str() << OUTPUT_FILE_NAME << OUTPUT_FILE_EXT;
+        *filePath << path->str() << OUTPUT_FILE_NAME << ((this->format == BIN) ? OUTPUT_BINARY_FILE_EXT : OUTPUT_FILE_EXT);
 
         this->solPathFile = filePath->str();
-        std::fstream outFile(this->solPathFile.c_str(), std::ofstream::out);
-        outFile.close();
+        this->closeSolutionFile();
+        // The binary file is created with the header (see writeSolutionHeader)
+        if (this->format == TAB){
+            this->solFile = fopen(this->solPathFile.c_str(), "w");
+            if (this->solFile != NULL){
+                this->solBuffer = new char[SOLUTION_BUFFER_SIZE];
+                setvbuf(this->solFile, this->solBuffer, _IOFBF, SOLUTION_BUFFER_SIZE);
+            } else {
+                std::stringstream* out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+                *out << "Error: the output file " << this->solPathFile << " cannot be opened" << std::endl;
+                PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+                delete out;
+            }
+        }
+        this->lastFlush = time(NULL);
+
+        // The runs file is created by the first summary
+        this->runsPathFile = path->str() + RUNS_FILE_NAME;
+        this->runsFileStarted = false;
 
         // Create the jacobian directory
         std::stringstream* jacFolder = new std::stringstream(std::stringstream::in | std::stringstream::out);
@@ -121,6 +195,7 @@ namespace DYTSI_Output {
         // Setting up separators
         switch (this->format){
             case TAB:
+            case BIN:
                 this->valuesSeparator = TAB_SEPARATOR;
                 this->entriesSeparator = TAB_NEWENTRY;
                 break;
@@ -128,51 +203,93 @@ namespace DYTSI_Output {
     }
 
     void OutputHandler::writeSolutionHeader(std::vector<std::string> header){
-        std::fstream outFile(this->solPathFile.c_str(), std::fstream::out|std::fstream::app);
+        if (this->format == BIN){
+            this->binaryWriter.open(this->solPathFile, header, INDEX_COLUMN_NAME);
+            return;
+        }
+
+        std::stringstream outLine(std::stringstream::in|std::stringstream::out);
 
         // Write the header
         for(std::vector<std::string>::iterator it = header.begin();
                 it != header.end(); ++it){
             std::string headerEntry = *it;
-            outFile << "\"" << headerEntry << "\"" << valuesSeparator;
+            outLine << "\"" << headerEntry << "\"" << valuesSeparator;
         }
-        outFile << entriesSeparator;
+        outLine << entriesSeparator;
 
-        outFile.close();
+        std::string outStr = outLine.str();
+        this->writeLine(outStr.c_str(), outStr.size());
     }
 
     void OutputHandler::writeSolutionEntry(double* entry, int N_VARS){
-        std::fstream outFile(this->solPathFile.c_str(), std::fstream::out|std::fstream::app);
-        outFile.precision(10);
+        if (this->format == BIN){
+            this->binaryWriter.addEntry(entry);
+            time_t now = time(NULL);
+            if (now - this->lastFlush >= FLUSH_INTERVAL){
+                this->binaryWriter.flush();
+                this->lastFlush = now;
+            }
+            return;
+        }
+
+        size_t sepSize = strlen(this->valuesSeparator);
+        size_t entrySize = strlen(this->entriesSeparator);
+        size_t maxSize = N_VARS * (MAX_NUMBER_LENGTH + sepSize) + entrySize;
+        if (this->line.size() < maxSize)
+            this->line.resize(maxSize);
 
         // Write one entry
+        char* p = &this->line[0];
         for( int i = 0; i < N_VARS; i++ ){
-            outFile << std::scientific << entry[i] << valuesSeparator;
+            p += formatScientific(entry[i], p);
+            memcpy(p, this->valuesSeparator, sepSize);
+            p += sepSize;
         }
-        outFile << entriesSeparator;
+        memcpy(p, this->entriesSeparator, entrySize);
+        p += entrySize;
 
-        outFile.close();
+        this->writeLine(&this->line[0], p - &this->line[0]);
+    }
+
+    void OutputHandler::writeRunSummary(int index, const std::string& runClass, double tEnd, double amplitude, double period){
+        FILE* runsFile = fopen(this->runsPathFile.c_str(), this->runsFileStarted ? "a" : "w");
+        if (runsFile == NULL)
+            return;
+        if (!this->runsFileStarted){
+            fprintf(runsFile, "\"Index\"\t\"Class\"\t\"TimeEnd\"\t\"Amplitude\"\t\"Period\"\n");
+            this->runsFileStarted = true;
+        }
+        fprintf(runsFile, "%d\t%s\t%.10e\t%.10e\t%.10e\n", index, runClass.c_str(), tEnd, amplitude, period);
+        fclose(runsFile);
     }
 
     void OutputHandler::writeJacobian(double* dfdy, int N_VARS, int idx){
         std::stringstream* jacFile = new std::stringstream(std::stringstream::in | std::stringstream::out);
         *jacFile << this->jacPathDir << JACOBIAN_FILE_NAME << "-" << idx << JACOBIAN_FILE_EXT;
 
-        std::fstream outFile(jacFile->str().c_str(), std::fstream::out|std::fstream::app);
-
-        // Set the matrix view
-        gsl_matrix_view dfdy_mat = gsl_matrix_view_array (dfdy,N_VARS,N_VARS);
+        FILE* outFile = fopen(jacFile->str().c_str(), "a");
+        delete jacFile;
+        if (outFile == NULL)
+            return;
 
-        // Write
+        // Write the rows of the matrix (row major) in one buffer
+        size_t maxSize = N_VARS * (MAX_NUMBER_LENGTH + 1) + 1;
+        if (this->line.size() < maxSize)
+            this->line.resize(maxSize);
         for(int i = 0; i < N_VARS; i++){
+            char* p = &this->line[0];
+            const double* row = &dfdy[i * N_VARS];
             for( int j = 0; j < N_VARS; j++ ){
-                outFile << gsl_matrix_get(&dfdy_mat.matrix, i, j) << "\t";
+                p += formatScientific(row[j], p);
+                *p++ = '\t';
             }
-            outFile << std::endl;
+            *p++ = '\n';
+            fwrite(&this->line[0], 1, p - &this->line[0], outFile);
         }
 
         // Close the file
-        outFile.close();
+        fclose(outFile);
     }
 
 //    void OutputHandler::writeSolution(DYTSI_Solver::Solution* solution){
@@ -34,7 +34,11 @@
 #ifndef OUTPUTHANDLER_H
 #define	OUTPUTHANDLER_H
 
+#include "BinarySolutionWriter.h"
+
 #include <xercesc/dom/DOM.hpp>
+#include <stdio.h>
+#include <time.h>
 #include <vector>
 #include <string>
 
@@ -52,26 +56,50 @@ namespace DYTSI_Output {
         void writeSolutionHeader(std::vector<std::string> header);
         void writeSolutionEntry(double* entry, int N_VARS);
         void writeJacobian(double* dfdy, int N_VARS, int idx);
+        // One line per run in runs.dat (see DYTSI_Solver::ConvergenceMonitor)
+        void writeRunSummary(int index, const std::string& runClass, double tEnd, double amplitude, double period);
+        // Write the buffered entries to the solution file (at the end of each run)
+        void flush();
+        // Number of runs whose last state is kept by the solutions (0: whole history)
+        int getStoredRuns(){ return storedRuns; }
         //void writeSolution(DYTSI_Solver::Solution* solution);
 
-        static const int N_FORMAT_TYPE = 1;
+        static const int N_FORMAT_TYPE = 2;
         static const int N_PLOTTING_TYPE = 2;
         static const std::string* FormatTypeNames[N_FORMAT_TYPE];
         static const std::string* PlottingTypeNames[N_PLOTTING_TYPE];
 
-        enum FormatType {TAB};
+        // TAB: text, one entry per line (output.dat). BIN: columns blocked by run index
+        // (output.bin, see BinarySolutionFormat; DYTSIbin2tab converts it to TAB)
+        enum FormatType {TAB, BIN};
         enum PlottingType {NONE, GNUPlot};
 
     private:
         DYTSI_Input::Input* input;
         std::string solPathFile;
         std::string jacPathDir;
+        std::string runsPathFile;
+        bool runsFileStarted;
 
         char* valuesSeparator;
         char* entriesSeparator;
 
         FormatType format;
         PlottingType plotting;
+        int storedRuns;
+
+        // The solution file is kept open between reset() calls and written through a
+        // large buffer, flushed when full, every FLUSH_INTERVAL seconds and by flush()
+        FILE* solFile;
+        char* solBuffer;
+        BinarySolutionWriter binaryWriter;
+        time_t lastFlush;
+        std::vector<char> line;
+        static const size_t SOLUTION_BUFFER_SIZE = 1 << 20;
+        static const int FLUSH_INTERVAL = 5;
+
+        void closeSolutionFile();
+        void writeLine(const char* begin, size_t size);
     };
 }
 
@@ -0,0 +1,91 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+#include "ScientificFormat.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace DYTSI_Output {
+
+    // Digits after the decimal point of the values written (as %.10e)
+    const int FORMAT_PRECISION = 10;
+    // Powers of ten exactly representable as double
+    const double EXACT_POW10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+            1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+    const int MAX_EXACT_POW10 = 22;
+
+    int formatScientific(double value, char* out){
+        double a = fabs(value);
+        int e = 0;
+        uint64_t m = 0;
+
+        if (a != 0.0){
+            if (!(a >= 1e-12 && a < 1e33))
+                return snprintf(out, MAX_NUMBER_LENGTH, "%.10e", value);
+            e = (int) floor(log10(a));
+            // log10 can be off by one close to the powers of ten
+            bool found = false;
+            for (int iter = 0; iter < 3 && !found; iter++){
+                int k = FORMAT_PRECISION - e;
+                if (k > MAX_EXACT_POW10 || k < -MAX_EXACT_POW10)
+                    break;
+                double scaled = (k >= 0) ? a * EXACT_POW10[k] : a / EXACT_POW10[-k];
+                m = (uint64_t) (scaled + 0.5);
+                if (m >= 100000000000ULL)
+                    e++;
+                else if (m < 10000000000ULL)
+                    e--;
+                else
+                    found = true;
+            }
+            if (!found)
+                return snprintf(out, MAX_NUMBER_LENGTH, "%.10e", value);
+        }
+
+        char* p = out;
+        if (signbit(value))
+            *p++ = '-';
+        char digits[FORMAT_PRECISION + 1];
+        for (int i = FORMAT_PRECISION; i >= 0; i--){
+            digits[i] = '0' + (char) (m % 10);
+            m /= 10;
+        }
+        *p++ = digits[0];
+        *p++ = '.';
+        memcpy(p, &digits[1], FORMAT_PRECISION);
+        p += FORMAT_PRECISION;
+        *p++ = 'e';
+        *p++ = (e < 0) ? '-' : '+';
+        int absE = (e < 0) ? -e : e;
+        if (absE >= 100)
+            *p++ = '0' + (char) (absE / 100);
+        *p++ = '0' + (char) ((absE / 10) % 10);
+        *p++ = '0' + (char) (absE % 10);
+        return p - out;
+    }
+}
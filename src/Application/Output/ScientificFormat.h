@@ -0,0 +1,45 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+#ifndef SCIENTIFICFORMAT_H
+#define	SCIENTIFICFORMAT_H
+
+namespace DYTSI_Output {
+
+    // Max length of a value written by formatScientific
+    const int MAX_NUMBER_LENGTH = 32;
+
+    /**
+     * Write value as printf("%.10e") would, without the locale and the parsing of the
+     * format. The 11 significant digits are obtained by one correctly rounded scaling by
+     * an exact power of ten, so the last digit can differ from printf only for values
+     * within a few units in the last place of a tie. NaN, inf and the values for which
+     * the scaling is not exact (|value| < 1e-12 or |value| >= 1e33) are left to snprintf.
+     * @return the number of characters written (not null terminated)
+     */
+    int formatScientific(double value, char* out);
+}
+
+#endif	/* SCIENTIFICFORMAT_H */
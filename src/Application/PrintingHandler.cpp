@@ -33,9 +33,15 @@
 
 #include "PrintingHandler.h"
 #include <iostream>
+#include <pthread.h>
 
 extern int RunningMode_graphics;
 
+// Output buffer of the calling thread (NULL if the output goes straight to the console)
+static __thread std::stringstream* threadBuffer = NULL;
+// Serializes the writes on the console
+static pthread_mutex_t consoleMutex = PTHREAD_MUTEX_INITIALIZER;
+
 PrintingHandler::PrintingHandler() {
 }
 
@@ -48,6 +54,38 @@ void PrintingHandler::printOut(char* output, OutputType type){
 
 void PrintingHandler::printOut(std::stringstream* output, OutputType type){
     if (RunningMode_graphics == false){
+        if (threadBuffer != NULL){
+            *threadBuffer << output->str();
+            return;
+        }
+        pthread_mutex_lock(&consoleMutex);
         std::cout << output->str();
+        pthread_mutex_unlock(&consoleMutex);
+    }
+}
+
+/**
+ * Start collecting the output of the calling thread, instead of printing it.
+ */
+void PrintingHandler::startBuffering(){
+    if (threadBuffer == NULL)
+        threadBuffer = new std::stringstream(std::stringstream::in|std::stringstream::out);
+}
+
+/**
+ * Stop collecting the output of the calling thread.
+ * @return the output collected since startBuffering()
+ */
+std::string PrintingHandler::stopBuffering(){
+    std::string outStr;
+    if (threadBuffer != NULL){
+        outStr = threadBuffer->str();
+        delete threadBuffer;
+        threadBuffer = NULL;
     }
+    return outStr;
+}
+
+bool PrintingHandler::isBuffering(){
+    return (threadBuffer != NULL);
 }
@@ -35,6 +35,7 @@
 #define	PRINTINGHANDLER_H
 
 #include <sstream>
+#include <string>
 
 class PrintingHandler {
 public:
@@ -46,6 +47,11 @@ public:
 
     static void printOut(char* output, OutputType type);
     static void printOut(std::stringstream* output, OutputType type);
+
+    // Per-thread buffering of the output (used when the tests run concurrently)
+    static void startBuffering();
+    static std::string stopBuffering();
+    static bool isBuffering();
 private:
 
 };
@@ -28,6 +28,7 @@
 #include "miscellaneous.h"
 
 #include "Input/InputHandler.h"
+#include "Input/InputScheduler.h"
 #include "PrintingHandler.h"
 #include "../GeneralModel/DYTSI_Modelling.h"
 
@@ -61,6 +62,8 @@ extern int RunningMode_graphics;
 
 int Simulation::mode = 0;
 ExecMode Simulation::execMode = NO_THREADS;
+int Simulation::nJobs = 1;
+int Simulation::nTests = 1;
 
 void Simulation::readInput(int argc, char* argv[]){
     bool error = false;
@@ -103,20 +106,9 @@ void Simulation::startSimulations(){
     PrintingHandler::printOut(out,PrintingHandler::STDOUT);
     delete out;
 
-    // Iterate over the inputs
-    //for( std::vector<DYTSI_Input::Input>::iterator input = (this->inputHandler->getInputList()).begin();
-    //        input != this->inputHandler->getInputList().end(); ++input){
-    std::vector<DYTSI_Input::Input*> inputList = this->inputHandler->getInputList();
-    for(unsigned int i = 0; i < inputList.size(); i++){
-
-        DYTSI_Input::Input* input = inputList[i];
-
-        
-        input->simulate();
-
-        //input->getOutputHandler()->writeSolution(sol);
-
-    }
+    // Run the inputs (concurrently if requested)
+    DYTSI_Input::InputScheduler scheduler(Simulation::nTests);
+    scheduler.run(this->inputHandler->getInputList());
 
     out = new std::stringstream(std::stringstream::in|std::stringstream::out);
     *out << std::endl << "Finished the Simulations" << std::endl;
@@ -134,9 +126,11 @@ Simulation::Simulation(int argc, char* argv[]){
 
   if (argc < 4){
     cout << "Not enough input arguments!" << endl;
-    cout << "USAGE: ./simulation -<GraphicMode> -<ThreadMode> <INPUT_file_1>.xml ... <INPUT_file_n>.xml" << endl;
+    cout << "USAGE: ./simulation -<GraphicMode> -<ThreadMode> [-j <N_jobs>] [-p <N_tests>] <INPUT_file_1>.xml ... <INPUT_file_n>.xml" << endl;
     cout << "USAGE: Possible Graphic modes: G, T" << endl;
     cout << "USAGE: Possible Thread modes: nt, pt" << endl;
+    cout << "USAGE: -j <N_jobs>: number of concurrent simulations in the bifurcation sweeps (default 1)" << endl;
+    cout << "USAGE: -p <N_tests>: number of tests run concurrently (default 1)" << endl;
     exit(1);
   }
 
@@ -149,13 +143,34 @@ Simulation::Simulation(int argc, char* argv[]){
         Simulation::execMode = THREADS;
   } else {
         cout << "Wrong arguments!" << endl;
-        cout << "USAGE: ./simulation -<GraphicMode> -<ThreadMode> <INPUT_file_1>.xml ... <INPUT_file_n>.xml" << endl;
+        cout << "USAGE: ./simulation -<GraphicMode> -<ThreadMode> [-j <N_jobs>] [-p <N_tests>] <INPUT_file_1>.xml ... <INPUT_file_n>.xml" << endl;
         cout << "USAGE: Possible Graphic modes: G, T" << endl;
         cout << "USAGE: Possible Thread modes: nt, pt" << endl;
+        cout << "USAGE: -j <N_jobs>: number of concurrent simulations in the bifurcation sweeps (default 1)" << endl;
+        cout << "USAGE: -p <N_tests>: number of tests run concurrently (default 1)" << endl;
         exit(1);
   }
 
-  this->readInput(argc-3, &argv[3]);
+  // Set the number of concurrent jobs and tests
+  int firstInput = 3;
+  while ((argc > firstInput) &&
+          ((strcmp(argv[firstInput],"-j") == 0) || (strcmp(argv[firstInput],"-p") == 0))){
+        if ((argc < firstInput + 3) || (atoi(argv[firstInput+1]) < 1)){
+            cout << "Wrong arguments!" << endl;
+            cout << "USAGE: " << argv[firstInput] << " <N>: N must be a positive integer followed by the input files" << endl;
+            exit(1);
+        }
+        if (strcmp(argv[firstInput],"-j") == 0){
+            Simulation::nJobs = atoi(argv[firstInput+1]);
+            cout << "Concurrent jobs: " << Simulation::nJobs << endl;
+        } else {
+            Simulation::nTests = atoi(argv[firstInput+1]);
+            cout << "Concurrent tests: " << Simulation::nTests << endl;
+        }
+        firstInput += 2;
+  }
+
+  this->readInput(argc-firstInput, &argv[firstInput]);
   if (!this->input_loaded){
       std::stringstream* out = new std::stringstream(std::stringstream::in|std::stringstream::out);
       *out << "Error: the input has not been correctly loaded." << std::endl;
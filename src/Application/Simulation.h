@@ -30,9 +30,12 @@
 #include <stdlib.h>
 
 #include "Input/InputHandler.h"
+#include "../GeneralModel/enumDeclarations.h"
 
 // Global variables
-enum ExecMode {NO_THREADS, THREADS};
+using DYTSI_Modelling::ExecMode;
+using DYTSI_Modelling::NO_THREADS;
+using DYTSI_Modelling::THREADS;
 
 void printRsgeo();
 
@@ -53,6 +56,8 @@ public:
     bool getInput_loaded();
 
     static ExecMode getExecMode(){ return execMode; }
+    static int getNJobs(){ return nJobs; }
+    static int getNTests(){ return nTests; }
 
 private:
     DYTSI_Input::InputHandler* inputHandler;
@@ -60,7 +65,9 @@ private:
     bool input_loaded;
     
     static int mode; // 0 Text mode, 1 Graphic mode
-    static ExecMode execMode; // 0 Non-Thread, 1 Thread mode
+    static ExecMode execMode; // 0 Non-Thread, 1 Thread mode (default of the models)
+    static int nJobs; // Number of concurrent simulations in the sweeps
+    static int nTests; // Number of tests run concurrently
 
 //    void toMatlabFile(const char* file, int simN, InputStruct in, std::vector<SolEntry>& sim);
 //    void toGnuPlotFile(const char* file, int simN, InputStruct in, std::vector<SolEntry>& sim, bool plot);
@@ -44,4 +44,9 @@ namespace DYTSI_Modelling {
 
     BogieFrameCarBodyConnector::~BogieFrameCarBodyConnector() {
     }
+
+    Connector* BogieFrameCarBodyConnector::clone(Component* upper, Component* lower,
+                RelativeComponentPosition posLower){
+        return new BogieFrameCarBodyConnector(this->getName(), upper, lower, UP, posLower);
+    }
 }
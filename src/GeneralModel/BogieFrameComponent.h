@@ -87,14 +87,7 @@ namespace DYTSI_Modelling {
         // Implementation of virtual Component classes
         int computeFun( double t, double y[], double f[] );
         int computeJac( double t, double y[], double* dfdy, double dfdt[]);
-        void updateTransformationMatrix( gsl_matrix* mat, double y[]);
-        void updateDTransformationMatrix( gsl_matrix* mat, double y[]);
-        void updateDisplacementVector( gsl_vector* vec, double y[] );
-        void updateDDisplacementVector( gsl_vector* vec, double y[] );
-        void updateTransformationMatrix( gsl_matrix* mat, const double y[]);
-        void updateDTransformationMatrix( gsl_matrix* mat, const double y[]);
-        void updateDisplacementVector( gsl_vector* vec, const double y[] );
-        void updateDDisplacementVector( gsl_vector* vec, const double y[] );
+        template<class T> void kinematics(const T y[], BodyKinematics<T>& k);
 
         int get_N_DOF() { return N_DOF; }
 
@@ -104,6 +97,7 @@ namespace DYTSI_Modelling {
         const double* getCurrentY();
         void init();
         std::string printCounters();
+        Component* clone(GeneralModel* gm, ExternalComponents* externalComponents);
 
         double get_mass(){ return mass; }
         double get_b() { return b; }
@@ -137,32 +131,22 @@ namespace DYTSI_Modelling {
         const double* upY;
         double* locF;
 
-        // Transformation matrices
-        gsl_matrix* locTransformationMatrix;
-        gsl_matrix* locDTransformationMatrix;
-        gsl_matrix* upTransformationMatrix;
-        gsl_matrix* upDTransformationMatrix;
-        gsl_matrix* llTransformationMatrix;
-        gsl_matrix* llDTransformationMatrix;
-        gsl_matrix* ltTransformationMatrix;
-        gsl_matrix* ltDTransformationMatrix;
-        // Displacement vectors
-        gsl_vector* locDisp;
-        gsl_vector* locDDisp;
-        gsl_vector* upDisp;
-        gsl_vector* upDDisp;
-        gsl_vector* llDisp;
-        gsl_vector* llDDisp;
-        gsl_vector* ltDisp;
-        gsl_vector* ltDDisp;
-
-        gsl_vector* vecForceAndMoment;
-
+        // Displacements and rotations of the body and of the neighbours
+        BodyKinematics<double> locKin;
+        BodyKinematics<double> upKin;
+        BodyKinematics<double> llKin;
+        BodyKinematics<double> ltKin;
 
     protected:
         int computeConnectorsForcesAndMoments();
-        gsl_vector* computeCentrifugalForceAndMoment();
+        void computeCentrifugalForceAndMoment(double forceAndMoment[6]);
         int rhs(double t, const double y[], gsl_matrix* outRHS);
+        int rhs(double t, const ADScalar y[], ADScalar outRHS[]);
+        // Bodies of the connector forces and of rhs, for double and ADScalar
+        template<class T> int connectorsForcesAndMomentsT(const BodyKinematics<T>& loc, const BodyKinematics<T>& up,
+                const BodyKinematics<T>& ll, const BodyKinematics<T>& lt, T connFM[6]);
+        template<class T> int rhsT(const T y[], BodyKinematics<T>& loc, BodyKinematics<T>& up,
+                BodyKinematics<T>& ll, BodyKinematics<T>& lt, T connFM[6], T f[]);
     };
 }
 
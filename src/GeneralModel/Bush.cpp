@@ -35,7 +35,7 @@
 #include "IndependentDamper.h"
 #include "IndependentSpring.h"
 
-#include <gsl/gsl_blas.h>
+#include <gsl/gsl_errno.h>
 
 namespace DYTSI_Modelling {
     Bush::Bush(std::string name, gsl_vector* connectionPointUp, gsl_vector* connectionPointDown,
@@ -53,37 +53,63 @@ namespace DYTSI_Modelling {
                 dampingFunctionX, dampingFunctionY, dampingFunctionZ );
     }
 
+    Bush::Bush(std::string name, gsl_vector* connectionPointUp, gsl_vector* connectionPointDown,
+                IndependentSpring* independentSpring, IndependentDamper* independentDamper)
+    : Link(name, connectionPointUp, connectionPointDown){
+        this->independentSpring = independentSpring;
+        this->independentDamper = independentDamper;
+    }
+
     Bush::~Bush() {
     }
 
-    gsl_vector* Bush::computeForceAndMoments(
-                RelativeComponentPosition posConnector,
-                gsl_vector* dispMain, gsl_vector* dispAttached,
-                gsl_vector* ddispMain, gsl_vector* ddispAttached,
-                gsl_matrix* transformationMatrixMain, gsl_matrix* transformationMatrixAttached,
-                gsl_matrix* dTransformationMatrixMain, gsl_matrix* dTransformationMatrixAttached,
-                int& errCode) {
-        gsl_vector* out = gsl_vector_calloc(6);
-        
+    Link* Bush::clone(){
+        return new Bush(this->getBaseName(),
+                this->getConnectionPointUpWRTCenterOfGeometry(),
+                this->getConnectionPointDownWRTCenterOfGeometry(),
+                (IndependentSpring*) this->independentSpring->clone(),
+                (IndependentDamper*) this->independentDamper->clone());
+    }
+
+    template<class T>
+    int Bush::genericForceAndMoments(RelativeComponentPosition posConnector,
+                const BodyKinematics<T>& main, const BodyKinematics<T>& attached,
+                T forceAndMoments[6]) {
+        int errCode;
+
         // Compute the forces due to spring and damping component
-        gsl_vector* springForces = this->independentSpring->computeForceAndMoments(posConnector, dispMain, dispAttached, ddispMain,
-                ddispAttached, transformationMatrixMain, transformationMatrixAttached, dTransformationMatrixMain,
-                dTransformationMatrixAttached, errCode);
-        if (errCode != GSL_SUCCESS){ return out; }
-        gsl_vector* damperForces = this->independentDamper->computeForceAndMoments(posConnector, dispMain, dispAttached, ddispMain,
-                ddispAttached, transformationMatrixMain, transformationMatrixAttached, dTransformationMatrixMain,
-                dTransformationMatrixAttached, errCode);
-        if (errCode != GSL_SUCCESS){ return out; }
+        T springForces[6];
+        errCode = this->independentSpring->computeForceAndMoments(posConnector, main, attached, springForces);
+        if (errCode != GSL_SUCCESS){
+            for (int i = 0; i < 6; i++)
+                forceAndMoments[i] = springForces[i];
+            return errCode;
+        }
+        T damperForces[6];
+        errCode = this->independentDamper->computeForceAndMoments(posConnector, main, attached, damperForces);
+        if (errCode != GSL_SUCCESS){
+            for (int i = 0; i < 6; i++)
+                forceAndMoments[i] = damperForces[i];
+            return errCode;
+        }
 
         // Take the sum of the forces
-        gsl_vector_memcpy(out, springForces);
-        gsl_blas_daxpy(1.0, damperForces, out);
+        for (int i = 0; i < 6; i++)
+            forceAndMoments[i] = springForces[i] + damperForces[i];
 
-        // Free the memory
-        gsl_vector_free(springForces);
-        gsl_vector_free(damperForces);
+        return errCode;
+    }
+
+    int Bush::computeForceAndMoments(RelativeComponentPosition posConnector,
+                const BodyKinematics<double>& main, const BodyKinematics<double>& attached,
+                double forceAndMoments[6]){
+        return this->genericForceAndMoments(posConnector, main, attached, forceAndMoments);
+    }
 
-        return out;
+    int Bush::computeForceAndMoments(RelativeComponentPosition posConnector,
+                const BodyKinematics<ADScalar>& main, const BodyKinematics<ADScalar>& attached,
+                ADScalar forceAndMoments[6]){
+        return this->genericForceAndMoments(posConnector, main, attached, forceAndMoments);
     }
 
     IndependentSpring* Bush::getIndependentSpring() {
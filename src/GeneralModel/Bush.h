@@ -47,21 +47,29 @@ namespace DYTSI_Modelling {
                 Function* stiffnessFunctionX, Function* stiffnessFunctionY, Function* stiffnessFunctionZ,
                 Function* dampingFunctionX, Function* dampingFunctionY, Function* dampingFunctionZ);
         virtual ~Bush();
+        Link* clone();
 
-        gsl_vector* computeForceAndMoments(
-                RelativeComponentPosition posConnector,
-                gsl_vector* dispMain, gsl_vector* dispAttached,
-                gsl_vector* ddispMain, gsl_vector* ddispAttached,
-                gsl_matrix* transformationMatrixMain, gsl_matrix* transformationMatrixAttached,
-                gsl_matrix* dTransformationMatrixMain, gsl_matrix* dTransformationMatrixAttached,
-                int& errCode);
+        int computeForceAndMoments(RelativeComponentPosition posConnector,
+                const BodyKinematics<double>& main, const BodyKinematics<double>& attached,
+                double forceAndMoments[6]);
+        int computeForceAndMoments(RelativeComponentPosition posConnector,
+                const BodyKinematics<ADScalar>& main, const BodyKinematics<ADScalar>& attached,
+                ADScalar forceAndMoments[6]);
 
         IndependentSpring* getIndependentSpring();
         IndependentDamper* getIndependentDamper();
     private:
+        template<class T>
+        int genericForceAndMoments(RelativeComponentPosition posConnector,
+                const BodyKinematics<T>& main, const BodyKinematics<T>& attached,
+                T forceAndMoments[6]);
+
         IndependentSpring* independentSpring;
         IndependentDamper* independentDamper;
 
+    protected:
+        Bush(std::string name, gsl_vector* connectionPointUp, gsl_vector* connectionPointDown,
+                IndependentSpring* independentSpring, IndependentDamper* independentDamper);
     };
 }
 
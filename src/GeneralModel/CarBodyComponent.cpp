@@ -40,7 +40,6 @@
 
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_matrix.h>
-#include <gsl/gsl_blas.h>
 
 #include "../Application/PrintingHandler.h"
 #include "../Application/Simulation.h"
@@ -74,28 +73,6 @@ namespace DYTSI_Modelling {
         this->Iy = Iy;
         this->Iz = Iz;
 
-        // Allocation of the Transformation Matrices
-        this->locTransformationMatrix = gsl_matrix_calloc(3,3);
-        for ( int i = 0; i < 3; i++ ) gsl_matrix_set(this->locTransformationMatrix,i,i,1.0);
-        this->locDTransformationMatrix = gsl_matrix_calloc(3,3);
-        this->llTransformationMatrix = gsl_matrix_calloc(3,3);
-        for ( int i = 0; i < 3; i++ ) gsl_matrix_set(this->llTransformationMatrix,i,i,1.0);
-        this->llDTransformationMatrix = gsl_matrix_calloc(3,3);
-        this->ltTransformationMatrix = gsl_matrix_calloc(3,3);
-        for ( int i = 0; i < 3; i++ ) gsl_matrix_set(this->ltTransformationMatrix,i,i,1.0);
-        this->ltDTransformationMatrix = gsl_matrix_calloc(3,3);
-
-        // Allocation of the displacement vectors
-        this->locDisp = gsl_vector_calloc(3);
-        this->locDDisp = gsl_vector_calloc(3);
-        this->llDisp = gsl_vector_calloc(3);
-        this->llDDisp = gsl_vector_calloc(3);
-        this->ltDisp = gsl_vector_calloc(3);
-        this->ltDDisp = gsl_vector_calloc(3);
-
-        // aux vectors
-        this->vecForceAndMoment = gsl_vector_alloc(6);
-
         ///////////////////////////////////////////////////////
         // Set up interdependencies for the numerical Jacobian
 
@@ -235,56 +212,47 @@ namespace DYTSI_Modelling {
         this->llY = &(y[this->llComponent->get_startingDOF()]);
         this->ltY = &(y[this->ltComponent->get_startingDOF()]);
 
-        // Update the transformation matrices
-        this->updateTransformationMatrix(this->locTransformationMatrix, y);
-        this->updateDTransformationMatrix(this->locDTransformationMatrix, y);
-        this->llComponent->updateTransformationMatrix(this->llTransformationMatrix, y);
-        this->llComponent->updateDTransformationMatrix(this->llDTransformationMatrix, y);
-        this->ltComponent->updateTransformationMatrix(this->ltTransformationMatrix, y);
-        this->ltComponent->updateDTransformationMatrix(this->ltDTransformationMatrix, y);
-
-        // Update the displacement vectors
-        this->updateDisplacementVector(this->locDisp, y);
-        this->updateDDisplacementVector(this->locDDisp, y);
-        this->llComponent->updateDisplacementVector(this->llDisp, y);
-        this->llComponent->updateDDisplacementVector(this->llDDisp, y);
-        this->ltComponent->updateDisplacementVector(this->ltDisp, y);
-        this->ltComponent->updateDDisplacementVector(this->ltDDisp, y);
+        // Update the displacements and rotations of the body and of the neighbours
+        this->kinematics(y, this->locKin);
+        this->llComponent->kinematics(y, this->llKin);
+        this->ltComponent->kinematics(y, this->ltKin);
 
         // Compute the connectors forces
         errCode = this->computeConnectorsForcesAndMoments();
 
         // Compute Gravitational forces and moments
-        gsl_vector* gravitationalForceAndMoment = this->computeGravitationalForceAndMoment();
+        double gravitationalForceAndMoment[6];
+        this->computeGravitationalForceAndMoment(gravitationalForceAndMoment);
 
         // Compute Centrifugal forces and moments
-        gsl_vector* centrifugalForceAndMoment = this->computeCentrifugalForceAndMoment();
+        double centrifugalForceAndMoment[6];
+        this->computeCentrifugalForceAndMoment(centrifugalForceAndMoment);
         ///////////////////////////////
 
         int pos = this->get_N_DOF();
         // Output the Connector forces
-        status[pos++] = gsl_vector_get(this->connectorsForcesAndMoments,0);
-        status[pos++] = gsl_vector_get(this->connectorsForcesAndMoments,1);
-        status[pos++] = gsl_vector_get(this->connectorsForcesAndMoments,2);
-        status[pos++] = gsl_vector_get(this->connectorsForcesAndMoments,3);
-        status[pos++] = gsl_vector_get(this->connectorsForcesAndMoments,4);
-        status[pos++] = gsl_vector_get(this->connectorsForcesAndMoments,5);
+        status[pos++] = this->connectorsForcesAndMoments[0];
+        status[pos++] = this->connectorsForcesAndMoments[1];
+        status[pos++] = this->connectorsForcesAndMoments[2];
+        status[pos++] = this->connectorsForcesAndMoments[3];
+        status[pos++] = this->connectorsForcesAndMoments[4];
+        status[pos++] = this->connectorsForcesAndMoments[5];
 
         // Output the Gravitational Forces and Moments
-        status[pos++] = gsl_vector_get(gravitationalForceAndMoment,0);
-        status[pos++] = gsl_vector_get(gravitationalForceAndMoment,1);
-        status[pos++] = gsl_vector_get(gravitationalForceAndMoment,2);
-        status[pos++] = gsl_vector_get(gravitationalForceAndMoment,3);
-        status[pos++] = gsl_vector_get(gravitationalForceAndMoment,4);
-        status[pos++] = gsl_vector_get(gravitationalForceAndMoment,5);
+        status[pos++] = gravitationalForceAndMoment[0];
+        status[pos++] = gravitationalForceAndMoment[1];
+        status[pos++] = gravitationalForceAndMoment[2];
+        status[pos++] = gravitationalForceAndMoment[3];
+        status[pos++] = gravitationalForceAndMoment[4];
+        status[pos++] = gravitationalForceAndMoment[5];
 
         // Output the Centrifugal Forces and Moments
-        status[pos++] = gsl_vector_get(centrifugalForceAndMoment,0);
-        status[pos++] = gsl_vector_get(centrifugalForceAndMoment,1);
-        status[pos++] = gsl_vector_get(centrifugalForceAndMoment,2);
-        status[pos++] = gsl_vector_get(centrifugalForceAndMoment,3);
-        status[pos++] = gsl_vector_get(centrifugalForceAndMoment,4);
-        status[pos++] = gsl_vector_get(centrifugalForceAndMoment,5);
+        status[pos++] = centrifugalForceAndMoment[0];
+        status[pos++] = centrifugalForceAndMoment[1];
+        status[pos++] = centrifugalForceAndMoment[2];
+        status[pos++] = centrifugalForceAndMoment[3];
+        status[pos++] = centrifugalForceAndMoment[4];
+        status[pos++] = centrifugalForceAndMoment[5];
     }
 
     const double* CarBodyComponent::getCurrentY(){
@@ -339,6 +307,12 @@ namespace DYTSI_Modelling {
         this->getLowerTrailing()->getComponent()->init();
     }
 
+    Component* CarBodyComponent::clone(GeneralModel* gm, ExternalComponents* externalComponents){
+        return new CarBodyComponent(this->getCenterOfGeometry(), this->getCenterOfMassWRTCenterOfGeometry(),
+                this->mass, this->Ix, this->Iy, this->Iz,
+                externalComponents, this->get_baseName(), gm, this->get_isFixed());
+    }
+
     std::string CarBodyComponent::printCounters(){
         std::stringstream out(std::stringstream::in|std::stringstream::out);
         out << this->get_name() << ": RHS evaluations \t" << this->rhs_counter << std::endl;
@@ -351,44 +325,7 @@ namespace DYTSI_Modelling {
     int CarBodyComponent::computeFun( double t, double y[], double f[] ){
         int errCode = GSL_SUCCESS;
 
-        struct ExecInput llexecInput;
-        struct ExecInput ltexecInput;
-
-        double* llyCopy;
-        double* ltyCopy;
-
-        /**
-		 *  The following part has been moved to the parent class Component
-		 */
-//		// Start the lower components' function
-//		if (Simulation::getExecMode() == NO_THREADS){
-//			// Compute the lower leading component
-//			errCode = this->getLowerLeading()->getComponent()->fun(t,y,f);
-//			if ( errCode != GSL_SUCCESS )
-//				return errCode;
-//
-//			// Compute function for the lower trailing component
-//			errCode = this->getLowerTrailing()->getComponent()->fun(t,y,f);
-//			if ( errCode != GSL_SUCCESS )
-//				return errCode;
-//		} else {
-//			// Start the lower leading and lower trailing thread
-//			// Pack input lower leading
-//			llyCopy = new double[this->get_generalModel()->get_N_DOF()];
-//			memcpy(llyCopy, y, this->get_generalModel()->get_N_DOF() * sizeof(double));
-//			FunInput llfunInput = {t, llyCopy, f};
-//			llexecInput.type = FUN;
-//			llexecInput.input = &llfunInput;
-//			// Pack input lower trailing
-//			ltyCopy = new double[this->get_generalModel()->get_N_DOF()];
-//			memcpy(ltyCopy, y, this->get_generalModel()->get_N_DOF() * sizeof(double));
-//			FunInput ltfunInput = {t, ltyCopy, f};
-//			ltexecInput.type = FUN;
-//			ltexecInput.input = &ltfunInput;
-//
-//			this->getLowerLeading()->getComponent()->Start( &llexecInput );
-//			this->getLowerTrailing()->getComponent()->Start( &ltexecInput );
-//		}
+        // The lower components are evaluated by Component::fun before this call
 
         // Set up shortcuts
         this->llComponent = (DYTSI_Modelling::BogieFrameComponent*)
@@ -411,63 +348,11 @@ namespace DYTSI_Modelling {
             return errCode;
         }
 
-        // Wait for the lower threads
-        if (Simulation::getExecMode() == THREADS){
-            this->getLowerLeading()->getComponent()->Join();
-            this->getLowerTrailing()->getComponent()->Join();
-
-            // Free Memory
-            delete[] llyCopy;
-            delete[] ltyCopy;
-
-            // Check for errors
-            if (llexecInput.returnCode != GSL_SUCCESS)
-                return llexecInput.returnCode;
-            if (ltexecInput.returnCode != GSL_SUCCESS)
-                return ltexecInput.returnCode;
-        }
-
         return GSL_SUCCESS;
     }
 
     int CarBodyComponent::computeJac( double t, double y[], double* dfdy, double dfdt[]){
-        int errCode = GSL_SUCCESS;
-
-        ExecInput llexecInput;
-        ExecInput ltexecInput;
-        
-        double* llyCopy;
-        double* ltyCopy;
-
-        // Start the lower components' function
-        if (Simulation::getExecMode() == NO_THREADS){
-            // Compute jacobian for the lower leading component
-            errCode = this->getLowerLeading()->getComponent()->jac(t,y,dfdy,dfdt);
-            if ( errCode != GSL_SUCCESS )
-                return errCode;
-
-            // Compute jacobian for the lower trailing component
-            errCode = this->getLowerTrailing()->getComponent()->jac(t,y,dfdy,dfdt);
-            if ( errCode != GSL_SUCCESS )
-                return errCode;
-        } else {
-            // Start the lower leading and lower trailing thread
-            // Pack input lower leading
-            llyCopy = new double[this->get_generalModel()->get_N_DOF()];
-            memcpy(llyCopy, y, this->get_generalModel()->get_N_DOF() * sizeof(double));
-            JacInput lljacInput = {t, llyCopy, dfdy, dfdt};
-            llexecInput.type = JAC;
-            llexecInput.input = &lljacInput;
-            // Pack input lower trailing
-            ltyCopy = new double[this->get_generalModel()->get_N_DOF()];
-            memcpy(ltyCopy, y, this->get_generalModel()->get_N_DOF() * sizeof(double));
-            JacInput ltjacInput = {t, ltyCopy, dfdy, dfdt};
-            ltexecInput.type = JAC;
-            ltexecInput.input = &ltjacInput;
-
-            this->getLowerLeading()->getComponent()->Start( &llexecInput );
-            this->getLowerTrailing()->getComponent()->Start( &ltexecInput );
-        }
+        // The lower components are evaluated by Component::jac before this call
 
         // Set up shortcuts
         this->llComponent = (DYTSI_Modelling::BogieFrameComponent*)
@@ -497,104 +382,32 @@ namespace DYTSI_Modelling {
         // Jacobian initialization
         gsl_matrix_set_zero(&sub_dfdy.matrix);
 
-        // Jacobian: Numerical part
-        for( std::vector<int>::iterator iter = this->partialJacobianIdx.begin();
-                iter != this->partialJacobianIdx.end(); ++iter){
-            errCode = this->jac_numerical(t,y,&sub_dfdy.matrix,*iter);
-            if (errCode != GSL_SUCCESS)
-                return errCode;
-        }
-
-        // Wait for the lower threads
-        if (Simulation::getExecMode() == THREADS){
-            this->getLowerLeading()->getComponent()->Join();
-            this->getLowerTrailing()->getComponent()->Join();
-
-            // Free Memory
-            delete[] llyCopy;
-            delete[] ltyCopy;
-
-            // Check for errors
-            if (llexecInput.returnCode != GSL_SUCCESS)
-                return llexecInput.returnCode;
-            if (ltexecInput.returnCode != GSL_SUCCESS)
-                return ltexecInput.returnCode;
-        }
-
-        return errCode;
-    }
+        if (this->get_generalModel()->getJacobianMode() == JAC_AUTOMATIC)
+            return this->jac_ad(t, y, &sub_dfdy.matrix);
 
-    void CarBodyComponent::updateTransformationMatrix( gsl_matrix* mat, double y[]){
-        gsl_matrix_set(mat, 0, 1, -y[this->get_startingDOF()+PSI]);
-        gsl_matrix_set(mat, 1, 0, y[this->get_startingDOF()+PSI]);
-        gsl_matrix_set(mat, 1, 2, -y[this->get_startingDOF()+PHI]);
-        gsl_matrix_set(mat, 2, 1, y[this->get_startingDOF()+PHI]);
-        gsl_matrix_set(mat, 0, 2, y[this->get_startingDOF()+CHI]);
-        gsl_matrix_set(mat, 2, 0, -y[this->get_startingDOF()+CHI]);
-    }
-
-    void CarBodyComponent::updateDTransformationMatrix( gsl_matrix* mat, double y[]){
-        gsl_matrix_set(mat, 0, 1, -y[this->get_startingDOF()+PSIDOT]);
-        gsl_matrix_set(mat, 1, 0, y[this->get_startingDOF()+PSIDOT]);
-        gsl_matrix_set(mat, 1, 2, -y[this->get_startingDOF()+PHIDOT]);
-        gsl_matrix_set(mat, 2, 1, y[this->get_startingDOF()+PHIDOT]);
-        gsl_matrix_set(mat, 0, 2, y[this->get_startingDOF()+CHIDOT]);
-        gsl_matrix_set(mat, 2, 0, -y[this->get_startingDOF()+CHIDOT]);
-    }
-
-    void CarBodyComponent::updateDisplacementVector(gsl_vector* vec, double y[]){
-//        gsl_vector_set(vec, 0, y[this->get_startingDOF()+X]);
-        gsl_vector_set(vec, 0, 0.0);
-        gsl_vector_set(vec, 1, y[this->get_startingDOF()+Y]);
-        gsl_vector_set(vec, 2, y[this->get_startingDOF()+Z]);
-    }
-
-    void CarBodyComponent::updateDDisplacementVector(gsl_vector* vec, double y[]){
-//        gsl_vector_set(vec, 0, y[this->get_startingDOF()+XDOT]);
-        gsl_vector_set(vec, 0, 0.0);
-        gsl_vector_set(vec, 1, y[this->get_startingDOF()+YDOT]);
-        gsl_vector_set(vec, 2, y[this->get_startingDOF()+ZDOT]);
-    }
-
-    void CarBodyComponent::updateTransformationMatrix( gsl_matrix* mat, const double y[]){
-        gsl_matrix_set(mat, 0, 1, -y[this->get_startingDOF()+PSI]);
-        gsl_matrix_set(mat, 1, 0, y[this->get_startingDOF()+PSI]);
-        gsl_matrix_set(mat, 1, 2, -y[this->get_startingDOF()+PHI]);
-        gsl_matrix_set(mat, 2, 1, y[this->get_startingDOF()+PHI]);
-        gsl_matrix_set(mat, 0, 2, y[this->get_startingDOF()+CHI]);
-        gsl_matrix_set(mat, 2, 0, -y[this->get_startingDOF()+CHI]);
-    }
-
-    void CarBodyComponent::updateDTransformationMatrix( gsl_matrix* mat, const double y[]){
-        gsl_matrix_set(mat, 0, 1, -y[this->get_startingDOF()+PSIDOT]);
-        gsl_matrix_set(mat, 1, 0, y[this->get_startingDOF()+PSIDOT]);
-        gsl_matrix_set(mat, 1, 2, -y[this->get_startingDOF()+PHIDOT]);
-        gsl_matrix_set(mat, 2, 1, y[this->get_startingDOF()+PHIDOT]);
-        gsl_matrix_set(mat, 0, 2, y[this->get_startingDOF()+CHIDOT]);
-        gsl_matrix_set(mat, 2, 0, -y[this->get_startingDOF()+CHIDOT]);
+        // Jacobian: Numerical part
+        return this->jac_numerical(t,y,&sub_dfdy.matrix);
     }
 
-    void CarBodyComponent::updateDisplacementVector(gsl_vector* vec, const double y[]){
-//        gsl_vector_set(vec, 0, y[this->get_startingDOF()+X]);
-        gsl_vector_set(vec, 0, 0.0);
-        gsl_vector_set(vec, 1, y[this->get_startingDOF()+Y]);
-        gsl_vector_set(vec, 2, y[this->get_startingDOF()+Z]);
+    template<class T>
+    void CarBodyComponent::kinematics(const T y[], BodyKinematics<T>& k){
+        const T* ly = &(y[this->get_startingDOF()]);
+        k.trans.setSmallRotation(ly[PHI], ly[CHI], ly[PSI]);
+        k.dtrans.setSkew(ly[PHIDOT], ly[CHIDOT], ly[PSIDOT]);
+        k.r.set(0.0, ly[Y], ly[Z]);
+        k.dr.set(0.0, ly[YDOT], ly[ZDOT]);
     }
 
-    void CarBodyComponent::updateDDisplacementVector(gsl_vector* vec, const double y[]){
-//        gsl_vector_set(vec, 0, y[this->get_startingDOF()+XDOT]);
-        gsl_vector_set(vec, 0, 0.0);
-        gsl_vector_set(vec, 1, y[this->get_startingDOF()+YDOT]);
-        gsl_vector_set(vec, 2, y[this->get_startingDOF()+ZDOT]);
-    }
+    template void CarBodyComponent::kinematics<double>(const double y[], BodyKinematics<double>& k);
+    template void CarBodyComponent::kinematics<ADScalar>(const ADScalar y[], BodyKinematics<ADScalar>& k);
 
-    gsl_vector* CarBodyComponent::computeCentrifugalForceAndMoment( ){
+    void CarBodyComponent::computeCentrifugalForceAndMoment( double forceAndMoment[6] ){
         double val;
 
         // Get the nominal position of the body
-        double l = gsl_vector_get(this->getCenterOfMass(),0);
-        double b = gsl_vector_get(this->getCenterOfMass(),1);
-        double h = gsl_vector_get(this->getCenterOfMass(),2);
+        double l = this->getCenterOfMass()[0];
+        double b = this->getCenterOfMass()[1];
+        double h = this->getCenterOfMass()[2];
 
         // Get the external components
         double v = this->getExternalComponents()->get_v();
@@ -605,7 +418,7 @@ namespace DYTSI_Modelling {
         double cos_Phi_se = (this->getExternalComponents()->get_cos_Phi_se());
 
 //        // Set the x component
-        gsl_vector_set(vecForceAndMoment,0,0.0);
+        forceAndMoment[0] = 0.0;
 
         // Set the y component
 //        val = this->get_mass() * (
@@ -613,7 +426,7 @@ namespace DYTSI_Modelling {
 //                (h + this->locY[Z]) * sin_Phi_se * cos_Phi_se * vv / RR +
 //                (b + this->locY[Y]) * cos_Phi_se * cos_Phi_se * vv / RR );
        val = this->get_mass() * cos_Phi_se * vv / R;
-        gsl_vector_set(vecForceAndMoment,1,val);
+        forceAndMoment[1] = val;
 
         // Set the z component
 //        val = this->get_mass() * (
@@ -621,7 +434,7 @@ namespace DYTSI_Modelling {
 //                (h + this->locY[Z]) * sin_Phi_se * sin_Phi_se * vv / RR -
 //                (b + this->locY[Y]) * sin_Phi_se * cos_Phi_se * vv / RR);
         val = - this->get_mass() * sin_Phi_se *  vv / R;
-        gsl_vector_set(vecForceAndMoment,2,val);
+        forceAndMoment[2] = val;
 
         // Set the phi component
 //        val =   this->get_Ix() * (
@@ -633,7 +446,7 @@ namespace DYTSI_Modelling {
 //                    this->locY[CHIDOT] * cos_Phi_se * v / R +
 //                    this->locY[CHIDOT] * this->locY[PSIDOT] );
         val = 0.0;
-        gsl_vector_set(vecForceAndMoment,3,val);
+        forceAndMoment[3] = val;
 
         // Set the chi component
 //        val =   this->get_Iy() * this->locY[PHIDOT] * cos_Phi_se * v / R +
@@ -641,7 +454,7 @@ namespace DYTSI_Modelling {
 //                    -this->locY[PHIDOT] * cos_Phi_se * v / R -
 //                    this->locY[PSIDOT] * this->locY[PHIDOT] );
         val = 0.0;
-        gsl_vector_set(vecForceAndMoment,4,val);
+        forceAndMoment[4] = val;
 
         // Set the psi component
 //        val =   this->get_Iz() * this->locY[PHIDOT] * sin_Phi_se * v / R +
@@ -649,54 +462,91 @@ namespace DYTSI_Modelling {
 //                    -this->locY[PHIDOT] * sin_Phi_se * v / R -
 //                    this->locY[PHIDOT] * this->locY[CHIDOT]);
         val = 0.0;
-        gsl_vector_set(vecForceAndMoment,5,val);
+        forceAndMoment[5] = val;
 
-        return vecForceAndMoment;
     }
 
     int CarBodyComponent::computeConnectorsForcesAndMoments(){
+        return this->connectorsForcesAndMomentsT(this->locKin, this->llKin, this->ltKin,
+                this->connectorsForcesAndMoments);
+    }
+
+    /**
+     * Sum of the forces and moments of the connectors on the body, given the kinematics
+     * of the body and of the neighbours (instantiated for double and ADScalar).
+     */
+    template<class T>
+    int CarBodyComponent::connectorsForcesAndMomentsT(const BodyKinematics<T>& loc,
+            const BodyKinematics<T>& ll, const BodyKinematics<T>& lt, T connFM[6]){
         int errCode = GSL_SUCCESS;
+        T fm[6];
 
         // Initialize the sum of forces and moments
-        gsl_vector_set_zero(this->connectorsForcesAndMoments);
+        for (int i = 0; i < 6; i++)
+            connFM[i] = 0.0;
 
-        /////////////////////////////////
         // Lower Leading connector
-        {
-            gsl_vector* fm = this->llConnector->getForcesAndMoments( LL ,
-                    this->locDisp, this->llDisp, this->locDDisp, this->llDDisp,
-                    this->locTransformationMatrix, this->llTransformationMatrix,
-                    this->locDTransformationMatrix, this->llDTransformationMatrix,
-                    errCode);
-            if (errCode != GSL_SUCCESS){
-                return errCode;
-            }
-            // Add to the total forces and moments
-            gsl_blas_daxpy(1.0, fm, this->connectorsForcesAndMoments);
-            // Free memory
-            //gsl_vector_free(fm);
+        errCode = this->llConnector->getForcesAndMoments(LL, loc, ll, fm);
+        if (errCode != GSL_SUCCESS){
+            return errCode;
         }
-        /////////////////////////////////
+        for (int i = 0; i < 6; i++)
+            connFM[i] += fm[i];
 
-        /////////////////////////////////
         // Lower Trailing connector
-        {
-            gsl_vector* fm = this->ltConnector->getForcesAndMoments( LT,
-                    this->locDisp, this->ltDisp, this->locDDisp, this->ltDDisp,
-                    this->locTransformationMatrix, this->ltTransformationMatrix,
-                    this->locDTransformationMatrix, this->ltDTransformationMatrix,
-                    errCode);
-            if (errCode != GSL_SUCCESS){
-                return errCode;
-            }
-            // Add to the total forces and moments
-            gsl_blas_daxpy(1.0, fm, this->connectorsForcesAndMoments);
-            // Free memory
-            //gsl_vector_free(fm);
-            /////////////////////////////////
+        errCode = this->ltConnector->getForcesAndMoments(LT, loc, lt, fm);
+        if (errCode != GSL_SUCCESS){
+            return errCode;
+        }
+        for (int i = 0; i < 6; i++)
+            connFM[i] += fm[i];
 
+        return errCode;
+    }
+
+    /**
+     * Right hand side f of the body equations (instantiated for double and ADScalar).
+     * The kinematics and the connector forces are returned in loc, ll, lt and connFM.
+     * The gravitational and centrifugal forces do not depend on y.
+     */
+    template<class T>
+    int CarBodyComponent::rhsT(const T y[], BodyKinematics<T>& loc,
+            BodyKinematics<T>& ll, BodyKinematics<T>& lt, T connFM[6], T f[]){
+        int errCode = GSL_SUCCESS;
+        const T* ly = &(y[this->get_startingDOF()]);
+
+        // Update the displacements and rotations of the body and of the neighbours
+        this->kinematics(y, loc);
+        this->llComponent->kinematics(y, ll);
+        this->ltComponent->kinematics(y, lt);
+
+        // Compute the connectors forces
+        errCode = this->connectorsForcesAndMomentsT(loc, ll, lt, connFM);
+        if (errCode != GSL_SUCCESS){
             return errCode;
         }
+
+        // Compute Gravitational and Centrifugal forces and moments
+        double gravitationalForceAndMoment[6];
+        this->computeGravitationalForceAndMoment(gravitationalForceAndMoment);
+        double centrifugalForceAndMoment[6];
+        this->computeCentrifugalForceAndMoment(centrifugalForceAndMoment);
+        double extFM[6];
+        for (int i = 0; i < 6; i++)
+            extFM[i] = gravitationalForceAndMoment[i] + centrifugalForceAndMoment[i];
+
+        f[Y] = ly[YDOT];
+        f[YDOT] = (connFM[1] + extFM[1]) / this->mass;
+        f[Z] = ly[ZDOT];
+        f[ZDOT] = (connFM[2] + extFM[2]) / this->mass;
+        f[PSI] = ly[PSIDOT];
+        f[PSIDOT] = (connFM[5] + extFM[5]) / this->Iz;
+        f[PHI] = ly[PHIDOT];
+        f[PHIDOT] = (connFM[3] + extFM[3]) / this->Ix;
+        f[CHI] = ly[CHIDOT];
+        f[CHIDOT] = (connFM[4] + extFM[4]) / this->Ix;
+
+        return errCode;
     }
 
     int CarBodyComponent::rhs(double t, const double y[], gsl_matrix* outRHS){
@@ -711,106 +561,28 @@ namespace DYTSI_Modelling {
             return -1;
         }
 
-        // Set locY, llY, ltY and upY
+        // Set locY, llY, ltY
         this->locY = &(y[this->get_startingDOF()]);
         this->llY = &(y[this->llComponent->get_startingDOF()]);
         this->ltY = &(y[this->ltComponent->get_startingDOF()]);
 
-        // Update the transformation matrices
-        this->updateTransformationMatrix(this->locTransformationMatrix, y);
-        this->updateDTransformationMatrix(this->locDTransformationMatrix, y);
-        this->llComponent->updateTransformationMatrix(this->llTransformationMatrix, y);
-        this->llComponent->updateDTransformationMatrix(this->llDTransformationMatrix, y);
-        this->ltComponent->updateTransformationMatrix(this->ltTransformationMatrix, y);
-        this->ltComponent->updateDTransformationMatrix(this->ltDTransformationMatrix, y);
-
-        // Update the displacement vectors
-        this->updateDisplacementVector(this->locDisp, y);
-        this->updateDDisplacementVector(this->locDDisp, y);
-        this->llComponent->updateDisplacementVector(this->llDisp, y);
-        this->llComponent->updateDDisplacementVector(this->llDDisp, y);
-        this->ltComponent->updateDisplacementVector(this->ltDisp, y);
-        this->ltComponent->updateDDisplacementVector(this->ltDDisp, y);
-
-        // Compute the connectors forces
-        errCode = this->computeConnectorsForcesAndMoments();
+        // The kinematics and the connector forces are kept for the other evaluations
+        double f[N_DOF];
+        errCode = this->rhsT(y, this->locKin, this->llKin, this->ltKin,
+                this->connectorsForcesAndMoments, f);
         if (errCode != GSL_SUCCESS){
             return errCode;
         }
-
-        // Compute Gravitational forces and moments
-        gsl_vector* gravitationalForceAndMoment = this->computeGravitationalForceAndMoment();
-
-        // Compute Centrifugal forces and moments
-        gsl_vector* centrifugalForceAndMoment = this->computeCentrifugalForceAndMoment();
-
-
-//        // X
-//        gsl_matrix_set(outRHS, X, 0, locY[XDOT]);
-//
-//        // XDOT
-//        {
-//            double out = ( gsl_vector_get(this->connectorsForcesAndMoments, 0) +
-//                            gsl_vector_get(gravitationalForceAndMoment, 0) +
-//                            gsl_vector_get(centrifugalForceAndMoment, 0)) / this->mass;
-//            gsl_matrix_set(outRHS, XDOT, 0, out);
-//        }
-
-        // Y
-        gsl_matrix_set(outRHS, Y, 0, locY[YDOT]);
-
-        // YDOT
-        {
-            double out = ( gsl_vector_get(this->connectorsForcesAndMoments, 1) +
-                            gsl_vector_get(gravitationalForceAndMoment, 1) +
-                            gsl_vector_get(centrifugalForceAndMoment, 1)) / this->mass;
-            gsl_matrix_set(outRHS, YDOT, 0, out);
-        }
-
-        // Z
-        gsl_matrix_set(outRHS, Z, 0, locY[ZDOT]);
-
-        // ZDOT
-        {
-            double out = ( gsl_vector_get(this->connectorsForcesAndMoments, 2) +
-                            gsl_vector_get(gravitationalForceAndMoment, 2) +
-                            gsl_vector_get(centrifugalForceAndMoment, 2)) / this->mass;
-            gsl_matrix_set(outRHS, ZDOT, 0, out);
-        }
-
-        // PSI
-        gsl_matrix_set(outRHS, PSI, 0, locY[PSIDOT]);
-
-        // PSIDOT
-        {
-            double out = ( gsl_vector_get(this->connectorsForcesAndMoments, 5) +
-                            gsl_vector_get(gravitationalForceAndMoment, 5) +
-                            gsl_vector_get(centrifugalForceAndMoment, 5) ) / this->Iz;
-            gsl_matrix_set(outRHS, PSIDOT, 0, out);
-        }
-
-        // PHI
-        gsl_matrix_set(outRHS, PHI, 0, locY[PHIDOT]);
-
-        // PHIDOT
-        {
-            double out = ( gsl_vector_get(this->connectorsForcesAndMoments, 3) +
-                            gsl_vector_get(gravitationalForceAndMoment, 3) +
-                            gsl_vector_get(centrifugalForceAndMoment, 3) ) / this->Ix;
-            gsl_matrix_set(outRHS, PHIDOT, 0, out);
-        }
-
-        // CHI
-        gsl_matrix_set(outRHS, CHI, 0, locY[CHIDOT]);
-
-        // CHIDOT
-        {
-            double out = ( gsl_vector_get(this->connectorsForcesAndMoments, 4) +
-                            gsl_vector_get(gravitationalForceAndMoment, 4) +
-                            gsl_vector_get(centrifugalForceAndMoment, 4) ) / this->Ix;
-            gsl_matrix_set(outRHS, CHIDOT, 0, out);
-        }
+        for (int i = 0; i < N_DOF; i++)
+            gsl_matrix_set(outRHS, i, 0, f[i]);
 
         return errCode;
     } // End rhs
+
+    int CarBodyComponent::rhs(double t, const ADScalar y[], ADScalar outRHS[]){
+        BodyKinematics<ADScalar> loc, ll, lt;
+        ADScalar connFM[6];
+        return this->rhsT(y, loc, ll, lt, connFM, outRHS);
+    }
+
 }
@@ -0,0 +1,170 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+
+#include "ColoredJacobian.h"
+#include "GeneralModel.h"
+
+#include <gsl/gsl_errno.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace DYTSI_Modelling {
+    ColoredJacobian::ColoredJacobian() {
+        this->scheme = FD_CENTRAL;
+        this->stepType = FD_STEP_ABSOLUTE;
+        this->step = 1e-7;
+        this->nDOF = 0;
+        this->fun_counter = 0;
+    }
+
+    ColoredJacobian::~ColoredJacobian() {
+    }
+
+    /**
+     * Greedy coloring of the columns, starting from the ones involved in more
+     * components. A color collects columns whose sets of dependent components
+     * are disjoint, so the perturbations do not interfere in any row.
+     */
+    void ColoredJacobian::setup(int nDOF, JacobianPattern* pattern){
+        this->nDOF = nDOF;
+        this->colors.clear();
+        this->rowStart.assign(nDOF, std::vector<int>());
+        this->rowSize.assign(nDOF, std::vector<int>());
+
+        // Components depending on every column
+        std::vector< std::vector<int> > rowBlocks(nDOF);
+        for (int b = 0; b < pattern->getNumberOfBlocks(); b++){
+            const std::vector<int>& cols = pattern->getColumns(b);
+            for (unsigned int k = 0; k < cols.size(); k++){
+                rowBlocks[cols[k]].push_back(b);
+                this->rowStart[cols[k]].push_back(pattern->getBlockStart(b));
+                this->rowSize[cols[k]].push_back(pattern->getBlockSize(b));
+            }
+        }
+
+        std::vector< std::pair<int,int> > order;
+        for (int j = 0; j < nDOF; j++)
+            if (rowBlocks[j].size() > 0)
+                order.push_back(std::pair<int,int>(-(int)rowBlocks[j].size(), j));
+        std::sort(order.begin(), order.end());
+
+        // Components already perturbed by every color
+        std::vector< std::vector<bool> > used;
+        for (unsigned int k = 0; k < order.size(); k++){
+            int j = order[k].second;
+            unsigned int c;
+            for (c = 0; c < this->colors.size(); c++){
+                bool free = true;
+                for (unsigned int r = 0; (r < rowBlocks[j].size()) && free; r++)
+                    free = !used[c][rowBlocks[j][r]];
+                if (free) break;
+            }
+            if (c == this->colors.size()){
+                this->colors.push_back(std::vector<int>());
+                used.push_back(std::vector<bool>(pattern->getNumberOfBlocks(), false));
+            }
+            this->colors[c].push_back(j);
+            for (unsigned int r = 0; r < rowBlocks[j].size(); r++)
+                used[c][rowBlocks[j][r]] = true;
+        }
+
+        this->yd.assign(nDOF, 0.0);
+        this->h.assign(nDOF, 0.0);
+        this->f0.assign(nDOF, 0.0);
+        this->fp.assign(nDOF, 0.0);
+        this->fm.assign(nDOF, 0.0);
+    }
+
+    double ColoredJacobian::getStep(double y){
+        if (this->stepType == FD_STEP_RELATIVE)
+            return this->step * std::max(fabs(y), 1.0);
+        return this->step;
+    }
+
+    /**
+     * Approximate the Jacobian of the model in (t,y). Only the entries of the
+     * pattern are written in the row major matrix dfdy (N_DOF x N_DOF), the others
+     * are set to zero.
+     */
+    int ColoredJacobian::compute(GeneralModel* model, double t, const double y[], double* dfdy){
+        int errCode;
+        int n = this->nDOF;
+        memset(dfdy, 0, n * n * sizeof(double));
+
+        if (this->scheme == FD_FORWARD){
+            memcpy(&this->yd[0], y, n * sizeof(double));
+            this->fun_counter++;
+            errCode = model->computeFun(t, &this->yd[0], &this->f0[0]);
+            if (errCode != GSL_SUCCESS)
+                return errCode;
+        }
+
+        for (unsigned int c = 0; c < this->colors.size(); c++){
+            const std::vector<int>& cols = this->colors[c];
+
+            // Positive disturbance (the step is rounded to a representable one)
+            memcpy(&this->yd[0], y, n * sizeof(double));
+            for (unsigned int k = 0; k < cols.size(); k++){
+                int j = cols[k];
+                this->yd[j] = y[j] + this->getStep(y[j]);
+                this->h[j] = this->yd[j] - y[j];
+            }
+            this->fun_counter++;
+            errCode = model->computeFun(t, &this->yd[0], &this->fp[0]);
+            if (errCode != GSL_SUCCESS)
+                return errCode;
+
+            double* fneg = &this->f0[0];
+            if (this->scheme == FD_CENTRAL){
+                // Negative disturbance
+                for (unsigned int k = 0; k < cols.size(); k++){
+                    int j = cols[k];
+                    this->yd[j] = y[j] - this->h[j];
+                    this->h[j] += y[j] - this->yd[j];
+                }
+                this->fun_counter++;
+                errCode = model->computeFun(t, &this->yd[0], &this->fm[0]);
+                if (errCode != GSL_SUCCESS)
+                    return errCode;
+                fneg = &this->fm[0];
+            }
+
+            // Scatter the differences in the rows depending on every column
+            for (unsigned int k = 0; k < cols.size(); k++){
+                int j = cols[k];
+                for (unsigned int r = 0; r < this->rowStart[j].size(); r++){
+                    int start = this->rowStart[j][r];
+                    for (int i = start; i < start + this->rowSize[j][r]; i++)
+                        dfdy[(i*n)+j] = (this->fp[i] - fneg[i]) / this->h[j];
+                }
+            }
+        }
+
+        return GSL_SUCCESS;
+    }
+}
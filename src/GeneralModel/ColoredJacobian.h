@@ -0,0 +1,91 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+
+#ifndef COLOREDJACOBIAN_H
+#define	COLOREDJACOBIAN_H
+
+#include "enumDeclarations.h"
+#include "JacobianPattern.h"
+
+#include <vector>
+
+namespace DYTSI_Modelling {
+    class GeneralModel;
+
+    /**
+     * Finite difference approximation of the Jacobian of a whole model with
+     * grouped columns (Curtis, Powell and Reid). Two columns can be perturbed
+     * together if no component depends on both of them: the columns are colored
+     * accordingly and every color costs one evaluation of GeneralModel::computeFun
+     * (two with central differences).
+     */
+    class ColoredJacobian {
+    public:
+        ColoredJacobian();
+        virtual ~ColoredJacobian();
+
+        // Coloring of the columns of the pattern (see JacobianPattern::addColumn)
+        void setup(int nDOF, JacobianPattern* pattern);
+        int compute(GeneralModel* model, double t, const double y[], double* dfdy);
+        void init(){ fun_counter = 0; }
+
+        int getNumberOfColors(){ return colors.size(); }
+        unsigned long int getFunCounter(){ return fun_counter; }
+
+        // Differences and steps, also used by Component::jac_numerical
+        FDScheme getScheme(){ return scheme; }
+        void setScheme(FDScheme scheme){ this->scheme = scheme; }
+        FDStepType getStepType(){ return stepType; }
+        void setStepType(FDStepType type){ this->stepType = type; }
+        double getStep(){ return step; }
+        void setStep(double step){ this->step = step; }
+        // Perturbation of a variable with value y
+        double getStep(double y);
+
+    private:
+        FDScheme scheme;
+        FDStepType stepType;
+        double step;
+
+        int nDOF;
+        // Columns of every color
+        std::vector< std::vector<int> > colors;
+        // Rows (start,size of the blocks) depending on every column
+        std::vector< std::vector<int> > rowStart;
+        std::vector< std::vector<int> > rowSize;
+
+        // Workspace
+        std::vector<double> yd;
+        std::vector<double> h;
+        std::vector<double> f0;
+        std::vector<double> fp;
+        std::vector<double> fm;
+
+        unsigned long int fun_counter;
+    };
+}
+
+#endif	/* COLOREDJACOBIAN_H */
@@ -36,14 +36,18 @@
 #include "Connector.h"
 #include "GeneralModel.h"
 #include "ExternalComponents.h"
+#include "ModelArena.h"
+
+#include "../Application/PrintingHandler.h"
 
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_matrix.h>
-#include <gsl/gsl_blas.h>
+#include <gsl/gsl_errno.h>
 
 #include <math.h>
 #include <string.h>
 #include <sstream>
+#include <algorithm>
 
 namespace DYTSI_Modelling {
     Component::Component(std::string name, GeneralModel* gm,
@@ -64,16 +68,21 @@ namespace DYTSI_Modelling {
         this->isFixed = isFixed;
 
         // Compute the position of the center of mass wrt the center of the track following reference system
-        this->centerOfMass = gsl_vector_alloc(3);
-        gsl_vector_memcpy(this->centerOfMass, this->centerOfMassWRTCenterOfGeometry);
-        gsl_blas_daxpy(1.0, this->centerOfGeometry, this->centerOfMass);
-
-        this->connectorsForcesAndMoments = gsl_vector_alloc(6);
-        vecForceAndMomentum = gsl_vector_calloc(6);
+        for (int i = 0; i < 3; i++)
+            this->centerOfMass[i] = gsl_vector_get(this->centerOfMassWRTCenterOfGeometry, i) +
+                    gsl_vector_get(this->centerOfGeometry, i);
+
+        for (int i = 0; i < 6; i++)
+            this->connectorsForcesAndMoments[i] = 0.0;
+
+        this->wsY = NULL;
+        this->wsFPos = NULL;
+        this->wsFNeg = NULL;
+        this->wsAdY = NULL;
+        this->wsAdF = NULL;
     }
 
     Component::~Component() {
-        gsl_vector_free(this->getCenterOfMass());
     }
 
     int Component::generateID(){
@@ -103,7 +112,7 @@ namespace DYTSI_Modelling {
         return this->startingDOF;
     }
 
-    gsl_vector* Component::getCenterOfMass(){
+    const Vec3<double>& Component::getCenterOfMass(){
         return this->centerOfMass;
     }
 
@@ -113,10 +122,10 @@ namespace DYTSI_Modelling {
      * @param position
      * @return
      */
-    gsl_vector* Component::getPositionWRTCenterOfMass(gsl_vector* position){
-        gsl_vector* out = gsl_vector_alloc(3);
-        gsl_vector_memcpy(out, position);
-        gsl_blas_daxpy(-1.0, this->getCenterOfMassWRTCenterOfGeometry(), out);
+    Vec3<double> Component::getPositionWRTCenterOfMass(gsl_vector* position){
+        Vec3<double> out;
+        for (int i = 0; i < 3; i++)
+            out[i] = gsl_vector_get(position, i) - gsl_vector_get(this->centerOfMassWRTCenterOfGeometry, i);
         return out;
     }
 
@@ -176,28 +185,26 @@ namespace DYTSI_Modelling {
         return outStr;
     }
 
+    std::string Component::get_baseName(){
+        return this->name;
+    }
+
     ExternalComponents* Component::getExternalComponents(){ return this->externalComponents; }
     void Component::setExternalComponents(ExternalComponents* extComp) {
         this->externalComponents = extComp;
     }
 
     // Compute gravitational force and moment
-    gsl_vector* Component::computeGravitationalForceAndMoment( ){
-
-        gsl_vector_view F_view = gsl_vector_subvector( vecForceAndMomentum, 0, 3);
-        gsl_vector* F = &F_view.vector;
-
-        gsl_vector_view M_view = gsl_vector_subvector( vecForceAndMomentum, 3, 3);
-        gsl_vector* M = &M_view.vector;
-
+    void Component::computeGravitationalForceAndMoment( double forceAndMoment[6] ){
         double sin_Phi_se = this->getExternalComponents()->get_sin_Phi_se();
         double cos_Phi_se = this->getExternalComponents()->get_cos_Phi_se();
 
-        // Compute the force
-        gsl_vector_set( F,1, - sin_Phi_se * this->get_mass() * g );
-        gsl_vector_set( F,2, - cos_Phi_se * this->get_mass() * g );
-
-        return vecForceAndMomentum;
+        // Compute the force (no moment about the center of mass)
+        forceAndMoment[0] = 0.0;
+        forceAndMoment[1] = - sin_Phi_se * this->get_mass() * g;
+        forceAndMoment[2] = - cos_Phi_se * this->get_mass() * g;
+        for (int i = 3; i < 6; i++)
+            forceAndMoment[i] = 0.0;
     }
 
 //    // Compute centrifugal force and moment
@@ -223,131 +230,263 @@ namespace DYTSI_Modelling {
 
     int Component::fun(double t, double y[], double f[]){
 
-    	int errCode = GSL_SUCCESS;
-
-    	// Compute the lower leading component (if any)
-		if (this->getLowerLeading() != NULL){
-			errCode = this->getLowerLeading()->getComponent()->fun(t, y, f);
-			if (errCode != GSL_SUCCESS){
-				return errCode;
-			}
-		}
-
-		// Compute the lower trailing component (if any)
-		if (this->getLowerTrailing() != NULL){
-			errCode = this->getLowerTrailing()->getComponent()->fun(t, y, f);
-			if (errCode != GSL_SUCCESS){
-				return errCode;
-			}
-		}
-
-    	if (this->isFixed){
-
-    		// Retreive the corresponding data in dfdt
-			double *loc_f = &(f[this->get_startingDOF()]);
-			// Derivatives w.r.t time
-			for( int i = 0; i < this->get_N_DOF(); i++ ){
-				loc_f[i] = .0;
-			}
-
-    		return errCode;
-    	} else {
-    		return this->computeFun(t, y, f);
-    	}
+        // Compute the lower components (if any)
+        int errCode = this->lowerFun(t, y, f);
+        if (errCode != GSL_SUCCESS){
+            return errCode;
+        }
+
+        if (this->isFixed){
+
+            // Retreive the corresponding data in dfdt
+            double *loc_f = &(f[this->get_startingDOF()]);
+            // Derivatives w.r.t time
+            for( int i = 0; i < this->get_N_DOF(); i++ ){
+                loc_f[i] = .0;
+            }
+
+            return errCode;
+        } else {
+            return this->computeFun(t, y, f);
+        }
 
     }
 
     int Component::jac(double t, double * y, double * dfdy, double * dfdt){
 
-    	if (this->isFixed){
-
-    		int errCode = GSL_SUCCESS;
-
-			// Compute the lower leading component (if any)
-			if (this->getLowerLeading() != NULL){
-				errCode = this->getLowerLeading()->getComponent()->jac(t, y, dfdy, dfdt);
-				if (errCode != GSL_SUCCESS){
-					return errCode;
-				}
-			}
-
-			// Compute the lower trailing component (if any)
-			if (this->getLowerTrailing() != NULL){
-				errCode = this->getLowerTrailing()->getComponent()->jac(t, y, dfdy, dfdt);
-				if (errCode != GSL_SUCCESS){
-					return errCode;
-				}
-			}
-
-    		// Retreive the submatrix relative to the CarBody equations.
-			int N_VAR = this->get_generalModel()->get_N_DOF();
-			gsl_matrix_view dfdy_mat = gsl_matrix_view_array (dfdy,N_VAR,N_VAR);
-			//gsl_matrix *MAT = &dfdy_mat.matrix;
-			gsl_matrix_view sub_dfdy = gsl_matrix_submatrix(
-					&dfdy_mat.matrix, this->get_startingDOF(), 0, this->get_N_DOF(), N_VAR);
-
-			gsl_matrix_set_zero(&sub_dfdy.matrix);
-
-	        // Retreive the corresponding data in dfdt
-	        double *loc_dfdt = &(dfdt[this->get_startingDOF()]);
-	        // Derivatives w.r.t time
-	        for( int i = 0; i < this->get_N_DOF(); i++ ){
-	            loc_dfdt[i] = .0;
-	        }
-
-			return errCode;
-    	} else {
-    		return this->computeJac(t, y, dfdy, dfdt);
-    	}
+        // Compute the lower components (if any)
+        int errCode = this->lowerJac(t, y, dfdy, dfdt);
+        if (errCode != GSL_SUCCESS){
+            return errCode;
+        }
+
+        if (this->isFixed){
+
+            // Retreive the submatrix relative to the CarBody equations.
+            int N_VAR = this->get_generalModel()->get_N_DOF();
+            gsl_matrix_view dfdy_mat = gsl_matrix_view_array (dfdy,N_VAR,N_VAR);
+            //gsl_matrix *MAT = &dfdy_mat.matrix;
+            gsl_matrix_view sub_dfdy = gsl_matrix_submatrix(
+                    &dfdy_mat.matrix, this->get_startingDOF(), 0, this->get_N_DOF(), N_VAR);
+
+            gsl_matrix_set_zero(&sub_dfdy.matrix);
+
+            // Retreive the corresponding data in dfdt
+            double *loc_dfdt = &(dfdt[this->get_startingDOF()]);
+            // Derivatives w.r.t time
+            for( int i = 0; i < this->get_N_DOF(); i++ ){
+                loc_dfdt[i] = .0;
+            }
+
+            return errCode;
+        } else {
+            return this->computeJac(t, y, dfdy, dfdt);
+        }
 
     }
 
-    int Component::jac_numerical(double t, const double y[], gsl_matrix *J, int var){
+    /**
+     * Evaluate the function of the lower leading and lower trailing components.
+     * In THREADS mode the lower leading subtree is forked on the worker pool of
+     * the model while the lower trailing subtree is evaluated by the calling thread.
+     * The two subtrees write disjoint rows of f and share no connector.
+     */
+    int Component::lowerFun(double t, double y[], double f[]){
         int errCode = GSL_SUCCESS;
 
-        // Copy the array y to a temporary array used for Jacobian approximation
-        double* yd = new double[this->get_generalModel()->get_N_DOF()];
-        memcpy(yd,y,(this->get_generalModel()->get_N_DOF())*sizeof(double));
+        WorkerPool* pool = this->get_generalModel()->getWorkerPool();
+        if ((pool != NULL) && (this->getLowerLeading() != NULL) && (this->getLowerTrailing() != NULL)){
+            // Pack the input
+            FunInput funInput = {t, y, f};
+            ExecInput llexecInput = {FUN, &funInput, GSL_SUCCESS};
 
-        gsl_matrix* fy_pos = gsl_matrix_calloc(this->get_N_DOF(),1);
-        gsl_matrix* fy_neg = gsl_matrix_calloc(this->get_N_DOF(),1);
+            WorkerPool::TaskGroup group;
+            pool->fork(group, this->getLowerLeading()->getComponent(), &llexecInput);
+            errCode = this->getLowerTrailing()->getComponent()->fun(t, y, f);
+            pool->join(group);
 
-//        // Set delta 1e-2 times smaller than the value or 1e-8 maximum
-//        double delta = yd[var] * 1e-2;
-//        if (delta < 1e-8)
-//            delta = 1e-8;
-        double delta = 1e-7;
-
-        // Compute the rhs with positive disturbance
-        yd[var] += delta;
-        errCode = this->rhs(t, yd, fy_pos);
-        if (errCode != GSL_SUCCESS)
+            // Check for errors
+            if (llexecInput.returnCode != GSL_SUCCESS)
+                return llexecInput.returnCode;
             return errCode;
-        yd[var] -= delta;
+        }
+
+        // Compute the lower leading component (if any)
+        if (this->getLowerLeading() != NULL){
+            errCode = this->getLowerLeading()->getComponent()->fun(t, y, f);
+            if (errCode != GSL_SUCCESS){
+                return errCode;
+            }
+        }
+
+        // Compute the lower trailing component (if any)
+        if (this->getLowerTrailing() != NULL){
+            errCode = this->getLowerTrailing()->getComponent()->fun(t, y, f);
+            if (errCode != GSL_SUCCESS){
+                return errCode;
+            }
+        }
+
+        return errCode;
+    }
 
-        // Compute the rhs with negative disturbance
-        yd[var] -= delta;
-        errCode = this->rhs(t, yd, fy_neg);
-        if (errCode != GSL_SUCCESS)
+    /**
+     * Evaluate the jacobian of the lower leading and lower trailing components.
+     * See lowerFun for the THREADS mode.
+     */
+    int Component::lowerJac(double t, double y[], double* dfdy, double dfdt[]){
+        int errCode = GSL_SUCCESS;
+
+        WorkerPool* pool = this->get_generalModel()->getWorkerPool();
+        if ((pool != NULL) && (this->getLowerLeading() != NULL) && (this->getLowerTrailing() != NULL)){
+            // Pack the input
+            JacInput jacInput = {t, y, dfdy, dfdt};
+            ExecInput llexecInput = {JAC, &jacInput, GSL_SUCCESS};
+
+            WorkerPool::TaskGroup group;
+            pool->fork(group, this->getLowerLeading()->getComponent(), &llexecInput);
+            errCode = this->getLowerTrailing()->getComponent()->jac(t, y, dfdy, dfdt);
+            pool->join(group);
+
+            // Check for errors
+            if (llexecInput.returnCode != GSL_SUCCESS)
+                return llexecInput.returnCode;
             return errCode;
-        yd[var] += delta;
+        }
+
+        // Compute the lower leading component (if any)
+        if (this->getLowerLeading() != NULL){
+            errCode = this->getLowerLeading()->getComponent()->jac(t, y, dfdy, dfdt);
+            if (errCode != GSL_SUCCESS){
+                return errCode;
+            }
+        }
 
-        // Compute the central approximation of the derivative and set it up in the
-        // Jacobian matrix.
-        //gsl_matrix_view Jvar_view = gsl_matrix_submatrix(J, 0, var, this->get_N_DOF(), 1);
-        //gsl_matrix* Jvar = &Jvar_view.matrix;
-        for (int i = 0; i < this->get_N_DOF(); i++)
-            gsl_matrix_set(J, i, var,
-                    (gsl_matrix_get(fy_pos, i, 0)-gsl_matrix_get(fy_neg, i, 0)) /(2.0*delta));
+        // Compute the lower trailing component (if any)
+        if (this->getLowerTrailing() != NULL){
+            errCode = this->getLowerTrailing()->getComponent()->jac(t, y, dfdy, dfdt);
+            if (errCode != GSL_SUCCESS){
+                return errCode;
+            }
+        }
 
-        // Free memory
-        gsl_matrix_free(fy_pos);
-        gsl_matrix_free(fy_neg);
-        delete []yd;
+        return errCode;
+    }
+
+    void Component::setupWorkspace(ModelArena* arena){
+        int N_VAR = this->get_generalModel()->get_N_DOF();
+        this->wsY = arena->allocate<double>(N_VAR);
+        this->wsFPos = arena->allocate<double>(this->get_N_DOF());
+        this->wsFNeg = arena->allocate<double>(this->get_N_DOF());
+        this->wsAdY = arena->allocate<ADScalar>(N_VAR);
+        this->wsAdF = arena->allocate<ADScalar>(this->get_N_DOF());
+    }
+
+    /**
+     * Approximates the columns partialJacobianIdx of the component equations by
+     * finite differences, with the scheme and steps of the model (see ColoredJacobian).
+     * The forward scheme shares the unperturbed evaluation among the columns.
+     */
+    int Component::jac_numerical(double t, const double y[], gsl_matrix *J){
+        int errCode = GSL_SUCCESS;
+        ColoredJacobian* fd = this->get_generalModel()->getColoredJacobian();
+        bool central = (fd->getScheme() == FD_CENTRAL);
+
+        // Copy the array y to the workspace used for Jacobian approximation
+        double* yd = this->wsY;
+        memcpy(yd,y,(this->get_generalModel()->get_N_DOF())*sizeof(double));
+
+        gsl_matrix_view fy_pos_view = gsl_matrix_view_array(this->wsFPos, this->get_N_DOF(), 1);
+        gsl_matrix_view fy_neg_view = gsl_matrix_view_array(this->wsFNeg, this->get_N_DOF(), 1);
+        gsl_matrix* fy_pos = &fy_pos_view.matrix;
+        gsl_matrix* fy_neg = &fy_neg_view.matrix;
+
+        // Forward differences: the rhs without disturbance
+        if (!central){
+            errCode = this->rhs(t, yd, fy_neg);
+            if (errCode != GSL_SUCCESS)
+                return errCode;
+        }
+
+        for( std::vector<int>::iterator iter = this->partialJacobianIdx.begin();
+                iter != this->partialJacobianIdx.end(); ++iter){
+            int var = *iter;
+            double delta = fd->getStep(yd[var]);
+            delta = (yd[var] + delta) - yd[var];
+
+            // Compute the rhs with positive disturbance
+            yd[var] = y[var] + delta;
+            errCode = this->rhs(t, yd, fy_pos);
+            yd[var] = y[var];
+            if (errCode != GSL_SUCCESS)
+                return errCode;
+
+            // Compute the rhs with negative disturbance
+            if (central){
+                yd[var] = y[var] - delta;
+                errCode = this->rhs(t, yd, fy_neg);
+                yd[var] = y[var];
+                if (errCode != GSL_SUCCESS)
+                    return errCode;
+            }
+
+            // Set the approximation of the derivative in the Jacobian matrix
+            double den = central ? 2.0*delta : delta;
+            for (int i = 0; i < this->get_N_DOF(); i++)
+                gsl_matrix_set(J, i, var,
+                        (gsl_matrix_get(fy_pos, i, 0)-gsl_matrix_get(fy_neg, i, 0)) / den);
+        }
 
         return GSL_SUCCESS;
     }
 
+    /**
+     * Right hand side on dual numbers, not available by default: jac_ad falls back
+     * to jac_numerical for the components that do not implement it.
+     */
+    int Component::rhs(double t, const ADScalar y[], ADScalar outRHS[]){
+        return GSL_EUNIMPL;
+    }
+
+    /**
+     * Computes the columns partialJacobianIdx of the component equations seeding
+     * AD_WIDTH of them at a time in the dual numbers passed to rhs (by finite
+     * differences if the component has no rhs on dual numbers).
+     */
+    int Component::jac_ad(double t, const double y[], gsl_matrix *J){
+        int errCode = GSL_SUCCESS;
+        int N_VAR = this->get_generalModel()->get_N_DOF();
+
+        ADScalar* adY = this->wsAdY;
+        for (int i = 0; i < N_VAR; i++)
+            adY[i] = y[i];
+        ADScalar* adF = this->wsAdF;
+
+        int nIdx = this->partialJacobianIdx.size();
+        for (int first = 0; first < nIdx; first += AD_WIDTH){
+            int width = std::min(AD_WIDTH, nIdx - first);
+
+            // Seed the columns of the sweep
+            for (int k = 0; k < width; k++)
+                adY[this->partialJacobianIdx[first+k]].setDerivative(k, 1.0);
+
+            errCode = this->rhs(t, adY, adF);
+            if (errCode == GSL_EUNIMPL)
+                return this->jac_numerical(t, y, J);
+            if (errCode != GSL_SUCCESS)
+                return errCode;
+
+            for (int k = 0; k < width; k++){
+                int var = this->partialJacobianIdx[first+k];
+                for (int i = 0; i < this->get_N_DOF(); i++)
+                    gsl_matrix_set(J, i, var, adF[i].derivative(k));
+                adY[var].setDerivative(k, 0.0);
+            }
+        }
+
+        return errCode;
+    }
+
     void Component::Execute(void* args){
         ExecInput* execInput = (ExecInput*) args;
 
@@ -356,13 +495,13 @@ namespace DYTSI_Modelling {
         switch (execInput->type) {
             case FUN:
                 funInput = (FunInput*)execInput->input;
-                execInput->returnCode = this->computeFun(
+                execInput->returnCode = this->fun(
                         funInput->t, funInput->y, funInput->f);
                 break;
 
             case JAC:
                 jacInput = (JacInput*)execInput->input;
-                execInput->returnCode = this->computeJac(
+                execInput->returnCode = this->jac(
                         jacInput->t, jacInput->y, jacInput->dfdy, jacInput->dfdt);
                 break;
         }
@@ -35,8 +35,9 @@
 #define	COMPONENT_H
 
 #include "enumDeclarations.h"
+#include "Link.h"
 
-#include "Thread.h"
+#include "WorkerPool.h"
 
 #include <memory>
 #include <stdio.h>
@@ -55,10 +56,11 @@ namespace DYTSI_Modelling {
     class Connector;
     class ComponentConnectorCouple;
     class GeneralModel;
+    class ModelArena;
 
     const double g = 9.81;
 
-    class Component : public Thread {
+    class Component : public Task {
     public:
 
         Component(std::string name, GeneralModel* gm,
@@ -80,8 +82,8 @@ namespace DYTSI_Modelling {
         int getID();
         int generateID();
 
-        gsl_vector* getCenterOfMass();
-        gsl_vector* getPositionWRTCenterOfMass(gsl_vector* position);
+        const Vec3<double>& getCenterOfMass();
+        Vec3<double> getPositionWRTCenterOfMass(gsl_vector* position);
         gsl_vector* getCenterOfMassWRTCenterOfGeometry();
         gsl_vector* getCenterOfGeometry();
 
@@ -96,8 +98,15 @@ namespace DYTSI_Modelling {
                 RelativeComponentPosition position);
         void setDOF( GeneralModel* gm );
 
+        // Indices of the variables the equations of the component depend on
+        const std::vector<int>& getPartialJacobianIdx(){ return partialJacobianIdx; }
+
+        // Take the scratch memory of the evaluations from the arena of the model
+        // (called once the DOFs and partialJacobianIdx are known)
+        virtual void setupWorkspace(ModelArena* arena);
+
         // Compute gravitational force and moment
-        gsl_vector* computeGravitationalForceAndMoment( );
+        void computeGravitationalForceAndMoment( double forceAndMoment[6] );
 
         // Function and Jacobian public handler (these take care of the case in which
         // the component is fixed)
@@ -105,15 +114,6 @@ namespace DYTSI_Modelling {
         int jac(double t, double y[], double* dfdy, double dfdt[]);
 
         // Virtual methods
-        virtual void updateTransformationMatrix( gsl_matrix* mat, double y[] ) = 0;
-        virtual void updateDTransformationMatrix( gsl_matrix* mat, double y[] ) = 0;
-        virtual void updateDisplacementVector( gsl_vector* vec, double y[] ) = 0;
-        virtual void updateDDisplacementVector( gsl_vector* vec, double y[] ) = 0;
-        virtual void updateTransformationMatrix( gsl_matrix* mat, const double y[] ) = 0;
-        virtual void updateDTransformationMatrix( gsl_matrix* mat, const double y[] ) = 0;
-        virtual void updateDisplacementVector( gsl_vector* vec, const double y[] ) = 0;
-        virtual void updateDDisplacementVector( gsl_vector* vec, const double y[] ) = 0;
-
         virtual int get_N_DOF() = 0;
         virtual double get_mass() = 0;
 
@@ -123,6 +123,10 @@ namespace DYTSI_Modelling {
         virtual const double* getCurrentY() = 0;
         virtual void init() = 0;
         virtual std::string printCounters() = 0;
+
+        // Copy of the component belonging to the model gm. The geometry is shared with the
+        // original, the connections are not copied.
+        virtual Component* clone(GeneralModel* gm, ExternalComponents* externalComponents) = 0;
         
     private:
         int id_component;
@@ -140,16 +144,15 @@ namespace DYTSI_Modelling {
         std::string name;
         GeneralModel *generalModel;
 
-        gsl_vector* centerOfMass;
+        Vec3<double> centerOfMass;
         gsl_vector* centerOfMassWRTCenterOfGeometry;
         gsl_vector* centerOfGeometry;
 
-        gsl_vector* vecForceAndMomentum;
-
         ExternalComponents* externalComponents;
 
     protected:
         GeneralModel* get_generalModel();
+        std::string get_baseName();
         unsigned long int rhs_counter;
         
         // Indices of the variable for partial derivatives in the Jacobian
@@ -157,18 +160,35 @@ namespace DYTSI_Modelling {
 
         // Vector that contains the sum of all the forces and moments caused by a connector
         // at a certain time with certain displacements
-        gsl_vector* connectorsForcesAndMoments;
+        double connectorsForcesAndMoments[6];
+
+        // Workspace of jac_numerical and jac_ad (see setupWorkspace). A component is
+        // evaluated by one thread at a time, so the workspace is not shared.
+        double* wsY;
+        double* wsFPos;
+        double* wsFNeg;
+        ADScalar* wsAdY;
+        ADScalar* wsAdF;
 
-        int jac_numerical(double t, const double y[], gsl_matrix *J, int var);
+        // Jacobian columns partialJacobianIdx by finite differences
+        int jac_numerical(double t, const double y[], gsl_matrix *J);
+        // Jacobian columns partialJacobianIdx by forward automatic differentiation
+        int jac_ad(double t, const double y[], gsl_matrix *J);
 
         // Virtual Methods
         virtual int computeFun( double t, double y[], double f[] ) = 0;
         virtual int computeJac( double t, double y[], double* dfdy, double dfdt[] ) = 0;
-        virtual gsl_vector* computeCentrifugalForceAndMoment( ) = 0;
+        virtual void computeCentrifugalForceAndMoment( double forceAndMoment[6] ) = 0;
         virtual int computeConnectorsForcesAndMoments() = 0;
         virtual int rhs(double t, const double y[], gsl_matrix* outRHS) = 0;
+        // Right hand side on dual numbers (used by jac_ad, GSL_EUNIMPL if not implemented)
+        virtual int rhs(double t, const ADScalar y[], ADScalar outRHS[]);
+
+        // Evaluation of the lower components (forked on the model's worker pool in THREADS mode)
+        int lowerFun(double t, double y[], double f[]);
+        int lowerJac(double t, double y[], double* dfdy, double dfdt[]);
 
-        // Implementation of virtual Thread methods
+        // Implementation of virtual Task methods
         void Execute(void*);
 
     };
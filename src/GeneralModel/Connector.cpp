@@ -37,8 +37,7 @@
 
 #include "../Application/PrintingHandler.h"
 
-#include <gsl/gsl_vector.h>
-#include <gsl/gsl_blas.h>
+#include <gsl/gsl_errno.h>
 
 #include <cmath>
 #include <sstream>
@@ -73,12 +72,6 @@ namespace DYTSI_Modelling {
             PrintingHandler::printOut(&out, PrintingHandler::STDERR);
             exit(-1);
         }
-
-        this->rMain = gsl_vector_alloc(3);
-        this->rAttached = gsl_vector_alloc(3);
-        this->drMain = gsl_vector_alloc(3);
-        this->drAttached = gsl_vector_alloc(3);
-        this->totForceAndMomentum = gsl_vector_calloc(6);
     }
 
     Connector::~Connector() {
@@ -94,29 +87,19 @@ namespace DYTSI_Modelling {
     }
 
     /**
-     * Return the vector of forces and moments (3 directional forces and 3 moments) using the
-     * displacements vectors given as arguments
-     * @param mainComponent
-     * @param attachedComponent
-     * @param dispMain
-     * @param dispAttached
-     * @param ddispMain
-     * @param ddispAttached
-     * @param transformationMatrixMain
-     * @param transformationMatrixAttached
-     * @param dTransformationMatrixMain
-     * @param dTransformationMatrixAttached
-     * @return
+     * Return the vector of forces and moments (3 directional forces and 3 moments) on the
+     * main component, given the kinematics of the displacements of the main and of the
+     * attached component.
      */
-    gsl_vector* Connector::getForcesAndMoments( RelativeComponentPosition posConnector,
-            gsl_vector* dispMain, gsl_vector* dispAttached,
-            gsl_vector* ddispMain, gsl_vector* ddispAttached,
-            gsl_matrix* transformationMatrixMain, gsl_matrix* transformationMatrixAttached,
-            gsl_matrix* dTransformationMatrixMain, gsl_matrix* dTransformationMatrixAttached,
-            int& errCode){
+    template<class T>
+    int Connector::getForcesAndMoments( RelativeComponentPosition posConnector,
+            const BodyKinematics<T>& main, const BodyKinematics<T>& attached,
+            T forceAndMoments[6]){
+        int errCode = GSL_SUCCESS;
         std::stringstream* out;
 
-        gsl_vector_set_zero(this->totForceAndMomentum);
+        for (int i = 0; i < 6; i++)
+            forceAndMoments[i] = 0.0;
 
         // Check for the position of the mainComponent
         Component* mainComponent;
@@ -137,35 +120,28 @@ namespace DYTSI_Modelling {
         }
 
         /////////
-        // Compute the displaced position of the main C.M.
-        gsl_vector_memcpy(rMain, dispMain);
-        gsl_blas_daxpy(1.0,mainComponent->getCenterOfMass(), rMain);
-        // Compute the displaced position of the attached C.M.
-        gsl_vector_memcpy(rAttached, dispAttached);
-        gsl_blas_daxpy(1.0,attachedComponent->getCenterOfMass(), rAttached);
-        /////////
-
-        /////////
-        // Compute the speed vector of the main C.M.
-        gsl_vector_memcpy(drMain, ddispMain);
-        // Compute the speed vector of the attached C.M.
-        gsl_vector_memcpy(drAttached, ddispAttached);
+        // Compute the displaced positions of the main and of the attached C.M.
+        // (the speed vectors are the ones of the displacements)
+        BodyKinematics<T> mainCM = main;
+        BodyKinematics<T> attachedCM = attached;
+        for (int i = 0; i < 3; i++){
+            mainCM.r[i] += mainComponent->getCenterOfMass()[i];
+            attachedCM.r[i] += attachedComponent->getCenterOfMass()[i];
+        }
         /////////
 
         /////////
         // Iterate over the links
-        gsl_vector* FMvec;
+        T FMvec[6];
         for (std::vector<Link*>::iterator it = this->linkList.begin();
                 it != this->linkList.end(); ++it){
             Link* link = *it;
 
-            FMvec = link->computeForceAndMoments( posConnector, rMain, rAttached,
-                    drMain, drAttached, transformationMatrixMain, transformationMatrixAttached,
-                    dTransformationMatrixMain, dTransformationMatrixAttached, errCode);
+            errCode = link->computeForceAndMoments( posConnector, mainCM, attachedCM, FMvec);
 
             // Check for NaN values
             for( int i = 0; i < 6; i++ ){
-                if ( isnan( gsl_vector_get(FMvec,i) ) ){
+                if ( std::isnan( valueOf(FMvec[i]) ) ){
                     errCode = GSL_EDOM;
                     const double* mainCurrY = mainComponent->getCurrentY();
                     const double* attachedCurrY = attachedComponent->getCurrentY();
@@ -182,15 +158,23 @@ namespace DYTSI_Modelling {
                     *out << std::endl;
                     PrintingHandler::printOut(out, PrintingHandler::STDERR);
                     delete out;
-                    return totForceAndMomentum;
+                    return errCode;
                 }
             }
 
-            gsl_blas_daxpy(1.0, FMvec, totForceAndMomentum);
+            for (int i = 0; i < 6; i++)
+                forceAndMoments[i] += FMvec[i];
 
         }
         // End iterate links
 
-        return totForceAndMomentum;
+        return errCode;
     }
+
+    template int Connector::getForcesAndMoments<double>( RelativeComponentPosition posConnector,
+            const BodyKinematics<double>& main, const BodyKinematics<double>& attached,
+            double forceAndMoments[6]);
+    template int Connector::getForcesAndMoments<ADScalar>( RelativeComponentPosition posConnector,
+            const BodyKinematics<ADScalar>& main, const BodyKinematics<ADScalar>& attached,
+            ADScalar forceAndMoments[6]);
 }
@@ -35,17 +35,14 @@
 #define	CONNECTOR_H
 
 #include "enumDeclarations.h"
+#include "Link.h"
 
 #include <memory>
 #include <vector>
 #include <string>
 
-#include <gsl/gsl_vector.h>
-#include <gsl/gsl_matrix.h>
-
 namespace DYTSI_Modelling {
     class Component;
-    class Link;
 
     class Connector {
     public:
@@ -63,12 +60,16 @@ namespace DYTSI_Modelling {
 
         std::string getName(){ return this->name; }
 
-        gsl_vector* getForcesAndMoments( RelativeComponentPosition posConnector,
-            gsl_vector* dispMain, gsl_vector* dispAttached,
-            gsl_vector* ddispMain, gsl_vector* ddispAttached,
-            gsl_matrix* transformationMatrixMain, gsl_matrix* transformationMatrixAttached,
-            gsl_matrix* dTransformationMatrixMain, gsl_matrix* dTransformationMatrixAttached,
-            int& errCode);
+        // Forces and moments on the main component, for any scalar type (instantiated
+        // for double and ADScalar). The positions r are the displacements of the centers of mass.
+        template<class T>
+        int getForcesAndMoments( RelativeComponentPosition posConnector,
+            const BodyKinematics<T>& main, const BodyKinematics<T>& attached,
+            T forceAndMoments[6]);
+
+        // Copy of the connector between the components upper and lower (without links)
+        virtual Connector* clone(Component* upper, Component* lower,
+                RelativeComponentPosition posLower) = 0;
 
     private:
         std::string name;
@@ -76,12 +77,6 @@ namespace DYTSI_Modelling {
         Component* upperComponent;
         Component* lowerComponent;
 
-        gsl_vector* rMain;
-        gsl_vector* rAttached;
-        gsl_vector* drMain;
-        gsl_vector* drAttached;
-        gsl_vector* totForceAndMomentum;
-
     protected:
         std::vector<Link*> linkList;
         
@@ -0,0 +1,151 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+
+#include "ContactKernel.h"
+
+#include <math.h>
+
+namespace DYTSI_Modelling {
+    ContactKernel::ContactKernel() {
+        for (int f = 0; f < CK_N_FIELDS; f++)
+            this->fields[f] = NULL;
+        this->nContacts = 0;
+        this->maxContacts = 0;
+    }
+
+    ContactKernel::~ContactKernel() {
+    }
+
+    void ContactKernel::setup(ModelArena* arena, int maxContacts){
+        for (int f = 0; f < CK_N_FIELDS; f++)
+            this->fields[f] = arena->allocate<double>(maxContacts);
+        this->nContacts = 0;
+        this->maxContacts = maxContacts;
+    }
+
+    void ContactKernel::evaluate(){
+        const int n = this->nContacts;
+        const double* __restrict__ side = this->fields[CK_SIDE];
+        const double* __restrict__ V = this->fields[CK_V];
+        const double* __restrict__ yaw = this->fields[CK_YAW];
+        const double* __restrict__ cant = this->fields[CK_CANT];
+        const double* __restrict__ spin = this->fields[CK_SPIN];
+        const double* __restrict__ psi = this->fields[CK_PSI];
+        const double* __restrict__ psidot = this->fields[CK_PSIDOT];
+        const double* __restrict__ phi = this->fields[CK_PHI];
+        const double* __restrict__ phidot = this->fields[CK_PHIDOT];
+        const double* __restrict__ ydot = this->fields[CK_YDOT];
+        const double* __restrict__ zdot = this->fields[CK_ZDOT];
+        const double* __restrict__ radius = this->fields[CK_RADIUS];
+        const double* __restrict__ aw = this->fields[CK_AW];
+        const double* __restrict__ delta = this->fields[CK_DELTA];
+        const double* __restrict__ N = this->fields[CK_N];
+        const double* __restrict__ cpA = this->fields[CK_A];
+        const double* __restrict__ cpB = this->fields[CK_B];
+        const double* __restrict__ C11 = this->fields[CK_C11];
+        const double* __restrict__ C22 = this->fields[CK_C22];
+        const double* __restrict__ C23 = this->fields[CK_C23];
+        const double* __restrict__ G = this->fields[CK_G];
+        const double* __restrict__ mu = this->fields[CK_MU];
+        double* __restrict__ fx = this->fields[CK_FX];
+        double* __restrict__ fy = this->fields[CK_FY];
+        double* __restrict__ fz = this->fields[CK_FZ];
+        double* __restrict__ ny = this->fields[CK_NY];
+        double* __restrict__ nz = this->fields[CK_NZ];
+        double* __restrict__ tphi = this->fields[CK_TPHI];
+        double* __restrict__ tchi = this->fields[CK_TCHI];
+        double* __restrict__ tpsi = this->fields[CK_TPSI];
+        double* __restrict__ cosd = this->fields[CK_COSD];
+        double* __restrict__ sind = this->fields[CK_SIND];
+        double* __restrict__ cosa = this->fields[CK_COSA];
+        double* __restrict__ sina = this->fields[CK_SINA];
+        double* __restrict__ sqrtab = this->fields[CK_SQRTAB];
+        double* __restrict__ norm = this->fields[CK_NORM];
+
+        // Square roots and trigonometric functions (calls to libm, which set errno and
+        // keep the loops that contain them from being vectorized)
+        for (int i = 0; i < n; i++){
+            double angle = delta[i] + side[i]*phi[i];
+            cosd[i] = cos(delta[i]);
+            sind[i] = sin(delta[i]);
+            cosa[i] = cos(angle);
+            sina[i] = sin(angle);
+            sqrtab[i] = sqrt(cpA[i]*cpB[i]);
+        }
+
+        // Creepages and Kalker's linear creep forces (stored in fx, fy).
+        // The fields do not overlap (see setup)
+#pragma GCC ivdep
+        for (int i = 0; i < n; i++){
+            double s = side[i];
+            double v = V[i];
+
+            // Longitudinal, lateral and spin creepages
+            double xi_x = (v + yaw[i]*ydot[i] + radius[i]*(yaw[i]*phidot[i] - spin[i]) -
+                    s*aw[i]*psidot[i] + s*cant[i]*v)/v;
+            double xi_y = ((-v*yaw[i]*(1.0+s*cant[i]) + phi[i]*zdot[i] + ydot[i] + phidot[i]*radius[i]) * cosd[i] +
+                    s*(-phi[i]*ydot[i] + zdot[i] + s*aw[i]*phidot[i]) * sind[i])/v;
+            double xi_s = (-s*(spin[i] - yaw[i]*phidot[i])*sind[i] + psidot[i]*cosd[i])/v;
+
+            double ab = cpA[i]*cpB[i];
+            double Fx = -ab*G[i]*C11[i]*xi_x;
+            double Fy = -ab*G[i]*(C22[i]*xi_y + sqrtab[i]*C23[i]*xi_s);
+            fx[i] = Fx;
+            fy[i] = Fy;
+            norm[i] = Fx*Fx + Fy*Fy;
+        }
+
+        for (int i = 0; i < n; i++)
+            norm[i] = sqrt(norm[i]);
+
+        // Shen-Hedrick-Elkins saturation and forces and torques w.r.t. the wheelset
+#pragma GCC ivdep
+        for (int i = 0; i < n; i++){
+            double s = side[i];
+
+            // |F| = mu*N*(u - u^2/3 + u^3/27) for u < 3, mu*N otherwise, with u = |F_lin|/(mu*N)
+            double u = norm[i]/(mu[i]*N[i]);
+            double epsilon = (u < 3.0) ? (1.0 - u/3.0 + u*u/27.0) : 1.0/u;
+            epsilon = (N[i] == 0.0) ? 0.0 : epsilon;
+            double Fcx = epsilon*fx[i];
+            double Fcy = epsilon*fy[i];
+
+            double Fwx = Fcx - Fcy*psi[i]*cosd[i];
+            double Fwy = Fcx*psi[i] + Fcy*cosa[i];
+            double Fwz = s*Fcy*sina[i];
+            double Nwy = -s*N[i]*sina[i];
+            double Nwz = N[i]*cosa[i];
+            fx[i] = Fwx;
+            fy[i] = Fwy;
+            fz[i] = Fwz;
+            ny[i] = Nwy;
+            nz[i] = Nwz;
+            tphi[i] = s*aw[i]*(Fwz + Nwz - (Fwy + Nwy)*phi[i]);
+            tchi[i] = -radius[i]*(Fwx + (Fwy + Nwy)*psi[i]);
+            tpsi[i] = -s*aw[i]*(Fwx + (Fwy + Nwy)*psi[i]);
+        }
+    }
+}
@@ -0,0 +1,95 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+
+#ifndef CONTACTKERNEL_H
+#define	CONTACTKERNEL_H
+
+#include "ModelArena.h"
+
+namespace DYTSI_Modelling {
+
+    /**
+     * Wheel-rail contacts of a batch of wheels stored by fields (structure of arrays).
+     * The wheelsets gather their contacts (see WheelSetComponent::gatherContacts), the
+     * kernel evaluates the creepages, Kalker's linear creep forces, the Shen-Hedrick-Elkins
+     * saturation and the forces and torques on the wheelset for all of them, and the
+     * wheelsets scatter the results back (see WheelSetComponent::scatterContacts).
+     * The left and the right wheel, the leading and the trailing wheelset differ only by
+     * signs (CK_SIDE and CK_YAW), so the arithmetic loops are free of branches and are
+     * vectorized by the compiler for the target of the build (e.g. -O3 -march=native
+     * gives AVX2 or AVX-512), scalar code otherwise.
+     */
+    class ContactKernel {
+    public:
+        ContactKernel();
+        virtual ~ContactKernel();
+
+        enum ContactField {
+            // Inputs
+            CK_SIDE,    // +1 left wheel, -1 right wheel
+            CK_V,       // Speed
+            CK_YAW,     // Yaw angle of the wheelset w.r.t. the track (psi +- b/R)
+            CK_CANT,    // a*cos(Phi_se)/R
+            CK_SPIN,    // Omega_0 + beta
+            CK_PSI, CK_PSIDOT, CK_PHI, CK_PHIDOT, CK_YDOT, CK_ZDOT,
+            CK_RADIUS,  // Rolling radius
+            CK_AW,      // Distance of the contact point
+            CK_DELTA,   // Contact angle
+            CK_N,       // Normal force
+            CK_A, CK_B, // Semi axes of the contact ellipse
+            CK_C11, CK_C22, CK_C23, // Kalker's coefficients
+            CK_G,       // Shear modulus
+            CK_MU,      // Friction coefficient
+            // Outputs (w.r.t. the wheelset)
+            CK_FX, CK_FY, CK_FZ,        // Creep forces
+            CK_NY, CK_NZ,               // Normal forces
+            CK_TPHI, CK_TCHI, CK_TPSI,  // Torques
+            // Scratch
+            CK_COSD, CK_SIND, CK_COSA, CK_SINA, CK_SQRTAB, CK_NORM,
+            CK_N_FIELDS
+        };
+
+        // Storage for maxContacts contacts taken from the arena
+        void setup(ModelArena* arena, int maxContacts);
+
+        void clear(){ nContacts = 0; }
+        // Index of a new contact, -1 if the batch is full
+        int add(){ return (nContacts < maxContacts) ? nContacts++ : -1; }
+        int getNumberOfContacts(){ return nContacts; }
+
+        double* get(ContactField field){ return fields[field]; }
+
+        // Evaluate the outputs of all the contacts of the batch
+        void evaluate();
+
+    private:
+        double* fields[CK_N_FIELDS];
+        int nContacts;
+        int maxContacts;
+    };
+}
+
+#endif	/* CONTACTKERNEL_H */
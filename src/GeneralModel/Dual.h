@@ -0,0 +1,152 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+
+#ifndef DUAL_H
+#define	DUAL_H
+
+#include <cmath>
+
+namespace DYTSI_Modelling {
+
+    /**
+     * Dual number with N directional derivatives, for the forward automatic
+     * differentiation of the right hand sides. Every arithmetic operation propagates
+     * the derivatives with the chain rule, so evaluating a function with the seeds
+     * y[j].setDerivative(k, 1.0) gives N exact columns of its Jacobian at once.
+     * The elementary functions are friends, found by argument dependent lookup, so
+     * that generic code can call fabs, sqrt, ... on doubles and duals alike.
+     */
+    template<int N>
+    class Dual {
+    public:
+        Dual() : val(0.0) {
+            for (int i = 0; i < N; i++) der[i] = 0.0;
+        }
+        Dual(double v) : val(v) {
+            for (int i = 0; i < N; i++) der[i] = 0.0;
+        }
+
+        double value() const { return val; }
+        void setValue(double v) { val = v; }
+        double derivative(int i) const { return der[i]; }
+        void setDerivative(int i, double d) { der[i] = d; }
+
+        Dual& operator+=(const Dual& b) {
+            val += b.val;
+            for (int i = 0; i < N; i++) der[i] += b.der[i];
+            return *this;
+        }
+        Dual& operator-=(const Dual& b) {
+            val -= b.val;
+            for (int i = 0; i < N; i++) der[i] -= b.der[i];
+            return *this;
+        }
+        Dual& operator*=(const Dual& b) {
+            for (int i = 0; i < N; i++) der[i] = der[i] * b.val + val * b.der[i];
+            val *= b.val;
+            return *this;
+        }
+        Dual& operator/=(const Dual& b) {
+            double inv = 1.0 / b.val;
+            val *= inv;
+            for (int i = 0; i < N; i++) der[i] = (der[i] - val * b.der[i]) * inv;
+            return *this;
+        }
+        Dual& operator+=(double b) { val += b; return *this; }
+        Dual& operator-=(double b) { val -= b; return *this; }
+        Dual& operator*=(double b) {
+            val *= b;
+            for (int i = 0; i < N; i++) der[i] *= b;
+            return *this;
+        }
+        Dual& operator/=(double b) { return (*this) *= (1.0 / b); }
+
+        friend Dual operator-(const Dual& a) { Dual r(a); return r *= -1.0; }
+        friend Dual operator+(const Dual& a, const Dual& b) { Dual r(a); return r += b; }
+        friend Dual operator-(const Dual& a, const Dual& b) { Dual r(a); return r -= b; }
+        friend Dual operator*(const Dual& a, const Dual& b) { Dual r(a); return r *= b; }
+        friend Dual operator/(const Dual& a, const Dual& b) { Dual r(a); return r /= b; }
+        friend Dual operator+(const Dual& a, double b) { Dual r(a); return r += b; }
+        friend Dual operator-(const Dual& a, double b) { Dual r(a); return r -= b; }
+        friend Dual operator*(const Dual& a, double b) { Dual r(a); return r *= b; }
+        friend Dual operator/(const Dual& a, double b) { Dual r(a); return r /= b; }
+        friend Dual operator+(double a, const Dual& b) { Dual r(b); return r += a; }
+        friend Dual operator-(double a, const Dual& b) { Dual r(-b); return r += a; }
+        friend Dual operator*(double a, const Dual& b) { Dual r(b); return r *= a; }
+        friend Dual operator/(double a, const Dual& b) {
+            Dual r(a / b.val);
+            double c = - r.val / b.val;
+            for (int i = 0; i < N; i++) r.der[i] = c * b.der[i];
+            return r;
+        }
+
+        // Comparisons only look at the values
+        friend bool operator<(const Dual& a, const Dual& b) { return a.val < b.val; }
+        friend bool operator>(const Dual& a, const Dual& b) { return a.val > b.val; }
+        friend bool operator<=(const Dual& a, const Dual& b) { return a.val <= b.val; }
+        friend bool operator>=(const Dual& a, const Dual& b) { return a.val >= b.val; }
+        friend bool operator<(const Dual& a, double b) { return a.val < b; }
+        friend bool operator>(const Dual& a, double b) { return a.val > b; }
+        friend bool operator<=(const Dual& a, double b) { return a.val <= b; }
+        friend bool operator>=(const Dual& a, double b) { return a.val >= b; }
+        friend bool operator<(double a, const Dual& b) { return a < b.val; }
+        friend bool operator>(double a, const Dual& b) { return a > b.val; }
+
+        // Elementary functions
+        friend Dual fabs(const Dual& a) { return (a.val < 0.0) ? -a : a; }
+        friend Dual sqrt(const Dual& a) { return a.chain(std::sqrt(a.val), 0.5 / std::sqrt(a.val)); }
+        friend Dual exp(const Dual& a) { return a.chain(std::exp(a.val), std::exp(a.val)); }
+        friend Dual log(const Dual& a) { return a.chain(std::log(a.val), 1.0 / a.val); }
+        friend Dual sin(const Dual& a) { return a.chain(std::sin(a.val), std::cos(a.val)); }
+        friend Dual cos(const Dual& a) { return a.chain(std::cos(a.val), - std::sin(a.val)); }
+        friend Dual atan(const Dual& a) { return a.chain(std::atan(a.val), 1.0 / (1.0 + a.val * a.val)); }
+        friend Dual pow(const Dual& a, double p) {
+            return a.chain(std::pow(a.val, p), p * std::pow(a.val, p - 1.0));
+        }
+
+        // Value f and derivative df of a scalar function evaluated in this number
+        Dual chain(double f, double df) const {
+            Dual r(f);
+            for (int i = 0; i < N; i++) r.der[i] = df * der[i];
+            return r;
+        }
+
+    private:
+        double val;
+        double der[N];
+    };
+
+    // Value of a scalar of the generic code
+    inline double valueOf(double x) { return x; }
+    template<int N>
+    inline double valueOf(const Dual<N>& x) { return x.value(); }
+
+    // Number of Jacobian columns computed by every evaluation of the right hand side
+    const int AD_WIDTH = 8;
+    typedef Dual<AD_WIDTH> ADScalar;
+}
+
+#endif	/* DUAL_H */
@@ -35,6 +35,7 @@
 #define	FUNCTION_H
 
 #include "enumDeclarations.h"
+#include "Dual.h"
 
 namespace DYTSI_Modelling {
     class Function {
@@ -43,6 +44,17 @@ namespace DYTSI_Modelling {
         virtual ~Function();
 
         virtual int func(double val, double &res) = 0;
+        // Value and derivative of the function in val
+        virtual int func(double val, double &res, double &dres) = 0;
+
+        // Evaluation on dual numbers (see Dual.h)
+        template<int N>
+        int func(const Dual<N>& val, Dual<N>& res){
+            double f, df;
+            int errCode = this->func(val.value(), f, df);
+            res = val.chain(f, df);
+            return errCode;
+        }
         virtual FunctionTypes getType() = 0;
 
     private:
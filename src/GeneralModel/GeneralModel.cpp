@@ -33,11 +33,14 @@
 
 #include "GeneralModel.h"
 #include "DYTSI_Modelling.h"
+#include "HeapCounter.h"
 
 #include "../Application/PrintingHandler.h"
 #include "../Application/Simulation.h"
 #include "../Application/Input/XMLaux.h"
 
+#include <algorithm>
+#include <map>
 #include <sstream>
 
 namespace DYTSI_Modelling{
@@ -50,10 +53,49 @@ namespace DYTSI_Modelling{
     GeneralModel::GeneralModel() {
         N_DOF = 0;
         this->externalComponents = new ExternalComponents(0.1, 1e99, 0.0);
+        this->workerPool = NULL;
+        this->execMode = Simulation::getExecMode();
+        this->jacobianMode = JAC_NUMERICAL;
+        this->funY = NULL;
+        this->jacY = NULL;
+        this->contactStatus = NULL;
+        this->fun_counter = 0;
+        this->jac_counter = 0;
+        this->eval_allocations = 0;
+        this->evalDepth = 0;
+        this->settedUp = false;
+    }
+
+    /**
+     * Copy only the parameters of the model: the component tree, the static loaded
+     * spring lists and the dynamical system are set up by GeneralModel::clone().
+     * @param model
+     */
+    GeneralModel::GeneralModel(const GeneralModel& model){
+        N_DOF = 0;
+        this->externalComponents = new ExternalComponents(*model.externalComponents);
+        this->rootComponent = NULL;
+        this->workerPool = NULL;
+        this->execMode = model.execMode;
+        this->jacobianMode = model.jacobianMode;
+        // The copy has the same layout (see clone)
+        this->jacobianPattern = model.jacobianPattern;
+        this->coloredJacobian = model.coloredJacobian;
+        if (model.workerPool != NULL)
+            this->workerPool = new WorkerPool(WorkerPool::defaultNumberOfWorkers());
+        this->funY = NULL;
+        this->jacY = NULL;
+        this->contactStatus = NULL;
+        this->fun_counter = 0;
+        this->jac_counter = 0;
+        this->eval_allocations = 0;
+        this->evalDepth = 0;
         this->settedUp = false;
     }
 
     GeneralModel::~GeneralModel() {
+        if (this->workerPool != NULL)
+            delete this->workerPool;
     }
 
     void GeneralModel::setup(XERCES_CPP_NAMESPACE::DOMElement* el){
@@ -65,11 +107,138 @@ namespace DYTSI_Modelling{
         if (error) return;
         error = this->setupStaticLoads();
         if (error) return;
+        this->setupJacobianPattern();
+        this->setupWorkspace();
         gsl_odeiv2_system system = {fun, jac, N_DOF, this};
         this->sys = system;
+
+        // The worker pool is created once and reused by every evaluation
+        if ((this->execMode == THREADS) && (this->workerPool == NULL))
+            this->workerPool = new WorkerPool(WorkerPool::defaultNumberOfWorkers());
+
         this->setSettedUp(true);
     }
 
+    /**
+     * Set the execution policy of the model. If the model is already setted up
+     * the worker pool is created or released accordingly.
+     * @param mode
+     */
+    void GeneralModel::setExecMode(ExecMode mode){
+        this->execMode = mode;
+        if (!this->settedUp) return;
+        if ((mode == THREADS) && (this->workerPool == NULL)){
+            this->workerPool = new WorkerPool(WorkerPool::defaultNumberOfWorkers());
+        } else if ((mode == NO_THREADS) && (this->workerPool != NULL)){
+            delete this->workerPool;
+            this->workerPool = NULL;
+        }
+    }
+
+    static bool compareStartingDOF(Component* a, Component* b){
+        return a->get_startingDOF() < b->get_startingDOF();
+    }
+
+    /**
+     * Build the block sparsity of the Jacobian from the components and their
+     * interdependencies.
+     */
+    void GeneralModel::setupJacobianPattern(){
+        this->jacobianPattern.clear();
+
+        std::vector<Component*> componentList = this->getComponentList();
+        std::sort(componentList.begin(), componentList.end(), compareStartingDOF);
+        for (std::vector<Component*>::iterator it = componentList.begin();
+                it != componentList.end(); ++it){
+            this->jacobianPattern.addBlock((*it)->get_startingDOF(), (*it)->get_N_DOF());
+        }
+
+        for (unsigned int i = 0; i < componentList.size(); i++){
+            const std::vector<int>& idx = componentList[i]->getPartialJacobianIdx();
+            for (std::vector<int>::const_iterator iter = idx.begin(); iter != idx.end(); ++iter)
+                this->jacobianPattern.addColumn(i, *iter);
+        }
+
+        this->coloredJacobian.setup(this->get_N_DOF(), &this->jacobianPattern);
+    }
+
+    /**
+     * Take the scratch memory of the model and of its components from the arena,
+     * such that the evaluations do not allocate.
+     */
+    void GeneralModel::setupWorkspace(){
+        this->workspace.clear();
+        this->funY = this->workspace.allocate<double>(this->get_N_DOF());
+        this->jacY = this->workspace.allocate<double>(this->get_N_DOF());
+
+        std::vector<Component*> componentList = this->getComponentList();
+        for (std::vector<Component*>::iterator it = componentList.begin();
+                it != componentList.end(); ++it){
+            (*it)->setupWorkspace(&this->workspace);
+        }
+
+        // The wheelsets are the lower components of the bogie frames
+        this->wheelSetList.clear();
+        int maxContacts = 0;
+        Component* carBody = this->getRootComponent();
+        ComponentConnectorCouple* bogieFrames[2] = { carBody->getLowerLeading(), carBody->getLowerTrailing() };
+        for (int i = 0; i < 2; i++){
+            if (bogieFrames[i] == NULL) continue;
+            ComponentConnectorCouple* wheelSets[2] = {
+                bogieFrames[i]->getComponent()->getLowerLeading(),
+                bogieFrames[i]->getComponent()->getLowerTrailing() };
+            for (int j = 0; j < 2; j++){
+                if (wheelSets[j] == NULL || wheelSets[j]->getComponent()->get_isFixed()) continue;
+                WheelSetComponent* wheelSet = (WheelSetComponent*) wheelSets[j]->getComponent();
+                this->wheelSetList.push_back(wheelSet);
+                maxContacts += wheelSet->getMaxContacts();
+            }
+        }
+        this->contactKernel.setup(&this->workspace, maxContacts);
+        this->contactStatus = this->workspace.allocate<int>(this->wheelSetList.size());
+    }
+
+    /**
+     * Evaluate the contact forces of the wheels of all the wheelsets in one pass of the
+     * contact kernel, before the evaluation of the component tree. The wheelsets whose
+     * contacts cannot be gathered (e.g. derailment) evaluate and report them in their
+     * right hand side.
+     */
+    void GeneralModel::evaluateContacts(double t, const double y[]){
+        if (this->wheelSetList.empty()) return;
+
+        this->contactKernel.clear();
+        for (unsigned int i = 0; i < this->wheelSetList.size(); i++)
+            this->contactStatus[i] = this->wheelSetList[i]->gatherContacts(t, y, &this->contactKernel);
+        this->contactKernel.evaluate();
+        for (unsigned int i = 0; i < this->wheelSetList.size(); i++)
+            if (this->contactStatus[i] == GSL_SUCCESS)
+                this->wheelSetList[i]->scatterContacts(&this->contactKernel);
+    }
+
+    // The results of the batch are valid only for the evaluation they were computed for
+    void GeneralModel::releaseContacts(){
+        for (unsigned int i = 0; i < this->wheelSetList.size(); i++)
+            this->wheelSetList[i]->releaseContacts();
+    }
+
+    /**
+     * Count the heap allocations of the outermost evaluation (the Jacobian by grouped
+     * differences evaluates the function). The count is per thread (see HeapCounter),
+     * so it misses the allocations of the workers in THREADS mode.
+     */
+    void GeneralModel::beginEvaluation(){
+        if (this->evalDepth == 0)
+            this->evalStartAllocations = HeapCounter::getAllocations();
+        this->evalDepth++;
+    }
+
+    void GeneralModel::endEvaluation(){
+        this->evalDepth--;
+        if (this->evalDepth == 0)
+            this->eval_allocations += HeapCounter::getAllocations() - this->evalStartAllocations;
+    }
+
     bool GeneralModel::setStartingValues(XERCES_CPP_NAMESPACE::DOMElement* el, std::vector<double>& startingValues){
         return this->loadStartingValues(el, startingValues);
     }
@@ -89,9 +258,79 @@ namespace DYTSI_Modelling{
 //    	// TODO Fix computeFun, such that the last entry will be set to the decel coeff and all the other entries will be computed according to the speed received in input!!
 //    }
 
+    /**
+     * Return an independent copy of the model, that can be integrated concurrently with
+     * the original one. The mutable state (components, connectors, links, external components
+     * and worker pool) is duplicated, while the immutable data (RSGEO tables, characteristic
+     * functions and geometry) is shared. The static loads are copied from the original model
+     * instead of being computed again.
+     * @return the copy, or NULL if the model is not setted up
+     */
+    GeneralModel* GeneralModel::clone(){
+        if (!this->settedUp){
+            std::stringstream out;
+            out << "Error: GeneralModel::clone. The Model is not setted up." << std::endl;
+            PrintingHandler::printOut(&out, PrintingHandler::STDERR);
+            return NULL;
+        }
+
+        GeneralModel* model = this->newInstance();
+
+        // Copy the components following the order of their DOFs, such that the copy has the same layout
+        std::vector<Component*> componentList = this->getComponentList();
+        std::sort(componentList.begin(), componentList.end(), compareStartingDOF);
+        std::map<Component*, Component*> componentMap;
+        for (std::vector<Component*>::iterator it = componentList.begin();
+                it != componentList.end(); ++it){
+            componentMap[*it] = (*it)->clone(model, model->getExternalComponents());
+        }
+        model->setRootComponent(componentMap[this->getRootComponent()]);
+
+        // Copy the connectors from the root to the leaves (the lower components need their upper connection)
+        std::map<Link*, Link*> linkMap;
+        std::vector<Component*> queue;
+        queue.push_back(this->getRootComponent());
+        for (unsigned int i = 0; i < queue.size(); i++){
+            Component* upper = queue[i];
+            ComponentConnectorCouple* couples[2] = { upper->getLowerLeading(), upper->getLowerTrailing() };
+            RelativeComponentPosition positions[2] = { LL, LT };
+            for (int j = 0; j < 2; j++){
+                if (couples[j] == NULL) continue;
+                Component* lower = couples[j]->getComponent();
+                Connector* connector = couples[j]->getConnector();
+                Connector* connectorCopy = connector->clone(componentMap[upper], componentMap[lower], positions[j]);
+                for (int k = 0; k < connector->getLinkListSize(); k++){
+                    Link* link = connector->getLink(k);
+                    Link* linkCopy = link->clone();
+                    connectorCopy->addLink(linkCopy);
+                    // Keep the length at rest corrected for the static loads
+                    linkCopy->getVecLowerToUpperAtRest() = link->getVecLowerToUpperAtRest();
+                    linkMap[link] = linkCopy;
+                }
+                queue.push_back(lower);
+            }
+        }
+
+        for (unsigned int i = 0; i < this->staticLoadedPrimarySuspensionSpringList.size(); i++)
+            model->staticLoadedPrimarySuspensionSpringList.push_back(
+                    (LinkSpring*) linkMap[this->staticLoadedPrimarySuspensionSpringList[i]]);
+        for (unsigned int i = 0; i < this->staticLoadedSecondarySuspensionSpringList.size(); i++)
+            model->staticLoadedSecondarySuspensionSpringList.push_back(
+                    (LinkSpring*) linkMap[this->staticLoadedSecondarySuspensionSpringList[i]]);
+
+        model->setupWorkspace();
+        gsl_odeiv2_system system = {fun, jac, (size_t) model->N_DOF, model};
+        model->sys = system;
+        model->setSettedUp(true);
+
+        return model;
+    }
+
     void GeneralModel::init(){
         this->fun_counter = 0;
         this->jac_counter = 0;
+        this->eval_allocations = 0;
+        this->coloredJacobian.init();
         this->getRootComponent()->init();
     }
 
@@ -99,6 +338,13 @@ namespace DYTSI_Modelling{
         std::stringstream out(std::stringstream::in|std::stringstream::out);
         out << "Function evaluations: \t" << this->fun_counter << std::endl;
         out << "Jacobian evaluations: \t" << this->jac_counter << std::endl;
+        if (this->jacobianMode == JAC_COLORED){
+            out << "Jacobian colors: \t" << this->coloredJacobian.getNumberOfColors() << std::endl;
+            out << "Jacobian function evaluations: \t" << this->coloredJacobian.getFunCounter() << std::endl;
+        }
+        // Only the builds with the counter, and only if the evaluations run on one thread
+        if (HeapCounter::isEnabled() && (this->execMode != THREADS))
+            out << "Heap allocations in the evaluations: \t" << this->eval_allocations << std::endl;
         out << this->getRootComponent()->printCounters();
         std::string outStr = out.str();
         return outStr;
@@ -115,32 +361,15 @@ namespace DYTSI_Modelling{
     int GeneralModel::computeFun(double t, const double y[], double f[]){
         this->fun_counter++;
         if (this->settedUp){
-            // Check the exec mode
-            double* yCopy = new double[this->get_N_DOF()];
-            memcpy(yCopy, y, this->get_N_DOF() * sizeof(double));
-            if (Simulation::getExecMode() == NO_THREADS){
-                int errCode = ( this->getRootComponent()->fun(t, yCopy, f) );
-
-                delete[] yCopy;
-
-                return errCode;
-            } else {
-                // Pack the input
-                FunInput funInput = {t, yCopy, f};
-                ExecInput execInput;
-                execInput.type = FUN;
-                execInput.input = &funInput;
-
-                // Start the root thread
-                this->getRootComponent()->Start( &execInput );
-
-                // Wait for finishing
-                this->getRootComponent()->Join();
-
-                delete[] yCopy;
-
-                return execInput.returnCode;
-            }
+            this->beginEvaluation();
+            // Work on a copy of the state
+            memcpy(this->funY, y, this->get_N_DOF() * sizeof(double));
+            this->evaluateContacts(t, this->funY);
+            int errCode = ( this->getRootComponent()->fun(t, this->funY, f) );
+            this->releaseContacts();
+            this->endEvaluation();
+
+            return errCode;
         } else {
             std::stringstream out;
             out << "Error: GeneralModel::computeFun. The Model is not setted up." << std::endl;
@@ -153,32 +382,19 @@ namespace DYTSI_Modelling{
     int GeneralModel::computeJac(double t, const double y[], double* dfdy, double dfdt[]){
         this->jac_counter++;
         if (this->settedUp){
-            // Check the exec mode
-            double* yCopy = new double[this->get_N_DOF()];
-            memcpy(yCopy, y, this->get_N_DOF() * sizeof(double));
-            if (Simulation::getExecMode() == NO_THREADS){
-                int errCode = ( this->getRootComponent()->jac(t, yCopy, dfdy, dfdt) );
-
-                delete[] yCopy;
-
-                return errCode;
-            } else {
-                // Pack the input
-                JacInput jacInput = {t, yCopy, dfdy, dfdt};
-                struct ExecInput execInput;
-                execInput.type = JAC;
-                execInput.input = &jacInput;
-
-                // Start the root thread
-                this->getRootComponent()->Start( &execInput );
-
-                // Wait for finishing
-                this->getRootComponent()->Join();
-
-                delete[] yCopy;
-
-                return execInput.returnCode;
-            }
+            this->beginEvaluation();
+            // Work on a copy of the state
+            memcpy(this->jacY, y, this->get_N_DOF() * sizeof(double));
+            int errCode;
+            if (this->jacobianMode == JAC_COLORED){
+                for (int i = 0; i < this->get_N_DOF(); i++)
+                    dfdt[i] = 0.0;
+                errCode = this->coloredJacobian.compute(this, t, this->jacY, dfdy);
+            } else
+                errCode = ( this->getRootComponent()->jac(t, this->jacY, dfdy, dfdt) );
+            this->endEvaluation();
+
+            return errCode;
         } else {
             std::stringstream out;
             out << "Error: GeneralModel::computeFun. The Model is not setted up." << std::endl;
@@ -190,80 +406,11 @@ namespace DYTSI_Modelling{
     }
 
     int GeneralModel::computeFun(double t, double y[], double f[]){
-        this->fun_counter++;
-        if (this->settedUp){
-            // Check the exec mode
-            double* yCopy = new double[this->get_N_DOF()];
-            memcpy(yCopy, y, this->get_N_DOF() * sizeof(double));
-            if (Simulation::getExecMode() == NO_THREADS){
-                int errCode = ( this->getRootComponent()->fun(t, yCopy, f) );
-
-                delete[] yCopy;
-
-                return errCode;
-            } else {
-                // Pack the input
-                FunInput funInput = {t, yCopy, f};
-                ExecInput execInput;
-                execInput.type = FUN;
-                execInput.input = &funInput;
-
-                // Start the root thread
-                this->getRootComponent()->Start( &execInput );
-
-                // Wait for finishing
-                this->getRootComponent()->Join();
-
-                delete[] yCopy;
-
-                return execInput.returnCode;
-            }
-        } else {
-            std::stringstream out;
-            out << "Error: GeneralModel::computeFun. The Model is not setted up." << std::endl;
-            out << "Hint: check to have called the function GeneralModel::setup()" << std::endl;
-            PrintingHandler::printOut(&out, PrintingHandler::STDERR);
-            return GSL_EINVAL;
-        }
+        return this->computeFun(t, (const double*) y, f);
     }
 
     int GeneralModel::computeJac(double t, double y[], double* dfdy, double dfdt[]){
-        this->jac_counter++;
-        if (this->settedUp){
-            // Check the exec mode
-            double* yCopy = new double[this->get_N_DOF()];
-            memcpy(yCopy, y, this->get_N_DOF() * sizeof(double));
-            if (Simulation::getExecMode() == NO_THREADS){
-                int errCode = ( this->getRootComponent()->jac(t, yCopy, dfdy, dfdt) );
-
-                delete[] yCopy;
-
-                return errCode;
-            } else {
-                // Pack the input
-                JacInput jacInput = {t, yCopy, dfdy, dfdt};
-                struct ExecInput execInput;
-                execInput.type = JAC;
-                execInput.input = &jacInput;
-
-                // Start the root thread
-                this->getRootComponent()->Start( &execInput );
-
-                // Wait for finishing
-                this->getRootComponent()->Join();
-
-                delete[] yCopy;
-
-                return execInput.returnCode;
-            }
-        } else {
-            std::stringstream out;
-            out << "Error: GeneralModel::computeFun. The Model is not setted up." << std::endl;
-            out << "Hint: check to have called the function GeneralModel::setup()" << std::endl;
-            PrintingHandler::printOut(&out, PrintingHandler::STDERR);
-            return GSL_EINVAL;
-        }
-
+        return this->computeJac(t, (const double*) y, dfdy, dfdt);
     }
 
     int GeneralModel::setRootComponent( Component* component ){
@@ -41,6 +41,11 @@
 #include <xercesc/dom/DOMElement.hpp>
 
 #include "Component.h"
+#include "WorkerPool.h"
+#include "JacobianPattern.h"
+#include "ColoredJacobian.h"
+#include "ModelArena.h"
+#include "ContactKernel.h"
 
 #include <string>
 #include <vector>
@@ -50,6 +55,7 @@ namespace DYTSI_Modelling {
     class Connector;
     class ExternalComponents;
     class LinkSpring;
+    class WheelSetComponent;
 
     enum ExecEnum {FUN, JAC};
 
@@ -83,6 +89,9 @@ namespace DYTSI_Modelling {
         void init();
         std::string printCounters();
 
+        // Independent copy of a setted up model (see GeneralModel::clone)
+        GeneralModel* clone();
+
         // Dynamical system functions
         int computeFun( double t, const double y[], double f[] );
         int computeJac( double t, const double y[], double* dfdy, double dfdt[]);
@@ -96,6 +105,32 @@ namespace DYTSI_Modelling {
 
         gsl_odeiv2_system get_sys(){ return sys; }
 
+        // Pool used to evaluate the component tree in THREADS mode (NULL otherwise)
+        WorkerPool* getWorkerPool(){ return workerPool; }
+
+        // Execution policy of the evaluations of this model
+        ExecMode getExecMode(){ return execMode; }
+        void setExecMode(ExecMode mode);
+
+        // Evaluation of the Jacobian of the components providing a closed form
+        // (JAC_CHECK evaluates both and reports the deviations), or of the whole
+        // model by grouped finite differences (JAC_COLORED). JAC_AUTOMATIC differentiates
+        // the suspensions and the frames with dual numbers, the wheelsets in closed form.
+        JacobianMode getJacobianMode(){ return jacobianMode; }
+        void setJacobianMode(JacobianMode mode){ this->jacobianMode = mode; }
+
+        // Block sparsity of the Jacobian, one block per component
+        JacobianPattern* getJacobianPattern(){ return &jacobianPattern; }
+
+        // Finite difference settings and grouped columns of the pattern
+        ColoredJacobian* getColoredJacobian(){ return &coloredJacobian; }
+
+        // Scratch memory of the evaluations, taken once per model (see setupWorkspace)
+        ModelArena* getWorkspace(){ return &workspace; }
+
+        // Free wheelsets, leading first (set by setupWorkspace)
+        const std::vector<WheelSetComponent*>& getWheelSetList(){ return wheelSetList; }
+
         // Virtual methods
         virtual std::vector<Component*> getComponentList() = 0;
 
@@ -106,13 +141,42 @@ namespace DYTSI_Modelling {
         gsl_odeiv2_system sys;
         ExternalComponents* externalComponents;
         Component* rootComponent;
+        WorkerPool* workerPool;
+        ExecMode execMode;
+        JacobianMode jacobianMode;
+        JacobianPattern jacobianPattern;
+        ColoredJacobian coloredJacobian;
+        ModelArena workspace;
+
+        // Wheel-rail contacts of all the wheelsets, evaluated in one batch per evaluation
+        // of the function (see evaluateContacts)
+        std::vector<WheelSetComponent*> wheelSetList;
+        ContactKernel contactKernel;
+        int* contactStatus;
+
+        // Copies of the state passed to the components (the Jacobian by grouped
+        // differences evaluates the function, so the two are separated)
+        double* funY;
+        double* jacY;
 
         unsigned long int fun_counter;
         unsigned long int jac_counter;
+        // Heap allocations done inside computeFun and computeJac
+        unsigned long int eval_allocations;
+        int evalDepth;
+        unsigned long int evalStartAllocations;
 
         bool setupStaticLoads();
+        void setupJacobianPattern();
+        void setupWorkspace();
+        void evaluateContacts(double t, const double y[]);
+        void releaseContacts();
+        void beginEvaluation();
+        void endEvaluation();
 
     protected:
+        GeneralModel(const GeneralModel& model);
+
         std::vector<DYTSI_Modelling::LinkSpring*> staticLoadedSecondarySuspensionSpringList;
         std::vector<DYTSI_Modelling::LinkSpring*> staticLoadedPrimarySuspensionSpringList;
 
@@ -123,6 +187,8 @@ namespace DYTSI_Modelling {
         // Virtual methods
         virtual bool setupModel(XERCES_CPP_NAMESPACE::DOMElement* el) = 0;
         virtual bool loadStartingValues( XERCES_CPP_NAMESPACE::DOMElement* el, std::vector<double>& startingValues) = 0;
+        // Copy of the model parameters (the component tree is rebuilt by clone())
+        virtual GeneralModel* newInstance() = 0;
         
         // Accessory functions
         int setRootComponent( Component* component );
@@ -0,0 +1,112 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+
+#include "HeapCounter.h"
+
+#include <cstdlib>
+#include <new>
+
+#ifdef DYTSI_HEAP_COUNTER
+
+// Exception specifications of the replaced operators (the dynamic ones are
+// not allowed from C++17)
+#if __cplusplus >= 201103L
+#define NEW_THROW
+#define NEW_NOTHROW noexcept
+#else
+#define NEW_THROW throw(std::bad_alloc)
+#define NEW_NOTHROW throw()
+#endif
+
+namespace DYTSI_Modelling {
+    // Per thread, such that concurrent evaluations (-j, -p) do not count each other
+    static __thread unsigned long int heapAllocations = 0;
+
+    unsigned long int HeapCounter::getAllocations(){
+        return heapAllocations;
+    }
+
+    bool HeapCounter::isEnabled(){
+        return true;
+    }
+
+    static void* countedAlloc(size_t size){
+        heapAllocations++;
+        return malloc(size > 0 ? size : 1);
+    }
+}
+
+void* operator new(size_t size) NEW_THROW{
+    void* p = DYTSI_Modelling::countedAlloc(size);
+    if (p == NULL)
+        throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size) NEW_THROW{
+    void* p = DYTSI_Modelling::countedAlloc(size);
+    if (p == NULL)
+        throw std::bad_alloc();
+    return p;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) NEW_NOTHROW{
+    return DYTSI_Modelling::countedAlloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) NEW_NOTHROW{
+    return DYTSI_Modelling::countedAlloc(size);
+}
+
+void operator delete(void* p) NEW_NOTHROW{
+    free(p);
+}
+
+void operator delete[](void* p) NEW_NOTHROW{
+    free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) NEW_NOTHROW{
+    free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) NEW_NOTHROW{
+    free(p);
+}
+
+#else
+
+namespace DYTSI_Modelling {
+    unsigned long int HeapCounter::getAllocations(){
+        return 0;
+    }
+
+    bool HeapCounter::isEnabled(){
+        return false;
+    }
+}
+
+#endif
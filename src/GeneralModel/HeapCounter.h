@@ -24,53 +24,24 @@
  *
  */
 
-/* 
- * File:   Thread.cpp
- * Author: s083781
- * 
- * Created on April 12, 2011, 9:16 AM
- */
-
-#include "Thread.h"
-#include <assert.h>
+#ifndef HEAPCOUNTER_H
+#define	HEAPCOUNTER_H
 
 namespace DYTSI_Modelling {
-    Thread::Thread() : m_running(false) {}
-
-    int Thread::Start(void * arg)
-    {
-        if(m_running == false){
-            m_running = true;
-            Arg(arg); // store user data
-            int code = pthread_create(& ThreadId_, NULL, Thread::EntryPoint, this);
-            return code;
-        } else
-            return -1;
-    }
-
-    void Thread::Join(){
-        if (m_running == true){
-            m_running = false;
-            pthread_join(ThreadId_, 0);
-        }
-    }
-
-    int Thread::Run(void * arg)
-    {
-       Setup();
-       Execute( arg );
-    }
-
-    /*static */
-    void * Thread::EntryPoint(void * pthis)
-    {
-       Thread * pt = (Thread*)pthis;
-       pt->Run( pt->Arg() );
-    }
 
-    void Thread::Setup()
-    {
-            // Do any setup here
-    }
+    /**
+     * Number of heap allocations (operator new) done by the calling thread so far.
+     * It is a diagnostic of the builds with DYTSI_HEAP_COUNTER defined
+     * (e.g. ../configure CPPFLAGS=-DDYTSI_HEAP_COUNTER): the global operator new is
+     * then replaced in HeapCounter.cpp, so the count covers the STL containers as well.
+     * It is used by GeneralModel::printCounters to check that the evaluations of the
+     * model do not allocate. Without the flag the count is always 0.
+     */
+    class HeapCounter {
+    public:
+        static unsigned long int getAllocations();
+        static bool isEnabled();
+    };
 }
 
+#endif	/* HEAPCOUNTER_H */
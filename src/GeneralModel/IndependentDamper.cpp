@@ -47,58 +47,77 @@ namespace DYTSI_Modelling {
     IndependentDamper::~IndependentDamper() {
     }
 
-    int IndependentDamper::force (RelativeComponentPosition posConnector, gsl_vector* speed, gsl_vector* lengthVector, gsl_vector* F){
+    Link* IndependentDamper::clone(){
+        return new IndependentDamper(this->getBaseName(),
+                this->getConnectionPointUpWRTCenterOfGeometry(),
+                this->getConnectionPointDownWRTCenterOfGeometry(),
+                this->dampingFunctionX, this->dampingFunctionY, this->dampingFunctionZ);
+    }
+
+    template<class T>
+    int IndependentDamper::genericForce(RelativeComponentPosition posConnector, const T speed[3],
+            const T lengthVector[3], T F[3]){
         int errCode = GSL_SUCCESS;
 
         // All the components are taken in order to get the directions
         double xAtRest;
         if (posConnector == UP) {
-            xAtRest = gsl_vector_get(this->getVecLowerToUpperAtRest(),0);
+            xAtRest = this->getVecLowerToUpperAtRest()[0];
         } else {
-            xAtRest = -gsl_vector_get(this->getVecLowerToUpperAtRest(),0);
+            xAtRest = -this->getVecLowerToUpperAtRest()[0];
         }
         double yAtRest;
         if (posConnector == UP) {
-            yAtRest = gsl_vector_get(this->getVecLowerToUpperAtRest(),1);
+            yAtRest = this->getVecLowerToUpperAtRest()[1];
         } else {
-            yAtRest = -gsl_vector_get(this->getVecLowerToUpperAtRest(),1);
+            yAtRest = -this->getVecLowerToUpperAtRest()[1];
         }
         double zAtRest;
         if (posConnector == UP) {
-            zAtRest = gsl_vector_get(this->getVecLowerToUpperAtRest(),2);
+            zAtRest = this->getVecLowerToUpperAtRest()[2];
         } else {
-            zAtRest = -gsl_vector_get(this->getVecLowerToUpperAtRest(),2);
+            zAtRest = -this->getVecLowerToUpperAtRest()[2];
         }
         double signXAtRest = sign(xAtRest);
         double signYAtRest = sign(yAtRest);
         double signZAtRest = sign(zAtRest);
 
-        double velocityMagnitudeX = gsl_vector_get(speed,0) * signXAtRest;
-        double velocityMagnitudeY = gsl_vector_get(speed,1) * signYAtRest;
-        double velocityMagnitudeZ = gsl_vector_get(speed,2) * signZAtRest;
+        T velocityMagnitudeX = speed[0] * signXAtRest;
+        T velocityMagnitudeY = speed[1] * signYAtRest;
+        T velocityMagnitudeZ = speed[2] * signZAtRest;
 
         // Compute the resulting magnitude of the force
-        double FmagX;
+        T FmagX;
         errCode = this->dampingFunctionX->func(velocityMagnitudeX, FmagX);
         if (errCode != GSL_SUCCESS){
             return errCode;
         }
-        double FmagY;
+        T FmagY;
         errCode = this->dampingFunctionY->func(velocityMagnitudeY,FmagY);
         if (errCode != GSL_SUCCESS){
             return errCode;
         }
-        double FmagZ;
+        T FmagZ;
         errCode = this->dampingFunctionZ->func(velocityMagnitudeZ, FmagZ);
         if (errCode != GSL_SUCCESS){
             return errCode;
         }
 
         // Set the force vector
-        gsl_vector_set(F,0,FmagX * signXAtRest);
-        gsl_vector_set(F,1,FmagY * signYAtRest);
-        gsl_vector_set(F,2,FmagZ * signZAtRest);
+        F[0] = FmagX * signXAtRest;
+        F[1] = FmagY * signYAtRest;
+        F[2] = FmagZ * signZAtRest;
 
         return errCode;
     }
+
+    int IndependentDamper::force (RelativeComponentPosition posConnector, const double speed[3],
+            const double lengthVector[3], double F[3]){
+        return this->genericForce(posConnector, speed, lengthVector, F);
+    }
+
+    int IndependentDamper::force (RelativeComponentPosition posConnector, const ADScalar speed[3],
+            const ADScalar lengthVector[3], ADScalar F[3]){
+        return this->genericForce(posConnector, speed, lengthVector, F);
+    }
 }
@@ -48,11 +48,17 @@ namespace DYTSI_Modelling {
     IndependentSpring::~IndependentSpring() {
     }
 
-    int IndependentSpring::force(RelativeComponentPosition posConnector,
-            gsl_vector* lengthVector, gsl_vector* F){
-        int errCode = GSL_SUCCESS;
+    Link* IndependentSpring::clone(){
+        return new IndependentSpring(this->getBaseName(),
+                this->getConnectionPointUpWRTCenterOfGeometry(),
+                this->getConnectionPointDownWRTCenterOfGeometry(),
+                this->stiffnessFunctionX, this->stiffnessFunctionY, this->stiffnessFunctionZ);
+    }
 
-        gsl_vector* dl = gsl_vector_alloc(3);
+    template<class T>
+    int IndependentSpring::genericForce(RelativeComponentPosition posConnector,
+            const T lengthVector[3], T F[3]){
+        int errCode = GSL_SUCCESS;
 
         // Revert the vector if necessary
         double oper;
@@ -63,40 +69,45 @@ namespace DYTSI_Modelling {
         }
 
         // Compute the displacment component by component
-        gsl_vector_memcpy(dl, lengthVector);
-        gsl_blas_daxpy(oper, this->getVecLowerToUpperAtRest(), dl);
+        T dl[3];
+        for (int i = 0; i < 3; i++)
+            dl[i] = lengthVector[i] + oper * this->getVecLowerToUpperAtRest()[i];
 
         // Compute the magnitude of the force
-        double FmagX;
-        errCode = this->stiffnessFunctionX->func(gsl_vector_get(dl,0), FmagX);
+        T FmagX;
+        errCode = this->stiffnessFunctionX->func(dl[0], FmagX);
         if (errCode != GSL_SUCCESS){
-            gsl_vector_free(dl);
             return errCode;
         }
-        double FmagY;
-        errCode = this->stiffnessFunctionY->func(gsl_vector_get(dl,1),FmagY);
+        T FmagY;
+        errCode = this->stiffnessFunctionY->func(dl[1],FmagY);
         if (errCode != GSL_SUCCESS){
-            gsl_vector_free(dl);
             return errCode;
         }
-        double FmagZ;
-        errCode = this->stiffnessFunctionZ->func(gsl_vector_get(dl,2), FmagZ);
+        T FmagZ;
+        errCode = this->stiffnessFunctionZ->func(dl[2], FmagZ);
         if (errCode != GSL_SUCCESS){
-            gsl_vector_free(dl);
             return errCode;
         }
 
         // Compute the Force vector
-        gsl_vector_set(F,0,FmagX);
-        gsl_vector_set(F,1,FmagY);
-        gsl_vector_set(F,2,FmagZ);
-
-        // Free memory
-        gsl_vector_free(dl);
+        F[0] = FmagX;
+        F[1] = FmagY;
+        F[2] = FmagZ;
 
         return errCode;
     }
 
+    int IndependentSpring::force(RelativeComponentPosition posConnector,
+            const double lengthVector[3], double F[3]){
+        return this->genericForce(posConnector, lengthVector, F);
+    }
+
+    int IndependentSpring::force(RelativeComponentPosition posConnector,
+            const ADScalar lengthVector[3], ADScalar F[3]){
+        return this->genericForce(posConnector, lengthVector, F);
+    }
+
     Function* IndependentSpring::getStiffnessFunctionZ(){
         return this->stiffnessFunctionZ;
     }
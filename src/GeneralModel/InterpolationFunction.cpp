@@ -33,9 +33,18 @@
 
 #include "InterpolationFunction.h"
 
+#include <math.h>
+
 namespace DYTSI_Modelling{
+    // Relative tolerance (w.r.t. the step) on the abscissas of a uniform grid
+    const double UNIFORM_GRID_TOL = 1e-6;
+
     InterpolationFunction::InterpolationFunction(InterpolationTypes interpType) {
         this->interpType = interpType;
+        this->gridX = NULL;
+        this->gridSize = 0;
+        this->uniformGrid = false;
+        this->gridInvStep = 0.0;
     }
 
     InterpolationFunction::~InterpolationFunction() {
@@ -53,5 +62,83 @@ namespace DYTSI_Modelling{
                 return gsl_interp_alloc (gsl_interp_linear, size);
         }
     }
-}
 
+    void InterpolationFunction::setupGrid(const double xs[], int size){
+        this->gridX = xs;
+        this->gridSize = size;
+        this->uniformGrid = false;
+        if (size < 3)
+            return;
+
+        double step = (xs[size-1] - xs[0]) / (size - 1);
+        if (!(step > 0.0))
+            return;
+        for (int i = 1; i < size - 1; i++){
+            if (fabs(xs[i] - (xs[0] + i*step)) > UNIFORM_GRID_TOL * step)
+                return;
+        }
+        this->uniformGrid = true;
+        this->gridInvStep = 1.0 / step;
+    }
+
+    int InterpolationFunction::locate(double x) const {
+        const double* xs = this->gridX;
+        int last = this->gridSize - 1;
+        if (!(x >= xs[0] && x <= xs[last]))
+            return -1;
+
+        if (this->uniformGrid){
+            // Guess from the step, then fix the rounding at the knots (same interval as bisection)
+            int i = (int) ((x - xs[0]) * this->gridInvStep);
+            if (i > last - 1)
+                i = last - 1;
+            if (i > 0 && x < xs[i])
+                i--;
+            else if (i < last - 1 && x >= xs[i+1])
+                i++;
+            return i;
+        }
+
+        int lo = 0;
+        int hi = last;
+        while (hi - lo > 1){
+            int mid = (lo + hi) / 2;
+            if (xs[mid] > x)
+                hi = mid;
+            else
+                lo = mid;
+        }
+        return lo;
+    }
+
+    int InterpolationFunction::locate(double x, int& hint) const {
+        if (!this->uniformGrid && hint >= 0 && hint < this->gridSize - 1 &&
+                x >= this->gridX[hint] && x < this->gridX[hint+1])
+            return hint;
+        int i = this->locate(x);
+        if (i >= 0)
+            hint = i;
+        return i;
+    }
+
+    void InterpolationFunction::polynomialCoefficients(gsl_interp* interp, const double xs[], const double ys[],
+            int size, double coeffs[], int stride){
+        // The interpolants are piecewise polynomials of degree <= 3: on the interval i the
+        // coefficients are the value, the first derivative and half the second derivative at x_i
+        // (the interval found by gsl for x = x_i is i), the cubic one follows from x_i+1.
+        for (int i = 0; i < size - 1; i++){
+            double h = xs[i+1] - xs[i];
+            double* c = &(coeffs[i*stride]);
+            c[0] = ys[i];
+            if (this->interpType == INTP_LINEAR){
+                c[1] = (ys[i+1] - ys[i]) / h;
+                c[2] = 0.0;
+                c[3] = 0.0;
+            } else {
+                c[1] = gsl_interp_eval_deriv(interp, xs, ys, xs[i], NULL);
+                c[2] = 0.5 * gsl_interp_eval_deriv2(interp, xs, ys, xs[i], NULL);
+                c[3] = (ys[i+1] - c[0] - h*(c[1] + h*c[2])) / (h*h*h);
+            }
+        }
+    }
+}
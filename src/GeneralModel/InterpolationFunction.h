@@ -44,12 +44,36 @@ namespace DYTSI_Modelling{
     public:
         InterpolationFunction(InterpolationTypes interpType);
         virtual ~InterpolationFunction();
+
+        // True if the abscissas are equally spaced (the interval is found arithmetically)
+        bool isUniformGrid() const { return uniformGrid; }
         
     private:
         InterpolationTypes interpType;
 
+        // Abscissas of the table (not owned) and uniform grid parameters
+        const double* gridX;
+        int gridSize;
+        bool uniformGrid;
+        double gridInvStep;
+
     protected:
         gsl_interp* allocInterp(int size);
+        InterpolationTypes getInterpType() const { return interpType; }
+
+        // Set the abscissas used by locate and detect if they are equally spaced
+        void setupGrid(const double xs[], int size);
+        // Interval i such that x_i <= x < x_i+1 (the last one includes its right end),
+        // -1 if x is out of the table. O(1) on a uniform grid, bisection otherwise.
+        int locate(double x) const;
+        // Same, with the interval of the previous lookup of the caller as first guess for the
+        // non-uniform grids (hint is the per-caller state, updated)
+        int locate(double x, int& hint) const;
+
+        // Coefficients of the interpolant interp of (xs, ys) as a piecewise polynomial:
+        // on the interval i, sum_k coeffs[i*stride + k] (x - x_i)^k, k = 0..3
+        void polynomialCoefficients(gsl_interp* interp, const double xs[], const double ys[],
+                int size, double coeffs[], int stride);
     };
 }
 
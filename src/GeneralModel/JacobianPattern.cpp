@@ -0,0 +1,85 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+
+#include "JacobianPattern.h"
+
+#include <algorithm>
+
+namespace DYTSI_Modelling {
+    JacobianPattern::JacobianPattern() {
+    }
+
+    JacobianPattern::~JacobianPattern() {
+    }
+
+    void JacobianPattern::clear(){
+        this->blockStart.clear();
+        this->blockSize.clear();
+        this->coupling.clear();
+        this->columns.clear();
+    }
+
+    int JacobianPattern::addBlock(int startingDOF, int size){
+        this->blockStart.push_back(startingDOF);
+        this->blockSize.push_back(size);
+        // The diagonal block is always present
+        this->coupling.push_back(std::vector<int>(1, this->blockStart.size() - 1));
+        this->columns.push_back(std::vector<int>());
+        return this->blockStart.size() - 1;
+    }
+
+    void JacobianPattern::addCoupling(int rowBlock, int colBlock){
+        std::vector<int>& row = this->coupling[rowBlock];
+        std::vector<int>::iterator it = std::lower_bound(row.begin(), row.end(), colBlock);
+        if ((it == row.end()) || (*it != colBlock))
+            row.insert(it, colBlock);
+    }
+
+    void JacobianPattern::addColumn(int rowBlock, int dof){
+        int colBlock = this->getBlockOfDOF(dof);
+        if (colBlock < 0)
+            return;
+        std::vector<int>& row = this->columns[rowBlock];
+        std::vector<int>::iterator it = std::lower_bound(row.begin(), row.end(), dof);
+        if ((it == row.end()) || (*it != dof))
+            row.insert(it, dof);
+        this->addCoupling(rowBlock, colBlock);
+    }
+
+    int JacobianPattern::getBlockOfDOF(int dof){
+        for (unsigned int i = 0; i < this->blockStart.size(); i++)
+            if ((dof >= this->blockStart[i]) && (dof < this->blockStart[i] + this->blockSize[i]))
+                return i;
+        return -1;
+    }
+
+    int JacobianPattern::getNumberOfCouplings(){
+        int n = 0;
+        for (unsigned int i = 0; i < this->coupling.size(); i++)
+            n += this->coupling[i].size();
+        return n;
+    }
+}
@@ -0,0 +1,74 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+
+#ifndef JACOBIANPATTERN_H
+#define	JACOBIANPATTERN_H
+
+#include <vector>
+
+namespace DYTSI_Modelling {
+
+    /**
+     * Block sparsity structure of the Jacobian of a model. Every component is a
+     * block of consecutive degrees of freedom, and the block (i,j) is structurally
+     * non zero if the equations of component i depend on the variables of component j
+     * (see Component::setConnection and partialJacobianIdx).
+     */
+    class JacobianPattern {
+    public:
+        JacobianPattern();
+        virtual ~JacobianPattern();
+
+        void clear();
+        int addBlock(int startingDOF, int size);
+        void addCoupling(int rowBlock, int colBlock);
+        // The equations of rowBlock depend on the degree of freedom dof
+        void addColumn(int rowBlock, int dof);
+
+        int getNumberOfBlocks(){ return blockStart.size(); }
+        int getBlockStart(int block){ return blockStart[block]; }
+        int getBlockSize(int block){ return blockSize[block]; }
+        // Index of the block containing the degree of freedom dof (-1 if none)
+        int getBlockOfDOF(int dof);
+        // Blocks coupled with the row block (sorted, diagonal included)
+        const std::vector<int>& getCoupledBlocks(int rowBlock){ return coupling[rowBlock]; }
+        int getNumberOfCouplings();
+        // Degrees of freedom the equations of the row block depend on (sorted)
+        const std::vector<int>& getColumns(int rowBlock){ return columns[rowBlock]; }
+
+        const std::vector<int>& getBlockStarts(){ return blockStart; }
+        const std::vector<int>& getBlockSizes(){ return blockSize; }
+        const std::vector< std::vector<int> >& getCouplings(){ return coupling; }
+
+    private:
+        std::vector<int> blockStart;
+        std::vector<int> blockSize;
+        std::vector< std::vector<int> > coupling;
+        std::vector< std::vector<int> > columns;
+    };
+}
+
+#endif	/* JACOBIANPATTERN_H */
@@ -46,32 +46,52 @@ namespace DYTSI_Modelling {
     LateralDamper::~LateralDamper() {
     }
 
-    int LateralDamper::force (RelativeComponentPosition posConnector, gsl_vector* speed, gsl_vector* lengthVector, gsl_vector* F){
+    Link* LateralDamper::clone(){
+        return new LateralDamper(this->getBaseName(),
+                this->getConnectionPointUpWRTCenterOfGeometry(),
+                this->getConnectionPointDownWRTCenterOfGeometry(),
+                this->dampingFunction);
+    }
+
+    template<class T>
+    int LateralDamper::genericForce(RelativeComponentPosition posConnector, const T speed[3],
+            const T lengthVector[3], T F[3]){
         int errCode = GSL_SUCCESS;
 
         // Take the vertical component in order to get the direction of the link
         double yAtRest;
         if (posConnector == UP) {
-            yAtRest = gsl_vector_get(this->getVecLowerToUpperAtRest(),1);
+            yAtRest = this->getVecLowerToUpperAtRest()[1];
         } else {
-            yAtRest = -gsl_vector_get(this->getVecLowerToUpperAtRest(),1);
+            yAtRest = -this->getVecLowerToUpperAtRest()[1];
         }
         double signYAtRest = sign(yAtRest);
 
         // The desired component of the speed is taken
-        double velocityMagnitude = gsl_vector_get(speed,1) * signYAtRest;
+        T velocityMagnitude = speed[1] * signYAtRest;
 
         // Compute the resulting magnitude of the force
-        double Fmag;
+        T Fmag;
         errCode = this->dampingFunction->func(velocityMagnitude, Fmag);
         if (errCode != GSL_SUCCESS){
             return errCode;
         }
 
         // Set the force vector
-        gsl_vector_set_zero(F);
-        gsl_vector_set(F,1, Fmag * signYAtRest);
+        for (int i = 0; i < 3; i++)
+            F[i] = 0.0;
+        F[1] = Fmag * signYAtRest;
 
         return errCode;
     }
+
+    int LateralDamper::force (RelativeComponentPosition posConnector, const double speed[3],
+            const double lengthVector[3], double F[3]){
+        return this->genericForce(posConnector, speed, lengthVector, F);
+    }
+
+    int LateralDamper::force (RelativeComponentPosition posConnector, const ADScalar speed[3],
+            const ADScalar lengthVector[3], ADScalar F[3]){
+        return this->genericForce(posConnector, speed, lengthVector, F);
+    }
 }
@@ -42,10 +42,18 @@ namespace DYTSI_Modelling {
         LateralDamper(std::string name, gsl_vector* connectionPointUp,
             gsl_vector* connectionPointDown, Function* dampingFunction);
         virtual ~LateralDamper();
+        Link* clone();
 
-        int force (RelativeComponentPosition posConnector, gsl_vector* speed, gsl_vector* lengthVector, gsl_vector* F);
+        int force (RelativeComponentPosition posConnector, const double speed[3],
+                const double lengthVector[3], double F[3]);
+        int force (RelativeComponentPosition posConnector, const ADScalar speed[3],
+                const ADScalar lengthVector[3], ADScalar F[3]);
 
     private:
+        template<class T>
+        int genericForce(RelativeComponentPosition posConnector, const T speed[3],
+                const T lengthVector[3], T F[3]);
+
         Function* dampingFunction;
     };
 }
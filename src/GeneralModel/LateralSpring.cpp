@@ -48,40 +48,59 @@ namespace DYTSI_Modelling {
     LateralSpring::~LateralSpring() {
     }
 
-    int LateralSpring::force(RelativeComponentPosition posConnector,
-            gsl_vector* lengthVector, gsl_vector* F){
+    Link* LateralSpring::clone(){
+        return new LateralSpring(this->getBaseName(),
+                this->getConnectionPointUpWRTCenterOfGeometry(),
+                this->getConnectionPointDownWRTCenterOfGeometry(),
+                this->stiffnessFunction);
+    }
+
+    template<class T>
+    int LateralSpring::genericForce(RelativeComponentPosition posConnector,
+            const T lengthVector[3], T F[3]){
         int errCode = GSL_SUCCESS;
 
         // Only the lateral component is needed an computed
         double yAtRest;
         if (posConnector == UP) {
-            yAtRest = gsl_vector_get(this->getVecLowerToUpperAtRest(),1);
+            yAtRest = this->getVecLowerToUpperAtRest()[1];
         } else {
-            yAtRest = -gsl_vector_get(this->getVecLowerToUpperAtRest(),1);
+            yAtRest = -this->getVecLowerToUpperAtRest()[1];
         }
 
-        double y = gsl_vector_get(lengthVector,1);
+        T y = lengthVector[1];
 
         // Compute the vertical displacment
-        double dl = fabs(y) - fabs(yAtRest);
+        T dl = fabs(y) - fabs(yAtRest);
 
         // Compute the magnitude of the force
-        double Fmag;
+        T Fmag;
         errCode = this->stiffnessFunction->func(dl, Fmag);
         if (errCode != GSL_SUCCESS){
             return errCode;
         }
 
         // Compute the Force vector
-        gsl_vector_set_zero(F);
+        for (int i = 0; i < 3; i++)
+            F[i] = 0.0;
         if (yAtRest > 0)
-            gsl_vector_set(F,1,Fmag);
+            F[1] = Fmag;
         else
-            gsl_vector_set(F,1,-Fmag);
+            F[1] = -Fmag;
 
         return errCode;
     }
 
+    int LateralSpring::force(RelativeComponentPosition posConnector,
+            const double lengthVector[3], double F[3]){
+        return this->genericForce(posConnector, lengthVector, F);
+    }
+
+    int LateralSpring::force(RelativeComponentPosition posConnector,
+            const ADScalar lengthVector[3], ADScalar F[3]){
+        return this->genericForce(posConnector, lengthVector, F);
+    }
+
     Function* LateralSpring::getStiffnessFunctionZ(){
         return this->stiffnessFunctionZ;
     }
@@ -49,6 +49,12 @@ namespace DYTSI_Modelling {
         return GSL_SUCCESS;
     }
 
+    int LinearFunction::func(double val, double &res, double &dres){
+        res = this->param * val;
+        dres = this->param;
+        return GSL_SUCCESS;
+    }
+
     FunctionTypes LinearFunction::getType(){
         return FT_LINEAR;
     }
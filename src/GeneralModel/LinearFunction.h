@@ -43,6 +43,7 @@ namespace DYTSI_Modelling {
         virtual ~LinearFunction();
 
         int func(double val, double &res);
+        int func(double val, double &res, double &dres);
 
         FunctionTypes getType();
     private:
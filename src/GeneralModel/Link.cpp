@@ -34,9 +34,9 @@
 #include "Link.h"
 
 #include "Component.h"
+#include "../Application/PrintingHandler.h"
 
 #include <gsl/gsl_vector.h>
-#include <gsl/gsl_blas.h>
 
 #include <sstream>
 
@@ -50,8 +50,6 @@ namespace DYTSI_Modelling{
     }
 
     Link::~Link() {
-        gsl_vector_free(this->getConnectionPointDown());
-        gsl_vector_free(this->getConnectionPointUp());
     }
 
     int Link::getID(){
@@ -68,44 +66,35 @@ namespace DYTSI_Modelling{
         this->connectionPointDown = this->lowerComponent->getPositionWRTCenterOfMass(
                 this->connectionPointDownWRTCenterOfGeometry);
 
-        // Set up the rest vector
-        gsl_vector* yUp = gsl_vector_alloc(3);
-        gsl_vector* yDown = gsl_vector_alloc(3);
-
-        // Find position of the upper coonection point in the inertial frame
-        gsl_vector_memcpy( yUp, this->getConnectionPointUp() );
-        gsl_blas_daxpy(1.0, this->upperComponent->getCenterOfMass(), yUp);
-
-        // Find position of the lower coonection point in the inertial frame
-        gsl_vector_memcpy( yDown, this->getConnectionPointDown() );
-        gsl_blas_daxpy(1.0, this->lowerComponent->getCenterOfMass(), yDown);
-
-        // Take the difference yUp =yUp - yDown
-        gsl_blas_daxpy(-1.0, yDown, yUp);
-
-        this->vecLowerToUpperAtRest = yUp;
-    }
-
-    void Link::setVecLowerToUpperAtRest(gsl_vector* vecLowerToUpperAtRest){
-        this->vecLowerToUpperAtRest = vecLowerToUpperAtRest;
-    }
-
-    gsl_vector* Link::getVecLowerToUpperAtRest(){
-        return this->vecLowerToUpperAtRest;
+        // Set up the rest vector: position of the upper connection point minus
+        // position of the lower connection point, in the inertial frame
+        this->vecLowerToUpperAtRest = (this->connectionPointUp + this->upperComponent->getCenterOfMass()) -
+                (this->connectionPointDown + this->lowerComponent->getCenterOfMass());
     }
 
-    void Link::correctForStaticLoads(gsl_vector* disp){
+    void Link::correctForStaticLoads(const Vec3<double>& disp){
         // add the two vectors
-        gsl_blas_daxpy(-1.0, disp, this->vecLowerToUpperAtRest);
+        this->vecLowerToUpperAtRest -= disp;
     }
 
-    void Link::computeTorques( gsl_vector* point, gsl_vector* F, gsl_vector* M ){
-        double Mx = gsl_vector_get(F,2) * gsl_vector_get(point,1) - gsl_vector_get(F,1) * gsl_vector_get(point,2);
-        double My = gsl_vector_get(F,0) * gsl_vector_get(point,2) - gsl_vector_get(F,2) * gsl_vector_get(point,0);
-        double Mz = gsl_vector_get(F,1) * gsl_vector_get(point,0) - gsl_vector_get(F,0) * gsl_vector_get(point,1);
-        gsl_vector_set(M, 0, Mx );
-        gsl_vector_set(M, 1, My );
-        gsl_vector_set(M, 2, Mz );
+    /**
+     * Connection points w.r.t. the centers of mass of the main and of the attached
+     * component, seen from the connector in position posConnector.
+     */
+    void Link::getConnectionPoints(RelativeComponentPosition posConnector,
+            const Vec3<double>*& connectionPointMain, const Vec3<double>*& connectionPointAttached){
+        if (posConnector == UP){
+            connectionPointMain = &this->connectionPointDown;
+            connectionPointAttached = &this->connectionPointUp;
+        } else if ((posConnector == LL) || (posConnector == LT)){
+            connectionPointMain = &this->connectionPointUp;
+            connectionPointAttached = &this->connectionPointDown;
+        } else {
+            std::stringstream out;
+            out << "Link Error: " << this->getName() << ": the position passed is not valid" << std::endl;
+            PrintingHandler::printOut(&out, PrintingHandler::STDERR);
+            exit(-1);
+        }
     }
 
     std::string Link::getName(){ 
@@ -38,12 +38,26 @@
 #include <gsl/gsl_matrix.h>
 
 #include "enumDeclarations.h"
+#include "Dual.h"
+#include "SmallMatrix.h"
 
 #include <string>
 
 namespace DYTSI_Modelling{
     class Component;
 
+    /**
+     * Position and velocity of the center of mass of a body, with its transformation
+     * matrix and the time derivative of it, for any scalar type (double or Dual).
+     */
+    template<class T>
+    struct BodyKinematics {
+        Vec3<T> r;
+        Vec3<T> dr;
+        Mat3<T> trans;
+        Mat3<T> dtrans;
+    };
+
     class Link {
     public:
         Link(std::string name, gsl_vector* connectionPointUp, gsl_vector* connectionPointDown);
@@ -53,8 +67,9 @@ namespace DYTSI_Modelling{
         int getID();
         int generateID();
 
-        gsl_vector* getConnectionPointUp() { return this->connectionPointUp; }
-        gsl_vector* getConnectionPointDown() { return this->connectionPointDown; }
+        // Connection points w.r.t. the centers of mass (set by connect)
+        const Vec3<double>& getConnectionPointUp() { return this->connectionPointUp; }
+        const Vec3<double>& getConnectionPointDown() { return this->connectionPointDown; }
 
         gsl_vector* getConnectionPointUpWRTCenterOfGeometry() { return this->connectionPointUpWRTCenterOfGeometry; }
         gsl_vector* getConnectionPointDownWRTCenterOfGeometry() { return this->connectionPointDownWRTCenterOfGeometry; }
@@ -63,32 +78,57 @@ namespace DYTSI_Modelling{
         Component* getLowerComponent() { return this->lowerComponent; }
 
         void connect(Component* lowerComponent, Component* upperComponent);
-        void setVecLowerToUpperAtRest(gsl_vector* );
-        gsl_vector* getVecLowerToUpperAtRest();
-        void correctForStaticLoads(gsl_vector* disp);
-
-        virtual gsl_vector* computeForceAndMoments(
-                RelativeComponentPosition posConnector,
-                gsl_vector* rMain, gsl_vector* rAttached,
-                gsl_vector* ddispMain, gsl_vector* ddispAttached,
-                gsl_matrix* transformationMatrixMain, gsl_matrix* transformationMatrixAttached,
-                gsl_matrix* dTransformationMatrixMain, gsl_matrix* dTransformationMatrixAttached,
-                int& errCode) = 0;
+        Vec3<double>& getVecLowerToUpperAtRest(){ return this->vecLowerToUpperAtRest; }
+        void correctForStaticLoads(const Vec3<double>& disp);
+
+        // Forces and moments on the main component (the positions r are absolute).
+        // The same computation is provided for doubles and for dual numbers.
+        virtual int computeForceAndMoments(RelativeComponentPosition posConnector,
+                const BodyKinematics<double>& main, const BodyKinematics<double>& attached,
+                double forceAndMoments[6]) = 0;
+        virtual int computeForceAndMoments(RelativeComponentPosition posConnector,
+                const BodyKinematics<ADScalar>& main, const BodyKinematics<ADScalar>& attached,
+                ADScalar forceAndMoments[6]) = 0;
+
+        // Copy of the link, sharing the characteristic functions and the connection points
+        // w.r.t. the centers of geometry. The copy still needs to be connected.
+        virtual Link* clone() = 0;
     private:
         int id_link;
         std::string name;
         
         Component* upperComponent;
         Component* lowerComponent;
-        gsl_vector* connectionPointUp;
-        gsl_vector* connectionPointDown;
+        Vec3<double> connectionPointUp;
+        Vec3<double> connectionPointDown;
         gsl_vector* connectionPointUpWRTCenterOfGeometry;
         gsl_vector* connectionPointDownWRTCenterOfGeometry;
 
-        gsl_vector* vecLowerToUpperAtRest;
+        Vec3<double> vecLowerToUpperAtRest;
 
     protected:
-        void computeTorques( gsl_vector* point, gsl_vector* F, gsl_vector* M );
+        std::string getBaseName() { return this->name; }
+        // Connection points of the main and of the attached component, seen from
+        // the connector in position posConnector
+        void getConnectionPoints(RelativeComponentPosition posConnector,
+                const Vec3<double>*& connectionPointMain, const Vec3<double>*& connectionPointAttached);
+
+        // Torques of the force F applied in point: point x F
+        template<class T>
+        static Vec3<T> computeTorques( const Vec3<double>& point, const Vec3<T>& F ){
+            return cross(point, F);
+        }
+
+        // Attach point of the link on a body: r + trans * connectionPoint (and its velocity
+        // dr + dtrans * connectionPoint)
+        template<class T>
+        static void attachPoint( const BodyKinematics<T>& body, const Vec3<double>& connectionPoint,
+                Vec3<T>& r, Vec3<T>& dr ){
+            r = body.trans * connectionPoint;
+            r += body.r;
+            dr = body.dtrans * connectionPoint;
+            dr += body.dr;
+        }
     };
 }
 
@@ -48,28 +48,23 @@ namespace DYTSI_Modelling {
         LinkDamper(std::string name, gsl_vector* connectionPointUp, gsl_vector* connectionPointDown);
         ~LinkDamper();
 
-        gsl_vector* computeForceAndMoments(
-                RelativeComponentPosition posConnector,
-                gsl_vector* dispMain, gsl_vector* dispAttached,
-                gsl_vector* ddispMain, gsl_vector* ddispAttached,
-                gsl_matrix* transformationMatrixMain, gsl_matrix* transformationMatrixAttached,
-                gsl_matrix* dTransformationMatrixMain, gsl_matrix* dTransformationMatrixAttached,
-                int& errCode);
+        int computeForceAndMoments(RelativeComponentPosition posConnector,
+                const BodyKinematics<double>& main, const BodyKinematics<double>& attached,
+                double forceAndMoments[6]);
+        int computeForceAndMoments(RelativeComponentPosition posConnector,
+                const BodyKinematics<ADScalar>& main, const BodyKinematics<ADScalar>& attached,
+                ADScalar forceAndMoments[6]);
 
-        virtual int force (RelativeComponentPosition posConnector, gsl_vector* speed, gsl_vector* lengthVector, gsl_vector* F) = 0;
+        virtual int force (RelativeComponentPosition posConnector, const double speed[3],
+                const double lengthVector[3], double F[3]) = 0;
+        virtual int force (RelativeComponentPosition posConnector, const ADScalar speed[3],
+                const ADScalar lengthVector[3], ADScalar F[3]) = 0;
 
     private:
-        gsl_vector* rMainDamper;
-        gsl_vector* rAttachedDamper;
-        gsl_vector* length;
-        gsl_vector* drMainDamper;
-        gsl_vector* drAttachedDamper;
-        gsl_vector* v;
-        gsl_vector* F;
-        gsl_vector* F_rel;
-        gsl_vector* M;
-        gsl_vector* Fb;
-        gsl_vector* vecForceAndMomentum;
+        template<class T>
+        int genericForceAndMoments(RelativeComponentPosition posConnector,
+                const BodyKinematics<T>& main, const BodyKinematics<T>& attached,
+                T forceAndMoments[6]);
     };
 }
 
@@ -71,98 +71,73 @@ namespace DYTSI_Modelling{
 
     LinkSpring::LinkSpring(std::string name, gsl_vector* connectionPointUp, gsl_vector* connectionPointDown)
     : Link(name, connectionPointUp, connectionPointDown){
-        this->rMainSpring = gsl_vector_alloc(3);
-        this->rAttachedSpring = gsl_vector_alloc(3);
-        this->length = gsl_vector_alloc(3);
-        this->F_rel = gsl_vector_alloc(3);
-        this->M = gsl_vector_alloc(3);
-        this->F = gsl_vector_alloc(3);
-        this->Fb = gsl_vector_alloc(3);
-        this->vecForceAndMomentum = gsl_vector_alloc(6);
     }
 
     LinkSpring::~LinkSpring() {
     }
 
-    gsl_vector* LinkSpring::computeForceAndMoments(
-                RelativeComponentPosition posConnector,
-                gsl_vector* rMain, gsl_vector* rAttached,
-                gsl_vector* drMain, gsl_vector* drAttached,
-                gsl_matrix* transformationMatrixMain, gsl_matrix* transformationMatrixAttached,
-                gsl_matrix* dTransformationMatrixMain, gsl_matrix* dTransformationMatrixAttached,
-                int& errCode){
-
-        // Set the main and attached components/connection points
-        Component* mainComponent;
-        Component* attachedComponent;
-        gsl_vector* connectionPointMain;
-        gsl_vector* connectionPointAttached;
-        if (posConnector == UP){
-            mainComponent = this->getLowerComponent();
-            connectionPointMain = this->getConnectionPointDown();
-            attachedComponent = this->getUpperComponent();
-            connectionPointAttached = this->getConnectionPointUp();
-        } else if ((posConnector == LL) || (posConnector == LT)){
-            mainComponent = this->getUpperComponent();
-            connectionPointMain = this->getConnectionPointUp();
-            attachedComponent = this->getLowerComponent();
-            connectionPointAttached = this->getConnectionPointDown();
-        } else {
-            std::stringstream out;
-            out << "Spring Error: computeForceAndMoment: the position passed is not valid" << std::endl;
-            PrintingHandler::printOut(&out, PrintingHandler::STDERR);
-            exit(-1);
-        }
+    template<class T>
+    int LinkSpring::genericForceAndMoments(RelativeComponentPosition posConnector,
+                const BodyKinematics<T>& main, const BodyKinematics<T>& attached,
+                T forceAndMoments[6]){
+        int errCode;
 
-        // Compute the main attach position
+        // Set the main and attached connection points
+        const Vec3<double>* connectionPointMain;
+        const Vec3<double>* connectionPointAttached;
+        this->getConnectionPoints(posConnector, connectionPointMain, connectionPointAttached);
+
+        // Compute the main and attached attach positions
         // rMainSpring = transformationMatrixMain*attachPointSpring + rMain
-        // int gsl_blas_dgemv (CBLAS_TRANSPOSE_t TransA, double alpha, const gsl_matrix * A, const gsl_vector * x, double beta, gsl_vector * y)
-        // gsl_blas_dgemv: y = \alpha op(A) x + \beta y
-        gsl_vector_memcpy(rMainSpring, rMain);
-        gsl_blas_dgemv(CblasNoTrans, 1.0, transformationMatrixMain, connectionPointMain,
-                        1.0, rMainSpring);
-        // Compute the attached attach position
-        gsl_vector_memcpy( rAttachedSpring, rAttached );
-        gsl_blas_dgemv(CblasNoTrans, 1.0, transformationMatrixAttached, connectionPointAttached,
-                        1.0, rAttachedSpring);
+        Vec3<T> rMainSpring, drMainSpring;
+        Vec3<T> rAttachedSpring, drAttachedSpring;
+        this->attachPoint(main, *connectionPointMain, rMainSpring, drMainSpring);
+        this->attachPoint(attached, *connectionPointAttached, rAttachedSpring, drAttachedSpring);
 
         // Find the length vector
         // length = rAttachedSpring - rMainSpring
-        gsl_vector_memcpy(length, rAttachedSpring);
-        gsl_blas_daxpy(-1.0, rMainSpring, length);
+        Vec3<T> length = rAttachedSpring - rMainSpring;
 
         // Compute the force using the function proper of the Spring implementation
-        errCode = this->force(posConnector, length, F);
+        Vec3<T> F;
+        errCode = this->force(posConnector, length.v, F.v);
         if (errCode != GSL_SUCCESS){
             std::stringstream out;
             out << "Spring Error: " << this->getName() << ": Errors occurred during the calculation of the forces." << std::endl;
             PrintingHandler::printOut(&out, PrintingHandler::STDERR);
-            gsl_vector* vecForceAndMomentum = gsl_vector_alloc(6);
-            gsl_vector_set_all(vecForceAndMomentum,GSL_NAN);
-            return vecForceAndMomentum;
+            for (int i = 0; i < 6; i++)
+                forceAndMoments[i] = GSL_NAN;
+            return errCode;
         }
 
         // Rotate the Force in the relative reference frame
-        // F_rel = Tmain * F
-        gsl_vector_set_zero( F_rel );
-        gsl_blas_dgemv(CblasTrans, 1.0, transformationMatrixMain, F,
-                        0.0, F_rel);
+        // F_rel = Tmain' * F
+        Vec3<T> F_rel = transposeTimes(main.trans, F);
 
         /////// TORQUES
         // Compute the momentum vector
-        this->computeTorques( connectionPointMain, F_rel, M);
+        Vec3<T> M = this->computeTorques(*connectionPointMain, F_rel);
         /////// END TORQUES
 
         // Pack in a unique vector
-        gsl_vector_set(vecForceAndMomentum, 0, gsl_vector_get(F, 0));
-        gsl_vector_set(vecForceAndMomentum, 1, gsl_vector_get(F, 1));
-        gsl_vector_set(vecForceAndMomentum, 2, gsl_vector_get(F, 2));
-        gsl_vector_set(vecForceAndMomentum, 3, gsl_vector_get(M, 0));
-        gsl_vector_set(vecForceAndMomentum, 4, gsl_vector_get(M, 1));
-        gsl_vector_set(vecForceAndMomentum, 5, gsl_vector_get(M, 2));
+        for (int i = 0; i < 3; i++){
+            forceAndMoments[i] = F[i];
+            forceAndMoments[i+3] = M[i];
+        }
 
-        return vecForceAndMomentum;
+        return errCode;
+    }
+
+    int LinkSpring::computeForceAndMoments(RelativeComponentPosition posConnector,
+                const BodyKinematics<double>& main, const BodyKinematics<double>& attached,
+                double forceAndMoments[6]){
+        return this->genericForceAndMoments(posConnector, main, attached, forceAndMoments);
+    }
 
+    int LinkSpring::computeForceAndMoments(RelativeComponentPosition posConnector,
+                const BodyKinematics<ADScalar>& main, const BodyKinematics<ADScalar>& attached,
+                ADScalar forceAndMoments[6]){
+        return this->genericForceAndMoments(posConnector, main, attached, forceAndMoments);
     }
 
     bool LinkSpring::setStaticLoad(double Fg){
@@ -195,6 +170,7 @@ namespace DYTSI_Modelling{
                                             0, 1e-6);
          }
         while (status == GSL_CONTINUE && iter < max_iter);
+        gsl_root_fsolver_free (s);
 
         if ((iter == max_iter)||(status != GSL_SUCCESS)){
            std::stringstream out;
@@ -203,8 +179,8 @@ namespace DYTSI_Modelling{
            return true;
         } else {
             // Set the displacment as additional length in the z direction of the length at rest
-            gsl_vector* disp = gsl_vector_calloc(3);
-            gsl_vector_set(disp,2,r);
+            Vec3<double> disp;
+            disp.set(0.0, 0.0, r);
             this->correctForStaticLoads(disp);
         }
 
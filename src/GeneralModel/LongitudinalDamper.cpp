@@ -45,33 +45,53 @@ namespace DYTSI_Modelling {
     LongitudinalDamper::~LongitudinalDamper() {
     }
 
-    int LongitudinalDamper::force (RelativeComponentPosition posConnector, gsl_vector* speed, gsl_vector* lengthVector, gsl_vector* F){
+    Link* LongitudinalDamper::clone(){
+        return new LongitudinalDamper(this->getBaseName(),
+                this->getConnectionPointUpWRTCenterOfGeometry(),
+                this->getConnectionPointDownWRTCenterOfGeometry(),
+                this->dampingFunction);
+    }
+
+    template<class T>
+    int LongitudinalDamper::genericForce(RelativeComponentPosition posConnector, const T speed[3],
+            const T lengthVector[3], T F[3]){
         int errCode = GSL_SUCCESS;
 
         // Take the vertical component in order to get the direction of the link
         double xAtRest;
         if (posConnector == UP) {
-            xAtRest = gsl_vector_get(this->getVecLowerToUpperAtRest(),0);
+            xAtRest = this->getVecLowerToUpperAtRest()[0];
         } else {
-            xAtRest = -gsl_vector_get(this->getVecLowerToUpperAtRest(),0);
+            xAtRest = -this->getVecLowerToUpperAtRest()[0];
         }
         double signXAtRest = sign(xAtRest);
 
         // The desired component of the speed is taken
-        double velocityMagnitude = gsl_vector_get(speed,0) * signXAtRest;
+        T velocityMagnitude = speed[0] * signXAtRest;
 
         // Compute the resulting magnitude of the force
-        double Fmag;
+        T Fmag;
         errCode = this->dampingFunction->func(velocityMagnitude, Fmag);
         if (errCode != GSL_SUCCESS){
             return errCode;
         }
 
         // Set the force vector
-        gsl_vector_set_zero(F);
-        gsl_vector_set(F,0, Fmag * signXAtRest);
+        for (int i = 0; i < 3; i++)
+            F[i] = 0.0;
+        F[0] = Fmag * signXAtRest;
 
         return errCode;
     }
+
+    int LongitudinalDamper::force (RelativeComponentPosition posConnector, const double speed[3],
+            const double lengthVector[3], double F[3]){
+        return this->genericForce(posConnector, speed, lengthVector, F);
+    }
+
+    int LongitudinalDamper::force (RelativeComponentPosition posConnector, const ADScalar speed[3],
+            const ADScalar lengthVector[3], ADScalar F[3]){
+        return this->genericForce(posConnector, speed, lengthVector, F);
+    }
 }
 
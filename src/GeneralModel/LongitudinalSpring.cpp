@@ -48,40 +48,59 @@ namespace DYTSI_Modelling {
     LongitudinalSpring::~LongitudinalSpring() {
     }
 
-    int LongitudinalSpring::force(RelativeComponentPosition posConnector,
-            gsl_vector* lengthVector, gsl_vector* F){
+    Link* LongitudinalSpring::clone(){
+        return new LongitudinalSpring(this->getBaseName(),
+                this->getConnectionPointUpWRTCenterOfGeometry(),
+                this->getConnectionPointDownWRTCenterOfGeometry(),
+                this->stiffnessFunction);
+    }
+
+    template<class T>
+    int LongitudinalSpring::genericForce(RelativeComponentPosition posConnector,
+            const T lengthVector[3], T F[3]){
         int errCode = GSL_SUCCESS;
 
         // Only the longitudinal component is needed an computed
         double xAtRest;
         if (posConnector == UP) {
-            xAtRest = gsl_vector_get(this->getVecLowerToUpperAtRest(),0);
+            xAtRest = this->getVecLowerToUpperAtRest()[0];
         } else {
-            xAtRest = -gsl_vector_get(this->getVecLowerToUpperAtRest(),0);
+            xAtRest = -this->getVecLowerToUpperAtRest()[0];
         }
 
-        double x = gsl_vector_get(lengthVector,0);
+        T x = lengthVector[0];
 
         // Compute the vertical displacment
-        double dl = fabs(x) - fabs(xAtRest);
+        T dl = fabs(x) - fabs(xAtRest);
 
         // Compute the magnitude of the force
-        double Fmag;
+        T Fmag;
         errCode = this->stiffnessFunction->func(dl, Fmag);
         if (errCode != GSL_SUCCESS){
             return errCode;
         }
 
         // Compute the Force vector
-        gsl_vector_set_zero(F);
+        for (int i = 0; i < 3; i++)
+            F[i] = 0.0;
         if (xAtRest > 0)
-            gsl_vector_set(F,0, Fmag);
+            F[0] = Fmag;
         else
-            gsl_vector_set(F,0, -Fmag);
+            F[0] = -Fmag;
 
         return errCode;
     }
 
+    int LongitudinalSpring::force(RelativeComponentPosition posConnector,
+            const double lengthVector[3], double F[3]){
+        return this->genericForce(posConnector, lengthVector, F);
+    }
+
+    int LongitudinalSpring::force(RelativeComponentPosition posConnector,
+            const ADScalar lengthVector[3], ADScalar F[3]){
+        return this->genericForce(posConnector, lengthVector, F);
+    }
+
     Function* LongitudinalSpring::getStiffnessFunctionZ(){
         return this->stiffnessFunctionZ;
     }
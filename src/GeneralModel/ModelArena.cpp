@@ -0,0 +1,79 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+
+#include "ModelArena.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace DYTSI_Modelling {
+
+    // Alignment of every workspace (cache line) and size of the chunks
+    const size_t ARENA_ALIGN = 64;
+    const size_t ARENA_CHUNK = 64 * 1024;
+
+    ModelArena::ModelArena() {
+        this->chunkUsed = 0;
+        this->chunkSize = 0;
+        this->size = 0;
+    }
+
+    ModelArena::~ModelArena() {
+        this->clear();
+    }
+
+    void ModelArena::clear(){
+        for (unsigned int i = 0; i < this->chunks.size(); i++)
+            free(this->chunks[i]);
+        this->chunks.clear();
+        this->chunkUsed = 0;
+        this->chunkSize = 0;
+        this->size = 0;
+    }
+
+    void* ModelArena::allocateBytes(size_t bytes){
+        bytes = (bytes + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN;
+        if (bytes == 0)
+            bytes = ARENA_ALIGN;
+
+        if ((this->chunks.empty()) || (this->chunkUsed + bytes > this->chunkSize)){
+            // New chunk (large workspaces get a chunk of their own)
+            size_t newSize = (bytes > ARENA_CHUNK) ? bytes : ARENA_CHUNK;
+            void* chunk = NULL;
+            if (posix_memalign(&chunk, ARENA_ALIGN, newSize) != 0)
+                throw std::bad_alloc();
+            memset(chunk, 0, newSize);
+            this->chunks.push_back((char*) chunk);
+            this->chunkUsed = 0;
+            this->chunkSize = newSize;
+        }
+
+        void* p = this->chunks.back() + this->chunkUsed;
+        this->chunkUsed += bytes;
+        this->size += bytes;
+        return p;
+    }
+}
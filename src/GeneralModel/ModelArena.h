@@ -0,0 +1,77 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+
+#ifndef MODELARENA_H
+#define	MODELARENA_H
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace DYTSI_Modelling {
+
+    /**
+     * Scratch memory of the evaluations of a model. The workspaces are carved
+     * out of large aligned chunks when the model is set up (see
+     * GeneralModel::setupWorkspace) and released all together with the model,
+     * so that computeFun and computeJac never touch the heap.
+     * Only types that need no destructor (double, ADScalar) can be allocated.
+     */
+    class ModelArena {
+    public:
+        ModelArena();
+        virtual ~ModelArena();
+
+        // Release all the workspaces
+        void clear();
+
+        // Workspace of n default constructed elements
+        template<class T>
+        T* allocate(int n){
+            T* p = (T*) this->allocateBytes(n * sizeof(T));
+            for (int i = 0; i < n; i++)
+                new (&p[i]) T();
+            return p;
+        }
+
+        // Total size of the workspaces (bytes)
+        size_t getSize(){ return size; }
+
+    private:
+        std::vector<char*> chunks;
+        size_t chunkUsed;
+        size_t chunkSize;
+        size_t size;
+
+        void* allocateBytes(size_t bytes);
+
+        // No copies: the workspaces belong to one model
+        ModelArena(const ModelArena&);
+        ModelArena& operator=(const ModelArena&);
+    };
+}
+
+#endif	/* MODELARENA_H */
@@ -41,32 +41,47 @@ namespace DYTSI_Modelling {
     : InterpolationFunction(PWLVals->getInterpType())
     {
         this->PWLVals = PWLVals;
-        this->acc = gsl_interp_accel_alloc();
-        this->interp = this->allocInterp(PWLVals->getSize());
         double** vals = PWLVals->getVals();
-        gsl_interp_init( this->interp, vals[0], vals[1], PWLVals->getSize());
+        int size = PWLVals->getSize();
+
+        // The gsl interpolant is only used to build the coefficients: the evaluation locates the
+        // interval (arithmetically if the abscissas are equally spaced) and uses these.
+        gsl_interp* interp = this->allocInterp(size);
+        gsl_interp_init( interp, vals[0], vals[1], size);
+        this->coeffs = new double[4*(size-1)];
+        this->polynomialCoefficients(interp, vals[0], vals[1], size, this->coeffs, 4);
+        gsl_interp_free(interp);
+
+        this->setupGrid(vals[0], size);
     }
 
     PieceWiseLinearFunction::~PieceWiseLinearFunction() {
-        gsl_interp_free(this->interp);
-        gsl_interp_accel_free(this->acc);
+        delete[] this->coeffs;
     }
 
     int PieceWiseLinearFunction::func(double val, double &res) {
-        int errCode;
+        int i = this->locate(val);
+        if (i < 0)
+            return GSL_EDOM;
 
-        double** vals = PWLVals->getVals();
-        double* xs = vals[0];
-        double* ys = vals[1];
-        int size = PWLVals->getSize();
-        if (( val >= xs[0] ) && ( val <= xs[size-1] )){
-            res = gsl_interp_eval( this->interp, xs, ys, val, this->acc );
-            errCode = GSL_SUCCESS;
-        } else {
-            errCode = GSL_EDOM;
-        }
+        const double* c = &(this->coeffs[4*i]);
+        double dx = val - PWLVals->getVals()[0][i];
+        res = c[0] + dx*(c[1] + dx*(c[2] + dx*c[3]));
+
+        return GSL_SUCCESS;
+    }
+
+    int PieceWiseLinearFunction::func(double val, double &res, double &dres) {
+        int i = this->locate(val);
+        if (i < 0)
+            return GSL_EDOM;
+
+        const double* c = &(this->coeffs[4*i]);
+        double dx = val - PWLVals->getVals()[0][i];
+        res = c[0] + dx*(c[1] + dx*(c[2] + dx*c[3]));
+        dres = c[1] + dx*(2.0*c[2] + 3.0*dx*c[3]);
 
-        return errCode;
+        return GSL_SUCCESS;
     }
 
     FunctionTypes PieceWiseLinearFunction::getType(){
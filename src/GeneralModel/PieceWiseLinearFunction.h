@@ -48,12 +48,14 @@ namespace DYTSI_Modelling {
         virtual ~PieceWiseLinearFunction();
 
         int func(double val, double &res);
+        int func(double val, double &res, double &dres);
         FunctionTypes getType();
     private:
         InterpolationTypes interpType;
         PieceWiseValues* PWLVals;
-        gsl_interp_accel* acc;
-        gsl_interp* interp;
+        // Coefficients of the interpolant on each interval (4 per interval, see
+        // InterpolationFunction::polynomialCoefficients)
+        double* coeffs;
 
     };
 }
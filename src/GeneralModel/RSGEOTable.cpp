@@ -38,28 +38,36 @@
 
 #include <sstream>
 #include <fstream>
+#include <new>
 #include <math.h>
+#include <stdlib.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 
+#include <gsl/gsl_math.h>
+
 namespace DYTSI_Modelling {
     RSGEOTable::RSGEOTable(InterpolationTypes interpType)
     : InterpolationFunction(interpType) {
         this->loaded = false;
+        this->coeffs = NULL;
+        this->ownCoeffs = false;
+        this->ownTable = false;
     }
 
     RSGEOTable::RSGEOTable(std::string path, InterpolationTypes interpType)
     : InterpolationFunction(interpType) {
+        this->coeffs = NULL;
+        this->ownCoeffs = false;
+        this->ownTable = false;
         this->readRSGEO(path);
     }
 
     RSGEOTable::~RSGEOTable() {
-        if (this->loaded) {
-            for( int i = 1; i < N_COLS_RSGEO; i++ ){
-                gsl_interp_free (interps[i]);
-                gsl_interp_accel_free (accs[i]);
-            }
-        }
+        if (this->ownCoeffs)
+            free((void*) this->coeffs);
+        if (this->ownTable)
+            delete [] this->table;
     }
     
     void RSGEOTable::readRSGEO(std::string pathS){
@@ -122,6 +130,9 @@ namespace DYTSI_Modelling {
     RSGEOTable::RSGEOTable(double** table, int n_rows, int n_cols, double max_displ, InterpolationTypes interpType)
     : InterpolationFunction(interpType)
     {
+        this->coeffs = NULL;
+        this->ownCoeffs = false;
+        this->ownTable = false;
         this->N_COLS_RSGEO = n_cols;
         this->N_ROWS_RSGEO = n_rows;
         this->MAX_DISPL = max_displ;
@@ -139,25 +150,145 @@ namespace DYTSI_Modelling {
         *out << "\t\t\tInterpolating RSGEO\t" << std::flush;
         PrintingHandler::printOut(out,PrintingHandler::STDOUT);
         delete out;
-        accs = (gsl_interp_accel**)malloc(N_COLS_RSGEO*sizeof(gsl_interp_accel*));
-        interps = (gsl_interp**)malloc(N_COLS_RSGEO*sizeof(gsl_interp*));
+        // The gsl interpolants are only used to build the coefficients
+        gsl_interp** interps = (gsl_interp**)malloc(N_COLS_RSGEO*sizeof(gsl_interp*));
         for( int i = 1; i<N_COLS_RSGEO; i++ ){
-          accs[i] = gsl_interp_accel_alloc ();
           interps[i] = this->allocInterp(this->N_ROWS_RSGEO);
-          //interps[i] = gsl_interp_alloc (gsl_interp_cspline, N_ROWS_RSGEO);
           gsl_interp_init(interps[i], table[0], table[i], N_ROWS_RSGEO);
         }
+        this->setupCoefficients(interps);
+        for( int i = 1; i<N_COLS_RSGEO; i++ )
+          gsl_interp_free(interps[i]);
+        free(interps);
         out = new std::stringstream(std::stringstream::in|std::stringstream::out);
         *out << "[DONE]" << std::endl;
         PrintingHandler::printOut(out,PrintingHandler::STDOUT);
         delete out;
     }
 
-    double RSGEOTable::getValue(rsgeo_values col, double x){
-        return ( gsl_interp_eval(this->interps[col], this->table[0], this->table[col], x, this->accs[col]) );
+    RSGEOTable::RSGEOTable(double** table, const double* coeffs, int n_rows, int n_cols, double max_displ,
+            InterpolationTypes interpType)
+    : InterpolationFunction(interpType)
+    {
+        this->N_COLS_RSGEO = n_cols;
+        this->N_ROWS_RSGEO = n_rows;
+        this->MAX_DISPL = max_displ;
+        // Own copy of the column pointers, the columns stay shared
+        this->table = new double*[n_cols];
+        for (int j = 0; j < n_cols; j++)
+            this->table[j] = table[j];
+        this->ownTable = true;
+        this->coeffs = coeffs;
+        this->ownCoeffs = false;
+        this->setupGrid(table[0], N_ROWS_RSGEO);
+
+        this->loaded = true;
+    }
+
+    double RSGEOTable::getValue(rsgeo_values col, double x) const {
+        int i = this->locate(x);
+        if (i < 0)
+            return GSL_NAN;
+        const double* c = &(this->coeffs[((size_t) i * N_COLS_RSGEO + col) * 4]);
+        double dx = x - this->table[0][i];
+        return c[0] + dx*(c[1] + dx*(c[2] + dx*c[3]));
+    }
+
+    double RSGEOTable::getDerivative(rsgeo_values col, double x) const {
+        int i = this->locate(x);
+        if (i < 0)
+            return GSL_NAN;
+        const double* c = &(this->coeffs[((size_t) i * N_COLS_RSGEO + col) * 4]);
+        double dx = x - this->table[0][i];
+        return c[1] + dx*(2.0*c[2] + 3.0*dx*c[3]);
+    }
+
+    void RSGEOTable::setupCoefficients(gsl_interp** interps){
+        // The lateral displacement is usually sampled on a uniform grid
+        this->setupGrid(table[0], N_ROWS_RSGEO);
+
+        size_t bytes = (size_t) (N_ROWS_RSGEO - 1) * N_COLS_RSGEO * 4 * sizeof(double);
+        void* mem = NULL;
+        if (posix_memalign(&mem, 64, bytes) != 0)
+            throw std::bad_alloc();
+        double* c = (double*) mem;
+
+        // Column 0 (the lateral displacement) is not interpolated
+        for (int i = 0; i < N_ROWS_RSGEO - 1; i++)
+            for (int k = 0; k < 4; k++)
+                c[(size_t) i * N_COLS_RSGEO * 4 + k] = 0.0;
+        for (int j = 1; j < N_COLS_RSGEO; j++)
+            this->polynomialCoefficients(interps[j], table[0], table[j], N_ROWS_RSGEO,
+                    &(c[4*j]), N_COLS_RSGEO * 4);
+
+        this->coeffs = c;
+        this->ownCoeffs = true;
+    }
+
+    int RSGEOTable::getValues(double x, double values[], int& hint) const {
+        int i = this->locate(x, hint);
+        values[0] = x;
+        if (i < 0){
+            for (int j = 1; j < N_COLS_RSGEO; j++)
+                values[j] = GSL_NAN;
+            return GSL_EDOM;
+        }
+        double dx = x - this->table[0][i];
+        const double* c = &(this->coeffs[(size_t) i * N_COLS_RSGEO * 4]);
+        for (int j = 1; j < N_COLS_RSGEO; j++){
+            const double* cj = &(c[4*j]);
+            values[j] = cj[0] + dx*(cj[1] + dx*(cj[2] + dx*cj[3]));
+        }
+        return GSL_SUCCESS;
+    }
+
+    int RSGEOTable::getValues(double xLeft, double xRight, double valuesLeft[], double valuesRight[],
+            int& hintLeft, int& hintRight) const {
+        int iL = this->locate(xLeft, hintLeft);
+        int iR = this->locate(xRight, hintRight);
+        if (iL < 0 || iR < 0){
+            this->getValues(xLeft, valuesLeft, hintLeft);
+            this->getValues(xRight, valuesRight, hintRight);
+            return GSL_EDOM;
+        }
+        valuesLeft[0] = xLeft;
+        valuesRight[0] = xRight;
+        double dxL = xLeft - this->table[0][iL];
+        double dxR = xRight - this->table[0][iR];
+        const double* cL = &(this->coeffs[(size_t) iL * N_COLS_RSGEO * 4]);
+        const double* cR = &(this->coeffs[(size_t) iR * N_COLS_RSGEO * 4]);
+        for (int j = 1; j < N_COLS_RSGEO; j++){
+            const double* cjL = &(cL[4*j]);
+            const double* cjR = &(cR[4*j]);
+            valuesLeft[j] = cjL[0] + dxL*(cjL[1] + dxL*(cjL[2] + dxL*cjL[3]));
+            valuesRight[j] = cjR[0] + dxR*(cjR[1] + dxR*(cjR[2] + dxR*cjR[3]));
+        }
+        return GSL_SUCCESS;
+    }
+
+    int RSGEOTable::getValuesAndDerivatives(double x, int nCols, double values[], double derivatives[],
+            int& hint) const {
+        int i = this->locate(x, hint);
+        if (nCols > N_COLS_RSGEO)
+            nCols = N_COLS_RSGEO;
+        values[0] = x;
+        derivatives[0] = 1.0;
+        if (i < 0){
+            for (int j = 1; j < nCols; j++)
+                values[j] = derivatives[j] = GSL_NAN;
+            return GSL_EDOM;
+        }
+        double dx = x - this->table[0][i];
+        const double* c = &(this->coeffs[(size_t) i * N_COLS_RSGEO * 4]);
+        for (int j = 1; j < nCols; j++){
+            const double* cj = &(c[4*j]);
+            values[j] = cj[0] + dx*(cj[1] + dx*(cj[2] + dx*cj[3]));
+            derivatives[j] = cj[1] + dx*(2.0*cj[2] + 3.0*dx*cj[3]);
+        }
+        return GSL_SUCCESS;
     }
 
-    double RSGEOTable::get_MAX_DISPL() {
+    double RSGEOTable::get_MAX_DISPL() const {
         return this->MAX_DISPL;
     }
 }
@@ -54,14 +54,39 @@ namespace DYTSI_Modelling {
         RSGEOTable(InterpolationTypes interpType = INTP_LINEAR);
         RSGEOTable(std::string path, InterpolationTypes interpType = INTP_LINEAR);
         RSGEOTable(double** table, int n_rows, int n_cols, double max_displ, InterpolationTypes interpType = INTP_LINEAR);
+        // Table with precomputed coefficients (e.g. mapped from the binary cache, see
+        // DYTSI_Input::RSGEOTableCache): the columns of table and coeffs are not copied
+        // nor freed, only the array of the column pointers is copied
+        RSGEOTable(double** table, const double* coeffs, int n_rows, int n_cols, double max_displ,
+                InterpolationTypes interpType);
         virtual ~RSGEOTable();
 
-        double getValue(rsgeo_values col, double x);
-
-        int get_N_COLS_RSGEO(){ return N_COLS_RSGEO; }
-        int get_N_ROWS_RSGEO(){ return N_ROWS_RSGEO; }
-
-        double get_MAX_DISPL();
+        // The evaluation does not modify the table, that can be shared by concurrent
+        // simulations (see DYTSI_Input::RSGEOTableRegistry). The per-caller state is the
+        // lookup hint (interval of the previous call), used on non-uniform grids.
+        double getValue(rsgeo_values col, double x) const;
+        double getDerivative(rsgeo_values col, double x) const;
+
+        // Fused evaluation of all the columns at x: the interval is located once and the
+        // columns are evaluated from the interleaved coefficients (values[0] = x).
+        // GSL_EDOM if x is out of the table.
+        int getValues(double x, double values[], int& hint) const;
+        // Same for the left and the right wheel at once
+        int getValues(double xLeft, double xRight, double valuesLeft[], double valuesRight[],
+                int& hintLeft, int& hintRight) const;
+        // Values and derivatives w.r.t. x of the first nCols columns
+        int getValuesAndDerivatives(double x, int nCols, double values[], double derivatives[],
+                int& hint) const;
+
+        int get_N_COLS_RSGEO() const { return N_COLS_RSGEO; }
+        int get_N_ROWS_RSGEO() const { return N_ROWS_RSGEO; }
+
+        double get_MAX_DISPL() const;
+        InterpolationTypes getInterpolationType() const { return this->getInterpType(); }
+
+        // Raw data (columns of the table and interleaved coefficients)
+        const double* const* getTable() const { return table; }
+        const double* getCoefficients() const { return coeffs; }
         
     private:
         bool loaded;
@@ -69,13 +94,17 @@ namespace DYTSI_Modelling {
         int N_COLS_RSGEO;
         int N_ROWS_RSGEO;
         double MAX_DISPL;
-        gsl_interp_accel** accs;
-        gsl_interp** interps;
+        // Coefficients of the interpolants, interleaved by interval: the polynomial of the
+        // column j on the interval i is sum_k coeffs[(i*N_COLS_RSGEO + j)*4 + k] (x - x_i)^k
+        const double* coeffs;
+        bool ownCoeffs;
+        bool ownTable;
 
         // Methods
         void readRSGEO(std::string path);
 
         void interpolate();
+        void setupCoefficients(gsl_interp** interps);
 
     };
 }
@@ -0,0 +1,149 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+
+#ifndef SMALLMATRIX_H
+#define	SMALLMATRIX_H
+
+namespace DYTSI_Modelling {
+
+    /**
+     * Vector of 3 elements of any scalar type (double or Dual), kept on the stack.
+     * Together with Mat3 it replaces the gsl_vector/gsl_matrix of size 3 in the
+     * force pipeline: all the operations are inline and unrolled, so the
+     * evaluation of the links compiles to straight-line code.
+     */
+    template<class T>
+    struct Vec3 {
+        T v[3];
+
+        T& operator[](int i){ return v[i]; }
+        const T& operator[](int i) const { return v[i]; }
+
+        void set(const T& x, const T& y, const T& z){
+            v[0] = x; v[1] = y; v[2] = z;
+        }
+        void setZero(){
+            v[0] = 0.0; v[1] = 0.0; v[2] = 0.0;
+        }
+        // Copy of a vector of another scalar type (e.g. the geometry in doubles)
+        template<class S>
+        void assign(const Vec3<S>& a){
+            v[0] = a[0]; v[1] = a[1]; v[2] = a[2];
+        }
+
+        Vec3& operator+=(const Vec3& a){
+            v[0] += a[0]; v[1] += a[1]; v[2] += a[2];
+            return *this;
+        }
+        Vec3& operator-=(const Vec3& a){
+            v[0] -= a[0]; v[1] -= a[1]; v[2] -= a[2];
+            return *this;
+        }
+        Vec3& operator*=(double s){
+            v[0] *= s; v[1] *= s; v[2] *= s;
+            return *this;
+        }
+    };
+
+    template<class T>
+    inline Vec3<T> operator+(const Vec3<T>& a, const Vec3<T>& b){
+        Vec3<T> c;
+        c[0] = a[0] + b[0]; c[1] = a[1] + b[1]; c[2] = a[2] + b[2];
+        return c;
+    }
+
+    template<class T>
+    inline Vec3<T> operator-(const Vec3<T>& a, const Vec3<T>& b){
+        Vec3<T> c;
+        c[0] = a[0] - b[0]; c[1] = a[1] - b[1]; c[2] = a[2] - b[2];
+        return c;
+    }
+
+    template<class T>
+    inline T dot(const Vec3<T>& a, const Vec3<T>& b){
+        return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+    }
+
+    // Cross product a x b, where a can be a double vector (e.g. a connection point)
+    template<class S, class T>
+    inline Vec3<T> cross(const Vec3<S>& a, const Vec3<T>& b){
+        Vec3<T> c;
+        c[0] = b[2]*a[1] - b[1]*a[2];
+        c[1] = b[0]*a[2] - b[2]*a[0];
+        c[2] = b[1]*a[0] - b[0]*a[1];
+        return c;
+    }
+
+    /**
+     * 3x3 matrix of any scalar type, stored by rows on the stack.
+     */
+    template<class T>
+    struct Mat3 {
+        T m[3][3];
+
+        T* operator[](int i){ return m[i]; }
+        const T* operator[](int i) const { return m[i]; }
+
+        void setZero(){
+            for (int i = 0; i < 3; i++)
+                for (int j = 0; j < 3; j++)
+                    m[i][j] = 0.0;
+        }
+
+        // Skew symmetric matrix of the small rotations phi (x), chi (y) and psi (z)
+        void setSkew(const T& phi, const T& chi, const T& psi){
+            m[0][0] = 0.0;  m[0][1] = -psi; m[0][2] = chi;
+            m[1][0] = psi;  m[1][1] = 0.0;  m[1][2] = -phi;
+            m[2][0] = -chi; m[2][1] = phi;  m[2][2] = 0.0;
+        }
+
+        // Linearized transformation matrix of the small rotations: I + skew
+        void setSmallRotation(const T& phi, const T& chi, const T& psi){
+            this->setSkew(phi, chi, psi);
+            m[0][0] = 1.0; m[1][1] = 1.0; m[2][2] = 1.0;
+        }
+    };
+
+    // a * x, where x can be a double vector
+    template<class T, class S>
+    inline Vec3<T> operator*(const Mat3<T>& a, const Vec3<S>& x){
+        Vec3<T> y;
+        for (int i = 0; i < 3; i++)
+            y[i] = a[i][0]*x[0] + a[i][1]*x[1] + a[i][2]*x[2];
+        return y;
+    }
+
+    // a' * x
+    template<class T>
+    inline Vec3<T> transposeTimes(const Mat3<T>& a, const Vec3<T>& x){
+        Vec3<T> y;
+        for (int i = 0; i < 3; i++)
+            y[i] = a[0][i]*x[0] + a[1][i]*x[1] + a[2][i]*x[2];
+        return y;
+    }
+}
+
+#endif	/* SMALLMATRIX_H */
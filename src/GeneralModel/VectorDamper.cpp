@@ -44,45 +44,59 @@ namespace DYTSI_Modelling {
                 gsl_vector* connectionPointDown, Function* dampingFunction)
     : LinkDamper( name, connectionPointUp, connectionPointDown) {
         this->dampingFunction = dampingFunction;
-        this->u = gsl_vector_alloc(3);
     }
 
     VectorDamper::~VectorDamper() {
     }
 
-    int VectorDamper::force (RelativeComponentPosition posConnector,  gsl_vector* speed, gsl_vector* lengthVector, gsl_vector* F){
+    Link* VectorDamper::clone(){
+        return new VectorDamper(this->getBaseName(),
+                this->getConnectionPointUpWRTCenterOfGeometry(),
+                this->getConnectionPointDownWRTCenterOfGeometry(),
+                this->dampingFunction);
+    }
+
+    template<class T>
+    int VectorDamper::genericForce(RelativeComponentPosition posConnector, const T speed[3],
+            const T lengthVector[3], T F[3]){
 
         int errCode = GSL_SUCCESS;
 
         // Find the Euclidean length of the length vector
-        double lengthMagnitude = gsl_blas_dnrm2(lengthVector);
+        T lengthMagnitude = sqrt(lengthVector[0]*lengthVector[0] +
+                lengthVector[1]*lengthVector[1] + lengthVector[2]*lengthVector[2]);
 
         ////////
         // Project the velocity vector on the working direction of the damper 
-        double dotProdRes;
-        gsl_blas_ddot(speed, lengthVector, &dotProdRes);
-        double velocityMagnitudeN = dotProdRes / lengthMagnitude;
+        T dotProdRes = speed[0]*lengthVector[0] + speed[1]*lengthVector[1] + speed[2]*lengthVector[2];
+        T velocityMagnitudeN = dotProdRes / lengthMagnitude;
         ////////
 
         // Compute the resulting force magnitude
-        double Fmag;
+        T Fmag;
         errCode = this->dampingFunction->func(velocityMagnitudeN, Fmag);
         if (errCode != GSL_SUCCESS)
             return errCode;
 
-        // Compute the direction vector (unit vector) of the speed projected on the
-        // damper's direction
-        if (lengthMagnitude > 0.0){
-            gsl_vector_memcpy(u, lengthVector);
-            gsl_blas_dscal( (1.0/lengthMagnitude), u );
-        } else {
-            gsl_vector_set_zero(u);
+        // Compute the Force vector for this damper, along the direction vector (unit vector)
+        // of the speed projected on the damper's direction
+        for (int i = 0; i < 3; i++){
+            if (lengthMagnitude > 0.0)
+                F[i] = Fmag * (lengthVector[i] / lengthMagnitude);
+            else
+                F[i] = 0.0;
         }
 
-        // Compute the Force vector for this damper
-        gsl_vector_memcpy( F, u );
-        gsl_blas_dscal( Fmag, F );
-
         return errCode;
     }
+
+    int VectorDamper::force (RelativeComponentPosition posConnector, const double speed[3],
+            const double lengthVector[3], double F[3]){
+        return this->genericForce(posConnector, speed, lengthVector, F);
+    }
+
+    int VectorDamper::force (RelativeComponentPosition posConnector, const ADScalar speed[3],
+            const ADScalar lengthVector[3], ADScalar F[3]){
+        return this->genericForce(posConnector, speed, lengthVector, F);
+    }
 }
@@ -34,51 +34,64 @@
 #include "VectorSpring.h"
 #include "Function.h"
 
-#include <gsl/gsl_blas.h>
-
 namespace DYTSI_Modelling {
     VectorSpring::VectorSpring(std::string name, gsl_vector* connectionPointUp,
             gsl_vector* connectionPointDown, Function* stiffnessFunction)
     : LinkSpring(name, connectionPointUp, connectionPointDown) {
         this->stiffnessFunction = stiffnessFunction;
-        this->u = gsl_vector_alloc(3);
     }
 
     VectorSpring::~VectorSpring() {
     }
 
-    int VectorSpring::force( RelativeComponentPosition posConnector,
-                gsl_vector* lengthVector, gsl_vector* F ){
+    Link* VectorSpring::clone(){
+        return new VectorSpring(this->getBaseName(),
+                this->getConnectionPointUpWRTCenterOfGeometry(),
+                this->getConnectionPointDownWRTCenterOfGeometry(),
+                this->stiffnessFunction);
+    }
+
+    template<class T>
+    int VectorSpring::genericForce( RelativeComponentPosition posConnector,
+                const T lengthVector[3], T F[3] ){
         int errCode = GSL_SUCCESS;
 
         // Find the Euclidean length
-        double euclideanLength = gsl_blas_dnrm2(lengthVector);
+        T euclideanLength = sqrt(lengthVector[0]*lengthVector[0] +
+                lengthVector[1]*lengthVector[1] + lengthVector[2]*lengthVector[2]);
 
         // Find the Euclidean length at rest
-        double lengthAtRest = gsl_blas_dnrm2(this->getVecLowerToUpperAtRest());
+        const Vec3<double>& vecAtRest = this->getVecLowerToUpperAtRest();
+        double lengthAtRest = sqrt(dot(vecAtRest, vecAtRest));
 
         // Find the deformation of the spring
-        double dl = euclideanLength - lengthAtRest;
+        T dl = euclideanLength - lengthAtRest;
 
         // Compute the force function (stretching is positive) -> the force is positive
         // but will be projected on the length direction
-        double Fmag;
+        T Fmag;
         errCode = this->stiffnessFunction->func(dl, Fmag);
         if ( errCode != GSL_SUCCESS ){
             return errCode;
         }
 
-        // Compute the direction vector (unit vector)
-        gsl_vector_memcpy(u, lengthVector);
-        gsl_blas_dscal( (1.0/euclideanLength), u );
-
-        // Compute the Force vector for this spring
-        gsl_vector_memcpy( F, u );
-        gsl_blas_dscal( Fmag, F );
+        // Compute the Force vector for this spring, along the direction vector (unit vector)
+        for (int i = 0; i < 3; i++)
+            F[i] = Fmag * (lengthVector[i] / euclideanLength);
 
         return errCode;
     }
 
+    int VectorSpring::force(RelativeComponentPosition posConnector,
+            const double lengthVector[3], double F[3]){
+        return this->genericForce(posConnector, lengthVector, F);
+    }
+
+    int VectorSpring::force(RelativeComponentPosition posConnector,
+            const ADScalar lengthVector[3], ADScalar F[3]){
+        return this->genericForce(posConnector, lengthVector, F);
+    }
+
     Function* VectorSpring::getStiffnessFunctionZ(){
         return this->stiffnessFunction;
     }
@@ -43,16 +43,21 @@ namespace DYTSI_Modelling {
             gsl_vector* connectionPointDown, Function* stiffnessFunction);
 
         virtual ~VectorSpring();
+        Link* clone();
 
         int force(RelativeComponentPosition posConnector,
-                gsl_vector* lengthVector, gsl_vector* F);
+                const double lengthVector[3], double F[3]);
+        int force(RelativeComponentPosition posConnector,
+                const ADScalar lengthVector[3], ADScalar F[3]);
 
         Function* getStiffnessFunctionZ();
         
     private:
-        Function* stiffnessFunction;
+        template<class T>
+        int genericForce(RelativeComponentPosition posConnector,
+                const T lengthVector[3], T F[3]);
 
-        gsl_vector* u;
+        Function* stiffnessFunction;
     };
 }
 
@@ -45,32 +45,52 @@ namespace DYTSI_Modelling {
     VerticalDamper::~VerticalDamper() {
     }
 
-    int VerticalDamper::force (RelativeComponentPosition posConnector, gsl_vector* speed, gsl_vector* lengthVector, gsl_vector* F){
+    Link* VerticalDamper::clone(){
+        return new VerticalDamper(this->getBaseName(),
+                this->getConnectionPointUpWRTCenterOfGeometry(),
+                this->getConnectionPointDownWRTCenterOfGeometry(),
+                this->dampingFunction);
+    }
+
+    template<class T>
+    int VerticalDamper::genericForce(RelativeComponentPosition posConnector, const T speed[3],
+            const T lengthVector[3], T F[3]){
         int errCode = GSL_SUCCESS;
 
         // Take the vertical component in order to get the direction of the link
         double zAtRest;
         if (posConnector == UP) {
-            zAtRest = gsl_vector_get(this->getVecLowerToUpperAtRest(),2);
+            zAtRest = this->getVecLowerToUpperAtRest()[2];
         } else {
-            zAtRest = -gsl_vector_get(this->getVecLowerToUpperAtRest(),2);
+            zAtRest = -this->getVecLowerToUpperAtRest()[2];
         }
         double signZAtRest = sign(zAtRest);
 
         // The desired component of the speed is taken
-        double velocityMagnitude = gsl_vector_get(speed,2) * signZAtRest;
+        T velocityMagnitude = speed[2] * signZAtRest;
 
         // Compute the resulting magnitude of the force
-        double Fmag;
+        T Fmag;
         errCode = this->dampingFunction->func(velocityMagnitude, Fmag);
         if (errCode != GSL_SUCCESS){
             return errCode;
         }
 
         // Set the force vector
-        gsl_vector_set_zero(F);
-        gsl_vector_set(F, 2, Fmag*signZAtRest );
+        for (int i = 0; i < 3; i++)
+            F[i] = 0.0;
+        F[2] = Fmag*signZAtRest;
 
         return errCode;
     }
+
+    int VerticalDamper::force (RelativeComponentPosition posConnector, const double speed[3],
+            const double lengthVector[3], double F[3]){
+        return this->genericForce(posConnector, speed, lengthVector, F);
+    }
+
+    int VerticalDamper::force (RelativeComponentPosition posConnector, const ADScalar speed[3],
+            const ADScalar lengthVector[3], ADScalar F[3]){
+        return this->genericForce(posConnector, speed, lengthVector, F);
+    }
 }
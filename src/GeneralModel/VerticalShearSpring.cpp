@@ -48,27 +48,36 @@ namespace DYTSI_Modelling {
     VerticalShearSpring::~VerticalShearSpring() {
     }
 
-    int VerticalShearSpring::force(RelativeComponentPosition posConnector,
-            gsl_vector* lengthVector, gsl_vector* F){
+    Link* VerticalShearSpring::clone(){
+        return new VerticalShearSpring(this->getBaseName(),
+                this->getConnectionPointUpWRTCenterOfGeometry(),
+                this->getConnectionPointDownWRTCenterOfGeometry(),
+                this->stiffnessFunctionZ, this->stiffnessFunctionXY);
+    }
+
+    template<class T>
+    int VerticalShearSpring::genericForce(RelativeComponentPosition posConnector,
+            const T lengthVector[3], T F[3]){
         int errCode = GSL_SUCCESS;
 
-        gsl_vector_set_zero(F);
+        for (int i = 0; i < 3; i++)
+            F[i] = 0.0;
 
         // VERTICAL COMPONENT
         double zAtRest;
         if (posConnector == UP) {
-            zAtRest = gsl_vector_get(this->getVecLowerToUpperAtRest(),2);
+            zAtRest = this->getVecLowerToUpperAtRest()[2];
         } else {
-            zAtRest = -gsl_vector_get(this->getVecLowerToUpperAtRest(),2);
+            zAtRest = -this->getVecLowerToUpperAtRest()[2];
         }
 
-        double z = gsl_vector_get(lengthVector,2);
+        T z = lengthVector[2];
 
         // Compute the vertical displacment
-        double dl = fabs(z) - fabs(zAtRest);
+        T dl = fabs(z) - fabs(zAtRest);
 
         // Compute the magnitude of the force and set its direction in the direction of z
-        double Fmag;
+        T Fmag;
         errCode = this->stiffnessFunctionZ->func(dl, Fmag);
         if (errCode != GSL_SUCCESS){
             return errCode;
@@ -76,41 +85,41 @@ namespace DYTSI_Modelling {
 
         // Set vertical component of the force vector
         if (zAtRest > 0)
-            gsl_vector_set(F,2,Fmag);
+            F[2] = Fmag;
         else
-            gsl_vector_set(F,2,-Fmag);
+            F[2] = -Fmag;
 
         // HORIZONTAL COMPONENT
         // Get the horizontal vector
-        gsl_vector_view hF_view = gsl_vector_subvector(F,0,2);
-        gsl_vector* hF = &hF_view.vector;
-        gsl_vector* hDisp = gsl_vector_alloc(2);
-        double xDisp = gsl_vector_get(lengthVector,0);
-        double yDisp = gsl_vector_get(lengthVector,1);
-        gsl_vector_set(hDisp,0,xDisp);
-        gsl_vector_set(hDisp,1,yDisp);
+        T xDisp = lengthVector[0];
+        T yDisp = lengthVector[1];
         // Compute euclidean norm
-        double hl = gsl_blas_dnrm2(hDisp);
+        T hl = sqrt(xDisp*xDisp + yDisp*yDisp);
         // Compute the force magnitude
-        double hFmag;
+        T hFmag;
         errCode = this->stiffnessFunctionXY->func(hl, hFmag);
         if (errCode != GSL_SUCCESS){
             return errCode;
         }
-        // Compute unit vector
+        // Compute unit vector and project the force
         if (hl>1e-13) {
-            gsl_blas_dscal((1.0/hl), hDisp);
-            // Project the force
-            gsl_vector_memcpy(hF, hDisp);
-            gsl_blas_dscal(hFmag, hF);
+            F[0] = hFmag * (xDisp / hl);
+            F[1] = hFmag * (yDisp / hl);
         }
 
-        // Free memory
-        gsl_vector_free(hDisp);
-
         return errCode;
     }
 
+    int VerticalShearSpring::force(RelativeComponentPosition posConnector,
+            const double lengthVector[3], double F[3]){
+        return this->genericForce(posConnector, lengthVector, F);
+    }
+
+    int VerticalShearSpring::force(RelativeComponentPosition posConnector,
+            const ADScalar lengthVector[3], ADScalar F[3]){
+        return this->genericForce(posConnector, lengthVector, F);
+    }
+
     Function* VerticalShearSpring::getStiffnessFunctionZ(){
         return this->stiffnessFunctionZ;
     }
@@ -47,39 +47,58 @@ namespace DYTSI_Modelling {
     VerticalSpring::~VerticalSpring() {
     }
 
-    int VerticalSpring::force(RelativeComponentPosition posConnector,
-            gsl_vector* lengthVector, gsl_vector* F){
+    Link* VerticalSpring::clone(){
+        return new VerticalSpring(this->getBaseName(),
+                this->getConnectionPointUpWRTCenterOfGeometry(),
+                this->getConnectionPointDownWRTCenterOfGeometry(),
+                this->stiffnessFunction);
+    }
+
+    template<class T>
+    int VerticalSpring::genericForce(RelativeComponentPosition posConnector,
+            const T lengthVector[3], T F[3]){
         int errCode = GSL_SUCCESS;
 
         // Only the vertical component is needed an computed
         double zAtRest;
         if (posConnector == UP) {
-            zAtRest = gsl_vector_get(this->getVecLowerToUpperAtRest(),2);
+            zAtRest = this->getVecLowerToUpperAtRest()[2];
         } else {
-            zAtRest = -gsl_vector_get(this->getVecLowerToUpperAtRest(),2);
+            zAtRest = -this->getVecLowerToUpperAtRest()[2];
         }
 
-        double z = gsl_vector_get(lengthVector,2);
+        T z = lengthVector[2];
 
         // Compute the vertical displacment
-        double dl = fabs(z) - fabs(zAtRest);
+        T dl = fabs(z) - fabs(zAtRest);
 
         // Compute the magnitude of the force and set its direction in the direction of z
-        double Fmag;
+        T Fmag;
         errCode = this->stiffnessFunction->func(dl, Fmag);
         if (errCode != GSL_SUCCESS)
             return errCode;
 
         // Compute the Force vector
-        gsl_vector_set_zero(F);
+        for (int i = 0; i < 3; i++)
+            F[i] = 0.0;
         if (zAtRest > 0)
-            gsl_vector_set(F,2,Fmag);
+            F[2] = Fmag;
         else
-            gsl_vector_set(F,2,-Fmag);
+            F[2] = -Fmag;
 
         return errCode;
     }
 
+    int VerticalSpring::force(RelativeComponentPosition posConnector,
+            const double lengthVector[3], double F[3]){
+        return this->genericForce(posConnector, lengthVector, F);
+    }
+
+    int VerticalSpring::force(RelativeComponentPosition posConnector,
+            const ADScalar lengthVector[3], ADScalar F[3]){
+        return this->genericForce(posConnector, lengthVector, F);
+    }
+
     Function* VerticalSpring::getStiffnessFunctionZ(){
         return this->stiffnessFunction;
     }
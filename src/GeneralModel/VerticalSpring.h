@@ -42,13 +42,20 @@ namespace DYTSI_Modelling {
         VerticalSpring(std::string name, gsl_vector* connectionPointUp,
             gsl_vector* connectionPointDown, Function* stiffnessFunction);
         virtual ~VerticalSpring();
+        Link* clone();
 
         int force(RelativeComponentPosition posConnector,
-                gsl_vector* lengthVector, gsl_vector* F);
+                const double lengthVector[3], double F[3]);
+        int force(RelativeComponentPosition posConnector,
+                const ADScalar lengthVector[3], ADScalar F[3]);
 
         Function* getStiffnessFunctionZ();
 
     private:
+        template<class T>
+        int genericForce(RelativeComponentPosition posConnector,
+                const T lengthVector[3], T F[3]);
+
         Function* stiffnessFunction;
     };
 }
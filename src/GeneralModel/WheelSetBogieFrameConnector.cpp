@@ -44,4 +44,9 @@ namespace DYTSI_Modelling {
     WheelSetBogieFrameConnector::~WheelSetBogieFrameConnector() {
     }
 
+    Connector* WheelSetBogieFrameConnector::clone(Component* upper, Component* lower,
+                RelativeComponentPosition posLower){
+        return new WheelSetBogieFrameConnector(this->getName(), upper, lower, UP, posLower);
+    }
+
 }
@@ -49,6 +49,9 @@ namespace DYTSI_Modelling {
                 RelativeComponentPosition posSecond );
         virtual ~WheelSetBogieFrameConnector();
 
+        Connector* clone(Component* upper, Component* lower,
+                RelativeComponentPosition posLower);
+
     private:
         
     };
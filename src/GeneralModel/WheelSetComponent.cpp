@@ -47,17 +47,20 @@
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_vector.h>
-#include <gsl/gsl_blas.h>
 
 #include <math.h>
 #include <sstream>
 #include <stdio.h>
 #include <vector>
+#include <algorithm>
 
 const double g = 9.82;
 
 const double MIN_RSGEO_NORMAL = 1.0;
 
+// Relative deviation tolerated between analytic and numerical Jacobian (JAC_CHECK mode)
+const double JAC_CHECK_TOL = 1e-4;
+
 namespace DYTSI_Modelling {
     const std::string* WheelSetComponent::DOF_Names[N_DOF] = {      //new std::string("X"), new std::string("XDOT"),
                                                                     new std::string("Y"), new std::string("YDOT"),
@@ -89,7 +92,7 @@ namespace DYTSI_Modelling {
             double mu,
             double G,
             ExternalComponents* externalComponents,
-            std::vector<RSGEOTable*> rsgeo_table_list,
+            std::vector<const RSGEOTable*> rsgeo_table_list,
             std::string name,
             GeneralModel* gm,
             bool isFixed)
@@ -105,10 +108,12 @@ namespace DYTSI_Modelling {
         this->mu = mu;
         this->G = G;
         this->rsgeo_table_list = rsgeo_table_list;
+        this->rsgeoHint[LEFT] = 0;
+        this->rsgeoHint[RIGHT] = 0;
 
         // TODO consistent dimensions between RSGEO tables not checked
         // TODO The zero table is considered to be the one active at rest
-        RSGEOTable* table = rsgeo_table_list[0]; 
+        const RSGEOTable* table = rsgeo_table_list[0];
         this->MAX_DISPL = table->get_MAX_DISPL();
 
         // Allocate structures for the Contact point computations
@@ -120,22 +125,6 @@ namespace DYTSI_Modelling {
         // Set r0 the rolling radius at displacement 0
         this->r0 = table->getValue(DYTSI_Modelling::RSGEOTable::RSG_Kwz,0.0);
 
-        // Allocation of the Transformation matrices
-        this->locTransformationMatrix = gsl_matrix_calloc(3,3);
-        for ( int i = 0; i < 3; i++ ) gsl_matrix_set(this->locTransformationMatrix,i,i,1.0);
-        this->locDTransformationMatrix = gsl_matrix_calloc(3,3);
-        this->upTransformationMatrix = gsl_matrix_calloc(3,3);
-        for ( int i = 0; i < 3; i++ ) gsl_matrix_set(this->upTransformationMatrix,i,i,1.0);
-        this->upDTransformationMatrix = gsl_matrix_calloc(3,3);
-        // Allocation of the displacement vectors
-        this->locDisp = gsl_vector_calloc(3);
-        this->locDDisp = gsl_vector_calloc(3);
-        this->upDisp = gsl_vector_calloc(3);
-        this->upDDisp = gsl_vector_calloc(3);
-
-        // Aux vectors
-        this->vecForceAndMoment = gsl_vector_alloc(6);
-
         ///////////////////////////////////////////////////////
         // Set up interdependencies for the numerical Jacobian
         this->partialJacobianIdx.clear();
@@ -154,7 +143,11 @@ namespace DYTSI_Modelling {
         this->partialJacobianIdx.push_back(this->get_startingDOF()+PSIDOT);
         /////////////////////////////
 
+        this->wsConn = NULL;
         this->recalc = true;
+        this->contactsBegin = 0;
+        this->contactsEnd = 0;
+        this->contactsReady = false;
     }
 
     WheelSetComponent::~WheelSetComponent() {
@@ -291,17 +284,9 @@ namespace DYTSI_Modelling {
         this->locY = &(y[this->get_startingDOF()]);
         this->upY = &(y[this->bogieFrame->get_startingDOF()]);
 
-        // Update the transformation matrices
-        this->updateTransformationMatrix(this->locTransformationMatrix, y);
-        this->updateDTransformationMatrix(this->locDTransformationMatrix, y);
-        this->bogieFrame->updateTransformationMatrix(this->upTransformationMatrix, y);
-        this->bogieFrame->updateDTransformationMatrix(this->upDTransformationMatrix, y);
-
-        // Prepare the displacement vectors for the upper connector
-        this->updateDisplacementVector(this->locDisp, y);
-        this->updateDDisplacementVector(this->locDDisp, y);
-        this->bogieFrame->updateDisplacementVector(this->upDisp, y);
-        this->bogieFrame->updateDDisplacementVector(this->upDDisp, y);
+        // Update the displacements and rotations of the wheelset and of the bogie frame
+        this->kinematics(y, this->locKin);
+        this->bogieFrame->kinematics(y, this->upKin);
 
         // Compute the contact forces
         errCode = this->find_contact_forces(t);
@@ -310,10 +295,12 @@ namespace DYTSI_Modelling {
         errCode = this->computeConnectorsForcesAndMoments();
 
         // Compute Gravitational forces and moments
-        gsl_vector* gravitationalForceAndMoment = this->computeGravitationalForceAndMoment();
+        double gravitationalForceAndMoment[6];
+        this->computeGravitationalForceAndMoment(gravitationalForceAndMoment);
 
         // Compute Centrifugal forces and moments
-        gsl_vector* centrifugalForceAndMoment = this->computeCentrifugalForceAndMoment();
+        double centrifugalForceAndMoment[6];
+        this->computeCentrifugalForceAndMoment(centrifugalForceAndMoment);
         ///////////////////////////////
 
         // Output the tangential forces forces
@@ -333,28 +320,28 @@ namespace DYTSI_Modelling {
         }
 
         // Output the Connector forces
-        status[pos++] = gsl_vector_get(this->connectorsForcesAndMoments,0);
-        status[pos++] = gsl_vector_get(this->connectorsForcesAndMoments,1);
-        status[pos++] = gsl_vector_get(this->connectorsForcesAndMoments,2);
-        status[pos++] = gsl_vector_get(this->connectorsForcesAndMoments,3);
-        status[pos++] = gsl_vector_get(this->connectorsForcesAndMoments,4);
-        status[pos++] = gsl_vector_get(this->connectorsForcesAndMoments,5);
+        status[pos++] = this->connectorsForcesAndMoments[0];
+        status[pos++] = this->connectorsForcesAndMoments[1];
+        status[pos++] = this->connectorsForcesAndMoments[2];
+        status[pos++] = this->connectorsForcesAndMoments[3];
+        status[pos++] = this->connectorsForcesAndMoments[4];
+        status[pos++] = this->connectorsForcesAndMoments[5];
 
         // Output the Gravitational Forces and Moments
-        status[pos++] = gsl_vector_get(gravitationalForceAndMoment,0);
-        status[pos++] = gsl_vector_get(gravitationalForceAndMoment,1);
-        status[pos++] = gsl_vector_get(gravitationalForceAndMoment,2);
-        status[pos++] = gsl_vector_get(gravitationalForceAndMoment,3);
-        status[pos++] = gsl_vector_get(gravitationalForceAndMoment,4);
-        status[pos++] = gsl_vector_get(gravitationalForceAndMoment,5);
+        status[pos++] = gravitationalForceAndMoment[0];
+        status[pos++] = gravitationalForceAndMoment[1];
+        status[pos++] = gravitationalForceAndMoment[2];
+        status[pos++] = gravitationalForceAndMoment[3];
+        status[pos++] = gravitationalForceAndMoment[4];
+        status[pos++] = gravitationalForceAndMoment[5];
 
         // Output the Centrifugal Forces and Moments
-        status[pos++] = gsl_vector_get(centrifugalForceAndMoment,0);
-        status[pos++] = gsl_vector_get(centrifugalForceAndMoment,1);
-        status[pos++] = gsl_vector_get(centrifugalForceAndMoment,2);
-        status[pos++] = gsl_vector_get(centrifugalForceAndMoment,3);
-        status[pos++] = gsl_vector_get(centrifugalForceAndMoment,4);
-        status[pos++] = gsl_vector_get(centrifugalForceAndMoment,5);
+        status[pos++] = centrifugalForceAndMoment[0];
+        status[pos++] = centrifugalForceAndMoment[1];
+        status[pos++] = centrifugalForceAndMoment[2];
+        status[pos++] = centrifugalForceAndMoment[3];
+        status[pos++] = centrifugalForceAndMoment[4];
+        status[pos++] = centrifugalForceAndMoment[5];
     }
 
     const double* WheelSetComponent::getCurrentY(){
@@ -417,11 +404,30 @@ namespace DYTSI_Modelling {
 
     void WheelSetComponent::init(){
         this->rhs_counter = 0;
+        this->jac_check_counter = 0;
+        this->jac_check_failures = 0;
+    }
+
+    Component* WheelSetComponent::clone(GeneralModel* gm, ExternalComponents* externalComponents){
+        // The tables are shared with the copy (their evaluation does not modify them)
+        return new WheelSetComponent(this->position,
+                this->getCenterOfGeometry(), this->getCenterOfMassWRTCenterOfGeometry(),
+                this->mass, this->Ix, this->Iy, this->Iz, this->a, this->mu, this->G,
+                externalComponents, this->rsgeo_table_list, this->get_baseName(), gm, this->get_isFixed());
+    }
+
+    void WheelSetComponent::setupWorkspace(ModelArena* arena){
+        Component::setupWorkspace(arena);
+        this->wsConn = arena->allocate<double>(6 * this->partialJacobianIdx.size());
+        this->contactKernel.setup(arena, this->getMaxContacts());
     }
 
     std::string WheelSetComponent::printCounters(){
         std::stringstream out(std::stringstream::in|std::stringstream::out);
         out << this->get_name() << ": RHS evaluations \t" << this->rhs_counter << std::endl;
+        if (this->jac_check_counter > 0)
+            out << this->get_name() << ": Jacobian checks (failed) \t" << this->jac_check_counter
+                    << " (" << this->jac_check_failures << ")" << std::endl;
         std::string outStr = out.str();
         return outStr;
     }
@@ -483,104 +489,37 @@ namespace DYTSI_Modelling {
         // Jacobian initialization
         gsl_matrix_set_zero(&sub_dfdy.matrix);
 
-        // Jacobian: Numerical part
-        for (std::vector<int>::iterator iter = this->partialJacobianIdx.begin();
-                iter != this->partialJacobianIdx.end(); ++iter){
-            errCode = this->jac_numerical(t,y,&sub_dfdy.matrix,*iter);
-            if (errCode != GSL_SUCCESS)
-                return errCode;
+        // Jacobian: Analytic part
+        switch (this->get_generalModel()->getJacobianMode()){
+            case JAC_ANALYTIC:
+            case JAC_AUTOMATIC:
+                return this->jac_analytic(t, y, &sub_dfdy.matrix);
+            case JAC_CHECK:
+                errCode = this->jac_analytic(t, y, &sub_dfdy.matrix);
+                if (errCode != GSL_SUCCESS)
+                    return errCode;
+                return this->jac_check(t, y, &sub_dfdy.matrix);
+            default:
+                break;
         }
 
-        return GSL_SUCCESS;
-    }
-
-    void WheelSetComponent::updateTransformationMatrix( gsl_matrix* mat, const double y[]){
-        gsl_matrix_set(mat, 0, 1, -y[this->get_startingDOF()+PSI]);
-        gsl_matrix_set(mat, 1, 0, y[this->get_startingDOF()+PSI]);
-        gsl_matrix_set(mat, 1, 2, -y[this->get_startingDOF()+PHI]);
-        gsl_matrix_set(mat, 2, 1, y[this->get_startingDOF()+PHI]);
-    }
-
-    void WheelSetComponent::updateDTransformationMatrix( gsl_matrix* mat, const double y[]){
-        gsl_matrix_set(mat, 0, 1, -y[this->get_startingDOF()+PSIDOT]);
-        gsl_matrix_set(mat, 1, 0, y[this->get_startingDOF()+PSIDOT]);
-        gsl_matrix_set(mat, 1, 2, -y[this->get_startingDOF()+PHIDOT]);
-        gsl_matrix_set(mat, 2, 1, y[this->get_startingDOF()+PHIDOT]);
-    }
-
-    void WheelSetComponent::updateDisplacementVector(gsl_vector* vec, const double y[]){
-//        gsl_vector_set(vec, 0, y[this->get_startingDOF()+X]);
-        gsl_vector_set(vec, 0, 0.0);
-        gsl_vector_set(vec, 1, y[this->get_startingDOF()+Y]);
-        gsl_vector_set(vec, 2, y[this->get_startingDOF()+Z]);
-    }
-
-    void WheelSetComponent::updateDDisplacementVector(gsl_vector* vec, const double y[]){
-//        gsl_vector_set(vec, 0, y[this->get_startingDOF()+XDOT]);
-        gsl_vector_set(vec, 0, 0.0);
-        gsl_vector_set(vec, 1, y[this->get_startingDOF()+YDOT]);
-        gsl_vector_set(vec, 2, y[this->get_startingDOF()+ZDOT]);
-    }
-
-    void WheelSetComponent::updateTransformationMatrix( gsl_matrix* mat, double y[]){
-        gsl_matrix_set(mat, 0, 1, -y[this->get_startingDOF()+PSI]);
-        gsl_matrix_set(mat, 1, 0, y[this->get_startingDOF()+PSI]);
-        gsl_matrix_set(mat, 1, 2, -y[this->get_startingDOF()+PHI]);
-        gsl_matrix_set(mat, 2, 1, y[this->get_startingDOF()+PHI]);
-    }
-
-    void WheelSetComponent::updateDTransformationMatrix( gsl_matrix* mat, double y[]){
-        gsl_matrix_set(mat, 0, 1, -y[this->get_startingDOF()+PSIDOT]);
-        gsl_matrix_set(mat, 1, 0, y[this->get_startingDOF()+PSIDOT]);
-        gsl_matrix_set(mat, 1, 2, -y[this->get_startingDOF()+PHIDOT]);
-        gsl_matrix_set(mat, 2, 1, y[this->get_startingDOF()+PHIDOT]);
-    }
-
-    void WheelSetComponent::updateDisplacementVector(gsl_vector* vec, double y[]){
-//        gsl_vector_set(vec, 0, y[this->get_startingDOF()+X]);
-        gsl_vector_set(vec, 0, 0.0);
-        gsl_vector_set(vec, 1, y[this->get_startingDOF()+Y]);
-        gsl_vector_set(vec, 2, y[this->get_startingDOF()+Z]);
-    }
-
-    void WheelSetComponent::updateDDisplacementVector(gsl_vector* vec, double y[]){
-//        gsl_vector_set(vec, 0, y[this->get_startingDOF()+XDOT]);
-        gsl_vector_set(vec, 0, 0.0);
-        gsl_vector_set(vec, 1, y[this->get_startingDOF()+YDOT]);
-        gsl_vector_set(vec, 2, y[this->get_startingDOF()+ZDOT]);
+        // Jacobian: Numerical part
+        return this->jac_numerical(t,y,&sub_dfdy.matrix);
     }
 
     int WheelSetComponent::computeConnectorsForcesAndMoments(){
-        int errCode = GSL_SUCCESS;
-
-        // Initialize the sum of forces and moments
-        gsl_vector_set_zero(this->connectorsForcesAndMoments);
-
-        // Computation of forces and moments for the upper connector
-        gsl_vector* fm = this->connector->getForcesAndMoments( UP,
-                this->locDisp, this->upDisp, this->locDDisp, this->upDDisp,
-                this->locTransformationMatrix, this->upTransformationMatrix,
-                this->locDTransformationMatrix, this->upDTransformationMatrix,
-                errCode);
-        if (errCode != GSL_SUCCESS){
-            return errCode;
-        }
-
-        // Add to the total forces and moments
-        gsl_blas_daxpy(1.0, fm, this->connectorsForcesAndMoments);
-
-        //gsl_vector_free(fm);
-
-        return errCode;
+        // Computation of forces and moments for the upper connector (the only connector)
+        return this->connector->getForcesAndMoments(UP, this->locKin, this->upKin,
+                this->connectorsForcesAndMoments);
     }
 
-    gsl_vector* WheelSetComponent::computeCentrifugalForceAndMoment( ){
+    void WheelSetComponent::computeCentrifugalForceAndMoment( double forceAndMoment[6] ){
         double val;
 
         // Get the nominal position of the body
-        double l = gsl_vector_get(this->getCenterOfMass(),0);
-        double b = gsl_vector_get(this->getCenterOfMass(),1);
-        double h = gsl_vector_get(this->getCenterOfMass(),2);
+        double l = this->getCenterOfMass()[0];
+        double b = this->getCenterOfMass()[1];
+        double h = this->getCenterOfMass()[2];
 
         // Get the external components
         double v = this->getExternalComponents()->get_v();
@@ -593,7 +532,7 @@ namespace DYTSI_Modelling {
         double Omega = v/this->r0 + this->locY[BETA];
 
 //        // Set the x component
-        gsl_vector_set(vecForceAndMoment,0,0.0);
+        forceAndMoment[0] = 0.0;
 
         // Set the y component
 //        val = this->get_mass() * (
@@ -601,7 +540,7 @@ namespace DYTSI_Modelling {
 //                (h + this->locY[Z]) * sin_Phi_se * cos_Phi_se * vv / RR +
 //                (b + this->locY[Y]) * cos_Phi_se * cos_Phi_se * vv / RR );
         val = this->get_mass() * cos_Phi_se * vv / R;
-        gsl_vector_set(vecForceAndMoment,1,val);
+        forceAndMoment[1] = val;
 
         // Set the z component
 //        val = this->get_mass() * (
@@ -609,7 +548,7 @@ namespace DYTSI_Modelling {
 //                (h + this->locY[Z]) * sin_Phi_se * sin_Phi_se * vv / RR -
 //                (b + this->locY[Y]) * sin_Phi_se * cos_Phi_se * vv / RR);
         val = - this->get_mass() * sin_Phi_se *  vv / R;
-        gsl_vector_set(vecForceAndMoment,2,val);
+        forceAndMoment[2] = val;
 
         // Set the phi component
         val =   this->get_Ix() * (
@@ -618,7 +557,7 @@ namespace DYTSI_Modelling {
                      - Omega * cos_Phi_se * v / R +
                     Omega * this->locY[PSIDOT] );
 //        val = 0.0;
-        gsl_vector_set(vecForceAndMoment,3,val);
+        forceAndMoment[3] = val;
 
         // Set the chi component
 //        val =   this->get_Iy() * this->locY[PHIDOT] * cos_Phi_se * v / R +
@@ -626,117 +565,31 @@ namespace DYTSI_Modelling {
 //                    -this->locY[PHIDOT] * cos_Phi_se * v / R -
 //                    this->locY[PSIDOT] * this->locY[PHIDOT] );
         val = 0.0;
-        gsl_vector_set(vecForceAndMoment,4,val);
+        forceAndMoment[4] = val;
 
         // Set the psi component
         val =   (this->get_Ix() - this->get_Iy()) * (
                      this->locY[PHIDOT] * Omega);
 //        val = 0.0;
-        gsl_vector_set(vecForceAndMoment,5,val);
+        forceAndMoment[5] = val;
 
-        return vecForceAndMoment;
     }
 
     int WheelSetComponent::find_contact_forces(double t){
         int errCode = GSL_SUCCESS;
 
         if (this->recalc){
-            this->c_forces[LEFT][FX] = .0;
-            this->c_forces[LEFT][FY] = .0;
-            this->c_forces[LEFT][FZ] = .0;
-            this->c_forces[RIGHT][FX] = .0;
-            this->c_forces[RIGHT][FY] = .0;
-            this->c_forces[RIGHT][FZ] = .0;
-            this->n_forces[LEFT][NY] = .0;
-            this->n_forces[LEFT][NZ] = .0;
-            this->n_forces[RIGHT][NY] = .0;
-            this->n_forces[RIGHT][NZ] = .0;
-            this->torques[LEFT][TPHI] = .0;
-            this->torques[LEFT][TCHI] = .0;
-            this->torques[LEFT][TPSI] = .0;
-            this->torques[RIGHT][TPHI] = .0;
-            this->torques[RIGHT][TCHI] = .0;
-            this->torques[RIGHT][TPSI] = .0;
-
-            // For each table available (for each contact point on the wheel)
-            for (std::vector<RSGEOTable*>::iterator itRSGEO = this->rsgeo_table_list.begin(); itRSGEO != this->rsgeo_table_list.end(); ++itRSGEO) {
-                RSGEOTable* rsg = *itRSGEO;
-
-                double N[2];
-                double delta[2];
-                double cforces[2];
-                double Fcreepx;
-                double Fcreepy;
-                double psi; // Wheelset yaw angle
-                double phi; // Wheelset roll angle
-
-                errCode = this->find_rsgeodata(t,rsg);
-                if (errCode != GSL_SUCCESS){
+            // Evaluate the contacts of this wheelset, unless they have been evaluated
+            // with all the others (see GeneralModel::evaluateContacts)
+            if (!this->contactsReady){
+                this->contactKernel.clear();
+                errCode = this->gatherContacts(t, this->locY - this->get_startingDOF(), &this->contactKernel);
+                if (errCode != GSL_SUCCESS)
                     return errCode;
-                }
-
-                psi = this->locY[PSI];
-                phi = this->locY[PHI];
-
-                N[LEFT] = this->rsgeodata[LEFT][DYTSI_Modelling::RSGEOTable::RSG_N];
-                N[RIGHT] = this->rsgeodata[RIGHT][DYTSI_Modelling::RSGEOTable::RSG_N];
-
-                // If there are contact point data on the current table
-                if (N[LEFT] > MIN_RSGEO_NORMAL){
-                    delta[LEFT] = this->rsgeodata[LEFT][DYTSI_Modelling::RSGEOTable::RSG_angle];
-                    // Creep forces LEFT
-                    errCode = this->SHE(t,LEFT,cforces);
-                    if (errCode != GSL_SUCCESS)
-                        return errCode;
-                    Fcreepx = cforces[0];
-                    Fcreepy = cforces[1];
-                    double Flx = Fcreepx-Fcreepy*psi*cos(delta[LEFT]);
-                    double Fly = Fcreepx*psi + Fcreepy*cos(delta[LEFT]+phi);
-                    double Flz = Fcreepy*sin(delta[LEFT]+phi);
-                    this->c_forces[LEFT][FX] += Flx;
-                    this->c_forces[LEFT][FY] += Fly;
-                    this->c_forces[LEFT][FZ] += Flz;
-                    // Normal forces LEFT
-                    double Nly = -N[LEFT]*sin(delta[LEFT]+phi);
-                    double Nlz = N[LEFT]*cos(delta[LEFT]+phi);
-                    this->n_forces[LEFT][NY] += Nly;
-                    this->n_forces[LEFT][NZ] += Nlz;
-                    // Torques
-                    double al = this->rsgeodata[LEFT][RSGEOTable::RSG_Kwy];
-                    double rl = this->rsgeodata[LEFT][RSGEOTable::RSG_Kwz];
-                    this->torques[LEFT][TPHI] += al * (Flz+Nlz -(Fly + Nly)*phi);
-                    this->torques[LEFT][TCHI] += - rl * (Flx + (Fly + Nly)*psi);
-                    this->torques[LEFT][TPSI] += - al * (Flx + (Fly + Nly)*psi);
-                }
-
-                // If there are contact point data in the current table
-                if (N[RIGHT] > MIN_RSGEO_NORMAL){
-                    delta[RIGHT] = this->rsgeodata[RIGHT][DYTSI_Modelling::RSGEOTable::RSG_angle];
-                    // Creep forces RIGHT
-                    errCode = this->SHE(t,RIGHT,cforces);
-                    if (errCode != GSL_SUCCESS)
-                        return errCode;
-                    Fcreepx = cforces[0];
-                    Fcreepy = cforces[1];
-                    double Frx = Fcreepx-Fcreepy*psi*cos(delta[RIGHT]);
-                    double Fry = Fcreepx*psi + Fcreepy*cos(delta[RIGHT]-phi);
-                    double Frz = -Fcreepy*sin(delta[RIGHT]-phi);
-                    this->c_forces[RIGHT][FX] += Frx;
-                    this->c_forces[RIGHT][FY] += Fry;
-                    this->c_forces[RIGHT][FZ] += Frz;
-                    // Normal forces RIGHT
-                    double Nry = N[RIGHT]*sin(delta[RIGHT]-phi);
-                    double Nrz = N[RIGHT]*cos(delta[RIGHT]-phi);
-                    this->n_forces[RIGHT][NY] += Nry;
-                    this->n_forces[RIGHT][NZ] += Nrz;
-                    // Torques
-                    double ar = this->rsgeodata[RIGHT][RSGEOTable::RSG_Kwy];
-                    double rr = this->rsgeodata[RIGHT][RSGEOTable::RSG_Kwz];
-                    this->torques[RIGHT][TPHI] += -ar* (Frz+Nrz -(Fry + Nry)*phi);
-                    this->torques[RIGHT][TCHI] += -rr * (Frx + (Fry + Nry)*psi);
-                    this->torques[RIGHT][TPSI] += ar * (Frx + (Fry + Nry)*locY[PSI]);
-                }
+                this->contactKernel.evaluate();
+                this->scatterContacts(&this->contactKernel);
             }
+            this->contactsReady = false;
 
             // Check for NaN values
             if (    isnan(this->c_forces[LEFT][FX]) || isnan(this->c_forces[LEFT][FY]) || isnan(this->c_forces[LEFT][FZ]) ||
@@ -762,7 +615,7 @@ namespace DYTSI_Modelling {
         return errCode;
     }
 
-    int WheelSetComponent::find_rsgeodata(double t, RSGEOTable* rsg){
+    int WheelSetComponent::find_rsgeodata(double t, const RSGEOTable* rsg){
         double lat_disp[2];
         double roll[2];
         double N[2];
@@ -782,13 +635,13 @@ namespace DYTSI_Modelling {
         roll[LEFT] = this->locY[PHI];
         roll[RIGHT] = - this->locY[PHI];
 
-        // Interpolation performed in class DYTSI_Modelling::RSGEOTable
-        this->rsgeodata[LEFT][0] = lat_disp[LEFT];
-        this->rsgeodata[RIGHT][0] = lat_disp[RIGHT];
-        for( int i = 1; i < rsg->get_N_COLS_RSGEO(); i++ ){
-            rsgeodata[LEFT][i] = rsg->getValue((RSGEOTable::rsgeo_values)i,lat_disp[LEFT]);
-            rsgeodata[RIGHT][i] = rsg->getValue((RSGEOTable::rsgeo_values)i,lat_disp[RIGHT]);
-        }
+        // Interpolation performed in class DYTSI_Modelling::RSGEOTable (all the columns of
+        // both wheels in one lookup)
+        int errCode = rsg->getValues(lat_disp[LEFT], lat_disp[RIGHT],
+                this->rsgeodata[LEFT], this->rsgeodata[RIGHT],
+                this->rsgeoHint[LEFT], this->rsgeoHint[RIGHT]);
+        if (errCode != GSL_SUCCESS)
+            return errCode;
 
         N[LEFT] = rsgeodata[LEFT][DYTSI_Modelling::RSGEOTable::RSG_N];
         N[RIGHT] = rsgeodata[RIGHT][DYTSI_Modelling::RSGEOTable::RSG_N];
@@ -812,42 +665,116 @@ namespace DYTSI_Modelling {
         return GSL_SUCCESS;
     }
 
-    int WheelSetComponent::SHE(double t, int wheel, double *out){
-        double norm_F_tau; // 2-norm of tangential force on the contact plane
-        double epsilon; // Reduction coeff.
-        double Fx_val; // Creep force wrt the contact system
-        double Fy_val; // Creep force wrt the contact system
-        double cp_a, cp_b; // Semi axes of the contact ellipse
-        double C11, C22, C23; // Kalker's creepage coeff.
-        double xi_x, xi_y, xi_s; // Longitudinal, Lateral and Spin creep
-        double radius; // Rolling radius
-        double aw; // Distance from the contact point
-        double delta; // Angle wheel axle-contact plane
-        double N; // Normal force
-
-        // Load data from RSGEO
-        N = rsgeodata[wheel][DYTSI_Modelling::RSGEOTable::RSG_N];
-        cp_a = rsgeodata[wheel][DYTSI_Modelling::RSGEOTable::RSG_a];
-        cp_b = rsgeodata[wheel][DYTSI_Modelling::RSGEOTable::RSG_b];
-        C11 = rsgeodata[wheel][DYTSI_Modelling::RSGEOTable::RSG_C11];
-        C22 = rsgeodata[wheel][DYTSI_Modelling::RSGEOTable::RSG_C22];
-        C23 = rsgeodata[wheel][DYTSI_Modelling::RSGEOTable::RSG_C23];
-        radius = rsgeodata[wheel][DYTSI_Modelling::RSGEOTable::RSG_Kwz];
-        aw = rsgeodata[wheel][DYTSI_Modelling::RSGEOTable::RSG_Kwy];
-        delta = rsgeodata[wheel][DYTSI_Modelling::RSGEOTable::RSG_angle];
+    /**
+     * Append the contacts of the wheels (for each RSGEO table, the wheels in contact)
+     * to the batch, with the data interpolated from the tables and updated by the
+     * penetration (see find_rsgeodata).
+     */
+    int WheelSetComponent::gatherContacts(double t, const double y[], ContactKernel* kernel){
+        // Set up shortcuts
+        this->bogieFrame = (DYTSI_Modelling::BogieFrameComponent*)this->getUpper()->getComponent();
+        this->locY = &(y[this->get_startingDOF()]);
+
+        this->contactsBegin = kernel->getNumberOfContacts();
+        this->contactsEnd = this->contactsBegin;
+
+        // Derailments are reported by the evaluation of the right hand side
+        if ( fabs(locY[Y]) > MAX_DISPL )
+            return GSL_EDOM;
+
+        double v = this->getExternalComponents()->get_v();
+        double R = this->getExternalComponents()->get_R();
+        double phi_se = this->getExternalComponents()->get_Phi_se();
+        double b = (this->position == LEADING) ? this->bogieFrame->get_b() : -this->bogieFrame->get_b();
+        double yaw = this->locY[PSI] + b/R;
+        double cant = this->get_a()*cos(phi_se)/R;
+        double spin = v/this->r0 + this->locY[BETA];
+
+        for (std::vector<const RSGEOTable*>::const_iterator itRSGEO = this->rsgeo_table_list.begin(); itRSGEO != this->rsgeo_table_list.end(); ++itRSGEO) {
+            int errCode = this->find_rsgeodata(t, *itRSGEO);
+            if (errCode != GSL_SUCCESS)
+                return errCode;
+
+            for (int wheel = LEFT; wheel <= RIGHT; wheel++){
+                const double* data = this->rsgeodata[wheel];
+                // If there are contact point data on the current table
+                if (data[RSGEOTable::RSG_N] <= MIN_RSGEO_NORMAL)
+                    continue;
+                int i = kernel->add();
+                if (i < 0)
+                    return GSL_ENOMEM;
+                kernel->get(ContactKernel::CK_SIDE)[i] = (wheel == LEFT) ? 1.0 : -1.0;
+                kernel->get(ContactKernel::CK_V)[i] = v;
+                kernel->get(ContactKernel::CK_YAW)[i] = yaw;
+                kernel->get(ContactKernel::CK_CANT)[i] = cant;
+                kernel->get(ContactKernel::CK_SPIN)[i] = spin;
+                kernel->get(ContactKernel::CK_PSI)[i] = this->locY[PSI];
+                kernel->get(ContactKernel::CK_PSIDOT)[i] = this->locY[PSIDOT];
+                kernel->get(ContactKernel::CK_PHI)[i] = this->locY[PHI];
+                kernel->get(ContactKernel::CK_PHIDOT)[i] = this->locY[PHIDOT];
+                kernel->get(ContactKernel::CK_YDOT)[i] = this->locY[YDOT];
+                kernel->get(ContactKernel::CK_ZDOT)[i] = this->locY[ZDOT];
+                kernel->get(ContactKernel::CK_RADIUS)[i] = data[RSGEOTable::RSG_Kwz];
+                kernel->get(ContactKernel::CK_AW)[i] = data[RSGEOTable::RSG_Kwy];
+                kernel->get(ContactKernel::CK_DELTA)[i] = data[RSGEOTable::RSG_angle];
+                kernel->get(ContactKernel::CK_N)[i] = data[RSGEOTable::RSG_N];
+                kernel->get(ContactKernel::CK_A)[i] = data[RSGEOTable::RSG_a];
+                kernel->get(ContactKernel::CK_B)[i] = data[RSGEOTable::RSG_b];
+                kernel->get(ContactKernel::CK_C11)[i] = data[RSGEOTable::RSG_C11];
+                kernel->get(ContactKernel::CK_C22)[i] = data[RSGEOTable::RSG_C22];
+                kernel->get(ContactKernel::CK_C23)[i] = data[RSGEOTable::RSG_C23];
+                kernel->get(ContactKernel::CK_G)[i] = this->get_G();
+                kernel->get(ContactKernel::CK_MU)[i] = this->get_mu();
+            }
+        }
+
+        this->contactsEnd = kernel->getNumberOfContacts();
+        return GSL_SUCCESS;
+    }
+
+    /**
+     * Sum the forces and torques of the contacts of the wheelset evaluated by the kernel.
+     */
+    void WheelSetComponent::scatterContacts(ContactKernel* kernel){
+        for (int wheel = LEFT; wheel <= RIGHT; wheel++){
+            this->c_forces[wheel][FX] = .0;
+            this->c_forces[wheel][FY] = .0;
+            this->c_forces[wheel][FZ] = .0;
+            this->n_forces[wheel][NY] = .0;
+            this->n_forces[wheel][NZ] = .0;
+            this->torques[wheel][TPHI] = .0;
+            this->torques[wheel][TCHI] = .0;
+            this->torques[wheel][TPSI] = .0;
+        }
 
+        const double* side = kernel->get(ContactKernel::CK_SIDE);
+        for (int i = this->contactsBegin; i < this->contactsEnd; i++){
+            int wheel = (side[i] > 0) ? LEFT : RIGHT;
+            this->c_forces[wheel][FX] += kernel->get(ContactKernel::CK_FX)[i];
+            this->c_forces[wheel][FY] += kernel->get(ContactKernel::CK_FY)[i];
+            this->c_forces[wheel][FZ] += kernel->get(ContactKernel::CK_FZ)[i];
+            this->n_forces[wheel][NY] += kernel->get(ContactKernel::CK_NY)[i];
+            this->n_forces[wheel][NZ] += kernel->get(ContactKernel::CK_NZ)[i];
+            this->torques[wheel][TPHI] += kernel->get(ContactKernel::CK_TPHI)[i];
+            this->torques[wheel][TCHI] += kernel->get(ContactKernel::CK_TCHI)[i];
+            this->torques[wheel][TPSI] += kernel->get(ContactKernel::CK_TPSI)[i];
+        }
+        this->contactsReady = true;
+    }
+
+    void WheelSetComponent::creepages(int wheel, double radius, double aw, double delta, double xi[3]){
         switch (this->position){
             case LEADING:
                 switch (wheel){
                 case LEFT:
-                    xi_x = xi_flx(locY[PSI],locY[PSIDOT],locY[PHIDOT],locY[YDOT],locY[BETA], radius, aw);
-                    xi_y = xi_fly(locY[PSI],locY[PHI],locY[PHIDOT],locY[YDOT],locY[ZDOT], radius, aw, delta);
-                    xi_s = xi_fls(locY[PSI],locY[PSIDOT],locY[PHIDOT],locY[BETA], delta);
+                    xi[0] = xi_flx(locY[PSI],locY[PSIDOT],locY[PHIDOT],locY[YDOT],locY[BETA], radius, aw);
+                    xi[1] = xi_fly(locY[PSI],locY[PHI],locY[PHIDOT],locY[YDOT],locY[ZDOT], radius, aw, delta);
+                    xi[2] = xi_fls(locY[PSI],locY[PSIDOT],locY[PHIDOT],locY[BETA], delta);
                   break;
                 case RIGHT:
-                    xi_x = xi_frx(locY[PSI],locY[PSIDOT],locY[PHIDOT],locY[YDOT],locY[BETA], radius, aw);
-                    xi_y = xi_fry(locY[PSI],locY[PHI],locY[PHIDOT],locY[YDOT],locY[ZDOT], radius, aw, delta);
-                    xi_s = xi_frs(locY[PSI],locY[PSIDOT],locY[PHIDOT],locY[BETA], delta);
+                    xi[0] = xi_frx(locY[PSI],locY[PSIDOT],locY[PHIDOT],locY[YDOT],locY[BETA], radius, aw);
+                    xi[1] = xi_fry(locY[PSI],locY[PHI],locY[PHIDOT],locY[YDOT],locY[ZDOT], radius, aw, delta);
+                    xi[2] = xi_frs(locY[PSI],locY[PSIDOT],locY[PHIDOT],locY[BETA], delta);
                   break;
                 }
                 break;
@@ -855,38 +782,19 @@ namespace DYTSI_Modelling {
             case TRAILING:
                 switch (wheel){
                 case LEFT:
-                    xi_x = xi_rlx(locY[PSI],locY[PSIDOT],locY[PHIDOT],locY[YDOT],locY[BETA], radius, aw);
-                    xi_y = xi_rly(locY[PSI],locY[PHI],locY[PHIDOT],locY[YDOT],locY[ZDOT], radius, aw, delta);
-                    xi_s = xi_rls(locY[PSI],locY[PSIDOT],locY[PHIDOT],locY[BETA], delta);
+                    xi[0] = xi_rlx(locY[PSI],locY[PSIDOT],locY[PHIDOT],locY[YDOT],locY[BETA], radius, aw);
+                    xi[1] = xi_rly(locY[PSI],locY[PHI],locY[PHIDOT],locY[YDOT],locY[ZDOT], radius, aw, delta);
+                    xi[2] = xi_rls(locY[PSI],locY[PSIDOT],locY[PHIDOT],locY[BETA], delta);
                   break;
                 case RIGHT:
-                    xi_x = xi_rrx(locY[PSI],locY[PSIDOT],locY[PHIDOT],locY[YDOT],locY[BETA], radius, aw);
-                    xi_y = xi_rry(locY[PSI],locY[PHI],locY[PHIDOT],locY[YDOT],locY[ZDOT], radius, aw, delta);
-                    xi_s = xi_rrs(locY[PSI],locY[PSIDOT],locY[PHIDOT],locY[BETA], delta);
+                    xi[0] = xi_rrx(locY[PSI],locY[PSIDOT],locY[PHIDOT],locY[YDOT],locY[BETA], radius, aw);
+                    xi[1] = xi_rry(locY[PSI],locY[PHI],locY[PHIDOT],locY[YDOT],locY[ZDOT], radius, aw, delta);
+                    xi[2] = xi_rrs(locY[PSI],locY[PSIDOT],locY[PHIDOT],locY[BETA], delta);
                   break;
                 }
                 break;
         } // end switch
-
-        if (N == 0){
-            out[0] = 0;
-            out[1] = 0;
-        } else {
-            Fx_val = Fx(cp_a,cp_b,C11,xi_x);
-            Fy_val = Fy(cp_a,cp_b,C22,C23,xi_y,xi_s);
-            double norm_F_tau_ping = sqrt(pow(Fx_val,2.0)+pow(Fy_val,2.0));
-            double u = (norm_F_tau_ping/(this->mu*N));
-            if (u<3)
-              norm_F_tau = this->mu*N*(u - 1.0/3.0*pow(u,2.0) + 1.0/27.0*pow(u,3.0));
-            else
-              norm_F_tau = this->mu*N;
-            epsilon = norm_F_tau / norm_F_tau_ping;
-            out[0] = epsilon*Fx_val;
-            out[1] = epsilon*Fy_val;
-        }
-
-        return GSL_SUCCESS;
-    } // End SHE
+    }
 
     int WheelSetComponent::rhs(double t, const double y[], gsl_matrix* outRHS){
         int errCode = GSL_SUCCESS;
@@ -904,17 +812,9 @@ namespace DYTSI_Modelling {
         this->locY = &(y[this->get_startingDOF()]);
         this->upY = &(y[this->bogieFrame->get_startingDOF()]);
 
-        // Update the transformation matrices
-        this->updateTransformationMatrix(this->locTransformationMatrix, y);
-        this->updateDTransformationMatrix(this->locDTransformationMatrix, y);
-        this->bogieFrame->updateTransformationMatrix(this->upTransformationMatrix, y);
-        this->bogieFrame->updateDTransformationMatrix(this->upDTransformationMatrix, y);
-
-        // Prepare the displacement vectors for the upper connector
-        this->updateDisplacementVector(this->locDisp, y);
-        this->updateDDisplacementVector(this->locDDisp, y);
-        this->bogieFrame->updateDisplacementVector(this->upDisp, y);
-        this->bogieFrame->updateDDisplacementVector(this->upDDisp, y);
+        // Update the displacements and rotations of the wheelset and of the bogie frame
+        this->kinematics(y, this->locKin);
+        this->bogieFrame->kinematics(y, this->upKin);
 
         // Check for derailment
         // Check for derailment of the wheelset
@@ -939,10 +839,12 @@ namespace DYTSI_Modelling {
         }
 
         // Compute Gravitational forces and moments
-        gsl_vector* gravitationalForceAndMoment = this->computeGravitationalForceAndMoment();
+        double gravitationalForceAndMoment[6];
+        this->computeGravitationalForceAndMoment(gravitationalForceAndMoment);
 
         // Compute Centrifugal forces and moments
-        gsl_vector* centrifugalForceAndMoment = this->computeCentrifugalForceAndMoment();
+        double centrifugalForceAndMoment[6];
+        this->computeCentrifugalForceAndMoment(centrifugalForceAndMoment);
 
         using namespace DYTSI_Modelling;
 
@@ -955,9 +857,9 @@ namespace DYTSI_Modelling {
 //            double Flx = this->c_forces[LEFT][FX];
 //
 //            double out = (Frx + Flx +
-//                            gsl_vector_get(this->connectorsForcesAndMoments,0) +
-//                            gsl_vector_get(gravitationalForceAndMoment, 0) +
-//                            gsl_vector_get(centrifugalForceAndMoment, 0)) / this->mass;
+//                            this->connectorsForcesAndMoments[0] +
+//                            gravitationalForceAndMoment[0] +
+//                            centrifugalForceAndMoment[0]) / this->mass;
 //            gsl_matrix_set(outRHS,XDOT,0,out);
 //        }
 
@@ -972,9 +874,9 @@ namespace DYTSI_Modelling {
             double Nry = this->n_forces[RIGHT][NY];
 
             double out = (Fly + Fry + Nly + Nry + 
-                            gsl_vector_get(this->connectorsForcesAndMoments, 1) +
-                            gsl_vector_get(gravitationalForceAndMoment, 1) +
-                            gsl_vector_get(centrifugalForceAndMoment, 1)) / this->mass;
+                            this->connectorsForcesAndMoments[1] +
+                            gravitationalForceAndMoment[1] +
+                            centrifugalForceAndMoment[1]) / this->mass;
             gsl_matrix_set(outRHS, YDOT, 0, out);
         }
 
@@ -989,9 +891,9 @@ namespace DYTSI_Modelling {
             double Nrz = this->n_forces[RIGHT][NZ];
 
             double out = (Flz + Frz + Nlz + Nrz + 
-                            gsl_vector_get(this->connectorsForcesAndMoments, 2) +
-                            gsl_vector_get(gravitationalForceAndMoment, 2) +
-                            gsl_vector_get(centrifugalForceAndMoment, 2)) / this->mass;
+                            this->connectorsForcesAndMoments[2] +
+                            gravitationalForceAndMoment[2] +
+                            centrifugalForceAndMoment[2]) / this->mass;
             gsl_matrix_set(outRHS, ZDOT, 0, out);
         }
 
@@ -1004,9 +906,9 @@ namespace DYTSI_Modelling {
             double Tl = this->torques[LEFT][TPSI];
 
             double out = ( Tr + Tl +
-                            gsl_vector_get(this->connectorsForcesAndMoments, 5) +
-                            gsl_vector_get(gravitationalForceAndMoment, 5) +
-                            gsl_vector_get(centrifugalForceAndMoment, 5) ) / this->Iz;
+                            this->connectorsForcesAndMoments[5] +
+                            gravitationalForceAndMoment[5] +
+                            centrifugalForceAndMoment[5] ) / this->Iz;
             gsl_matrix_set(outRHS, PSIDOT, 0, out);
         }
 
@@ -1019,9 +921,9 @@ namespace DYTSI_Modelling {
             double Tl = this->torques[LEFT][TPHI];
 
             double out = ( Tr + Tl +
-                            gsl_vector_get(this->connectorsForcesAndMoments, 3) +
-                            gsl_vector_get(gravitationalForceAndMoment, 3) +
-                            gsl_vector_get(centrifugalForceAndMoment, 3) ) / this->Ix;
+                            this->connectorsForcesAndMoments[3] +
+                            gravitationalForceAndMoment[3] +
+                            centrifugalForceAndMoment[3] ) / this->Ix;
             gsl_matrix_set(outRHS, PHIDOT, 0, out);
         };
 
@@ -1074,13 +976,397 @@ namespace DYTSI_Modelling {
 
         N0 = this->rsgeodata[wheel][RSGEOTable::RSG_N];
         q0 = this->rsgeodata[wheel][RSGEOTable::RSG_qN];
-        N = N0*pow(1+dq/q0,1.5); if (isnan(N)) N = 0;
-        N3 = pow(N/N0,1.0/3.0);
+        double ratio = 1+dq/q0;
+        N = N0*ratio*sqrt(ratio); if (isnan(N)) N = 0;
+        N3 = cbrt(N/N0);
         this->rsgeodata[wheel][RSGEOTable::RSG_a] *= N3;
         this->rsgeodata[wheel][RSGEOTable::RSG_b] *= N3;
         this->rsgeodata[wheel][RSGEOTable::RSG_N] = N;
     }
 
+    /**
+     * Closed form Jacobian of the wheelset equations.
+     * The contact forces are differentiated through the RSGEO interpolants, the
+     * penetration (dynamic_aux), the creepages, Kalker's linear forces and the
+     * Shen-Hedrick-Elkins saturation. The connector forces depend on the links of
+     * the suspension and are differentiated automatically (see connector_partials).
+     */
+    int WheelSetComponent::jac_analytic(double t, const double y[], gsl_matrix* J){
+        int errCode = GSL_SUCCESS;
+        int start = this->get_startingDOF();
+
+        // Set the locY and uY to the startingDOF of the current wheelset and the bogie frame
+        this->locY = &(y[start]);
+        this->upY = &(y[this->bogieFrame->get_startingDOF()]);
+
+        // Check for derailment of the wheelset
+        if ( fabs(locY[Y]) > MAX_DISPL ){
+            std::stringstream* out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+            *out << this->get_name() << ": Derailment detected!" << std::endl;
+            *out << "Current displacement: " << locY[Y] << std::endl;
+            PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+            delete out;
+            return GSL_EDOM;
+        }
+
+        // Partials of the contact forces and torques
+        double dFY[N_DOF], dFZ[N_DOF], dTPHI[N_DOF], dTCHI[N_DOF], dTPSI[N_DOF];
+        for (int k = 0; k < N_DOF; k++){
+            dFY[k] = .0; dFZ[k] = .0; dTPHI[k] = .0; dTCHI[k] = .0; dTPSI[k] = .0;
+        }
+        for (std::vector<const RSGEOTable*>::const_iterator itRSGEO = this->rsgeo_table_list.begin(); itRSGEO != this->rsgeo_table_list.end(); ++itRSGEO) {
+            errCode = this->contact_partials(*itRSGEO, LEFT, dFY, dFZ, dTPHI, dTCHI, dTPSI);
+            if (errCode != GSL_SUCCESS)
+                return errCode;
+            errCode = this->contact_partials(*itRSGEO, RIGHT, dFY, dFZ, dTPHI, dTCHI, dTPSI);
+            if (errCode != GSL_SUCCESS)
+                return errCode;
+        }
+
+        // Partials of the centrifugal moments (see computeCentrifugalForceAndMoment)
+        double v = this->getExternalComponents()->get_v();
+        double R = this->getExternalComponents()->get_R();
+        double cos_Phi_se = this->getExternalComponents()->get_cos_Phi_se();
+        double Omega = v/this->r0 + this->locY[BETA];
+        double dCent[6][N_DOF];
+        for (int i = 0; i < 6; i++)
+            for (int k = 0; k < N_DOF; k++)
+                dCent[i][k] = .0;
+        dCent[3][BETA] = - this->get_Ix() * cos_Phi_se * v / R +
+                (this->get_Iy() - this->get_Iz()) * (- cos_Phi_se * v / R + this->locY[PSIDOT]);
+        dCent[3][PSIDOT] = (this->get_Iy() - this->get_Iz()) * Omega;
+        dCent[5][PHIDOT] = (this->get_Ix() - this->get_Iy()) * Omega;
+        dCent[5][BETA] = (this->get_Ix() - this->get_Iy()) * this->locY[PHIDOT];
+
+        // Kinematic equations
+        gsl_matrix_set(J, Y, start+YDOT, 1.0);
+        gsl_matrix_set(J, Z, start+ZDOT, 1.0);
+        gsl_matrix_set(J, PSI, start+PSIDOT, 1.0);
+        gsl_matrix_set(J, PHI, start+PHIDOT, 1.0);
+
+        // Dynamic equations (see rhs). The gravitational forces are constant, the
+        // columns of the bogie frame only enter through the connector.
+        double* dConnAll = this->wsConn;
+        errCode = this->connector_partials(y, dConnAll);
+        if (errCode != GSL_SUCCESS){
+            return errCode;
+        }
+        for (std::vector<int>::iterator iter = this->partialJacobianIdx.begin();
+                iter != this->partialJacobianIdx.end(); ++iter){
+            const double* dConn = &dConnAll[6*(iter - this->partialJacobianIdx.begin())];
+            int k = *iter - start;
+            if ((k < 0) || (k >= N_DOF)){
+                gsl_matrix_set(J, YDOT, *iter, dConn[1] / this->mass);
+                gsl_matrix_set(J, ZDOT, *iter, dConn[2] / this->mass);
+                gsl_matrix_set(J, PSIDOT, *iter, dConn[5] / this->Iz);
+                gsl_matrix_set(J, PHIDOT, *iter, dConn[3] / this->Ix);
+                continue;
+            }
+            gsl_matrix_set(J, YDOT, *iter, (dFY[k] + dConn[1] + dCent[1][k]) / this->mass);
+            gsl_matrix_set(J, ZDOT, *iter, (dFZ[k] + dConn[2] + dCent[2][k]) / this->mass);
+            gsl_matrix_set(J, PSIDOT, *iter, (dTPSI[k] + dConn[5] + dCent[5][k]) / this->Iz);
+            gsl_matrix_set(J, PHIDOT, *iter, (dTPHI[k] + dConn[3] + dCent[3][k]) / this->Ix);
+            gsl_matrix_set(J, BETA, *iter, dTCHI[k] / this->Iy);
+        }
+
+        return GSL_SUCCESS;
+    }
+
+    /**
+     * Add the partials of the contact forces on one wheel, for one RSGEO table, to the
+     * partials of the lateral and vertical forces and of the torques.
+     * It follows find_rsgeodata, dynamic_aux, ContactKernel::evaluate and find_contact_forces, where the right
+     * wheel uses the mirrored lateral displacement and roll angle (s = -1).
+     */
+    int WheelSetComponent::contact_partials(const RSGEOTable* rsg, int wheel, double dFY[], double dFZ[],
+            double dTPHI[], double dTCHI[], double dTPSI[]){
+        double s = (wheel == LEFT) ? 1.0 : -1.0;
+        double lat = s * this->locY[Y];
+        double roll = s * this->locY[PHI];
+        double phi = this->locY[PHI];
+        double psi = this->locY[PSI];
+
+        // RSGEO data and their partials w.r.t. Y (derivatives of the interpolants)
+        double val[RSGEOTable::RSG_Kry];
+        double val_Y[RSGEOTable::RSG_Kry];
+        int errCode = rsg->getValuesAndDerivatives(lat, RSGEOTable::RSG_Kry, val, val_Y, this->rsgeoHint[wheel]);
+        if (errCode != GSL_SUCCESS)
+            return errCode;
+        for (int i = RSGEOTable::RSG_N; i <= RSGEOTable::RSG_qN; i++)
+            val_Y[i] *= s;
+        if (val[RSGEOTable::RSG_N] <= MIN_RSGEO_NORMAL)
+            return GSL_SUCCESS;
+        double radius = val[RSGEOTable::RSG_Kwz], radius_Y = val_Y[RSGEOTable::RSG_Kwz];
+        double aw = val[RSGEOTable::RSG_Kwy], aw_Y = val_Y[RSGEOTable::RSG_Kwy];
+        double delta = val[RSGEOTable::RSG_angle], delta_Y = val_Y[RSGEOTable::RSG_angle];
+        double N0 = val[RSGEOTable::RSG_N], N0_Y = val_Y[RSGEOTable::RSG_N];
+        double q0 = val[RSGEOTable::RSG_qN], q0_Y = val_Y[RSGEOTable::RSG_qN];
+
+        // Lateral position of the contact point on the rail (Kry)
+        double at = (radius - tan(roll)*aw)*sin(roll) + aw/cos(roll) + lat;
+        double at_Y = (radius_Y - tan(roll)*aw_Y)*sin(roll) + aw_Y/cos(roll) + s;
+        double at_PHI = s * (radius*cos(roll) - aw*sin(roll));
+
+        // Penetration dq = -A sin(th) + B cos(th)
+        double th = delta + s*phi;
+        double A = at - s*this->locY[Y] - aw - s*phi*radius;
+        double B = - this->locY[Z] - s*phi*aw;
+        double A_Y = at_Y - s - aw_Y - s*phi*radius_Y;
+        double A_PHI = at_PHI - s*radius;
+        double B_Y = - s*phi*aw_Y;
+        double B_PHI = - s*aw;
+        double dq = -A*sin(th) + B*cos(th);
+        double dq_Y = -A_Y*sin(th) + B_Y*cos(th) - (A*cos(th) + B*sin(th))*delta_Y;
+        double dq_Z = -cos(th);
+        double dq_PHI = -A_PHI*sin(th) + B_PHI*cos(th) - s*(A*cos(th) + B*sin(th));
+
+        // Normal force N = N0 w^1.5 and semi axes scaled by (N/N0)^(1/3) = w^0.5
+        double w = 1.0 + dq/q0;
+        if (w <= 0.0)
+            return GSL_SUCCESS;
+        double sw = sqrt(w);
+        double N = N0*w*sw;
+        if (N <= MIN_RSGEO_NORMAL)
+            return GSL_SUCCESS;
+        double gw[N_DOF], gN[N_DOF], ga[N_DOF], gb[N_DOF];
+        double gC11[N_DOF], gC22[N_DOF], gC23[N_DOF];
+        double gradius[N_DOF], gaw[N_DOF], gdelta[N_DOF];
+        for (int k = 0; k < N_DOF; k++){
+            gw[k] = .0; gradius[k] = .0; gaw[k] = .0; gdelta[k] = .0;
+            gC11[k] = .0; gC22[k] = .0; gC23[k] = .0;
+        }
+        gw[Y] = (dq_Y - dq*q0_Y/q0)/q0;
+        gw[Z] = dq_Z/q0;
+        gw[PHI] = dq_PHI/q0;
+        gradius[Y] = radius_Y;
+        gaw[Y] = aw_Y;
+        gdelta[Y] = delta_Y;
+        gC11[Y] = val_Y[RSGEOTable::RSG_C11];
+        gC22[Y] = val_Y[RSGEOTable::RSG_C22];
+        gC23[Y] = val_Y[RSGEOTable::RSG_C23];
+        double cp_a = val[RSGEOTable::RSG_a]*sw;
+        double cp_b = val[RSGEOTable::RSG_b]*sw;
+        for (int k = 0; k < N_DOF; k++){
+            double a0_k = (k == Y) ? val_Y[RSGEOTable::RSG_a] : 0.0;
+            double b0_k = (k == Y) ? val_Y[RSGEOTable::RSG_b] : 0.0;
+            double N0_k = (k == Y) ? N0_Y : 0.0;
+            gN[k] = N0_k*w*sw + 1.5*N0*sw*gw[k];
+            ga[k] = a0_k*sw + val[RSGEOTable::RSG_a]*0.5*gw[k]/sw;
+            gb[k] = b0_k*sw + val[RSGEOTable::RSG_b]*0.5*gw[k]/sw;
+        }
+
+        // Creepages and their partials
+        double xi[3];
+        this->creepages(wheel, radius, aw, delta, xi);
+        double v = this->getExternalComponents()->get_v();
+        double R = this->getExternalComponents()->get_R();
+        double phi_se = this->getExternalComponents()->get_Phi_se();
+        double b = this->bogieFrame->get_b();
+        double a = this->get_a();
+        double Omega_0 = v/this->r0;
+        double ydot = this->locY[YDOT];
+        double zdot = this->locY[ZDOT];
+        double phidot = this->locY[PHIDOT];
+        double psidot = this->locY[PSIDOT];
+        double beta = this->locY[BETA];
+        double pb = (this->position == LEADING) ? psi + b/R : psi - b/R;
+        double cd = cos(delta);
+        double sd = sin(delta);
+        double P = -v*pb*(1.0 + s*a*cos(phi_se)/R) + phi*zdot + ydot + phidot*radius;
+        double Q = -phi*ydot + zdot + s*aw*phidot;
+        double gxi[3][N_DOF];
+        for (int i = 0; i < 3; i++)
+            for (int k = 0; k < N_DOF; k++)
+                gxi[i][k] = .0;
+        // Longitudinal
+        gxi[0][PSI] = (ydot + radius*phidot)/v;
+        gxi[0][YDOT] = pb/v;
+        gxi[0][PHIDOT] = radius*pb/v;
+        gxi[0][BETA] = -radius/v;
+        gxi[0][PSIDOT] = -s*aw/v;
+        gxi[0][Y] = ((pb*phidot - Omega_0 - beta)*radius_Y - s*psidot*aw_Y)/v;
+        // Lateral
+        gxi[1][PSI] = -(1.0 + s*a*cos(phi_se)/R)*cd;
+        gxi[1][PHI] = (zdot*cd - s*ydot*sd)/v;
+        gxi[1][YDOT] = (cd - s*phi*sd)/v;
+        gxi[1][ZDOT] = (phi*cd + s*sd)/v;
+        gxi[1][PHIDOT] = (radius*cd + aw*sd)/v;
+        gxi[1][Y] = (phidot*cd*radius_Y + phidot*sd*aw_Y + (-P*sd + s*Q*cd)*delta_Y)/v;
+        // Spin
+        gxi[2][PSI] = s*phidot*sd/v;
+        gxi[2][PHIDOT] = s*pb*sd/v;
+        gxi[2][PSIDOT] = cd/v;
+        gxi[2][BETA] = -s*sd/v;
+        gxi[2][Y] = (-s*(Omega_0 + beta - pb*phidot)*cd - psidot*sd)*delta_Y/v;
+
+        // Kalker's linear creep forces (see Fx, Fy)
+        double C11 = val[RSGEOTable::RSG_C11];
+        double C22 = val[RSGEOTable::RSG_C22];
+        double C23 = val[RSGEOTable::RSG_C23];
+        double G = this->get_G();
+        double c = cp_a*cp_b;
+        double sc = sqrt(c);
+        double Fx_val = Fx(cp_a,cp_b,C11,xi[0]);
+        double Fy_val = Fy(cp_a,cp_b,C22,C23,xi[1],xi[2]);
+        double gFx[N_DOF], gFy[N_DOF];
+        for (int k = 0; k < N_DOF; k++){
+            double gc = ga[k]*cp_b + cp_a*gb[k];
+            gFx[k] = -G*(gc*C11*xi[0] + c*(gC11[k]*xi[0] + C11*gxi[0][k]));
+            gFy[k] = -G*(gc*(C22*xi[1] + 1.5*sc*C23*xi[2]) +
+                    c*(gC22[k]*xi[1] + C22*gxi[1][k]) +
+                    c*sc*(gC23[k]*xi[2] + C23*gxi[2][k]));
+        }
+
+        // Shen-Hedrick-Elkins saturation (see ContactKernel::evaluate)
+        double muN = this->mu*N;
+        double F = sqrt(Fx_val*Fx_val + Fy_val*Fy_val);
+        double u = F/muN;
+        double epsilon = 1.0;
+        if (F > 0.0)
+            epsilon = (u < 3) ? 1.0 - u/3.0 + u*u/27.0 : muN/F;
+        double cx = epsilon*Fx_val;
+        double cy = epsilon*Fy_val;
+        double gcx[N_DOF], gcy[N_DOF];
+        for (int k = 0; k < N_DOF; k++){
+            double gepsilon = 0.0;
+            if (F > 0.0){
+                double gF = (Fx_val*gFx[k] + Fy_val*gFy[k])/F;
+                if (u < 3)
+                    gepsilon = (-1.0/3.0 + 2.0*u/27.0) * (gF - u*this->mu*gN[k]) / muN;
+                else
+                    gepsilon = (this->mu*gN[k]*F - muN*gF) / (F*F);
+            }
+            gcx[k] = gepsilon*Fx_val + epsilon*gFx[k];
+            gcy[k] = gepsilon*Fy_val + epsilon*gFy[k];
+        }
+
+        // Creep and normal forces and torques (see find_contact_forces)
+        double ct = cos(th);
+        double st = sin(th);
+        double Fxw = cx - cy*psi*cd;
+        double Fyw = cx*psi + cy*ct;
+        double Nyw = -s*N*st;
+        for (int k = 0; k < N_DOF; k++){
+            double ePsi = (k == PSI) ? 1.0 : 0.0;
+            double ePhi = (k == PHI) ? 1.0 : 0.0;
+            double gth = gdelta[k] + s*ePhi;
+            double gFxw = gcx[k] - gcy[k]*psi*cd - cy*(ePsi*cd - psi*sd*gdelta[k]);
+            double gFyw = gcx[k]*psi + cx*ePsi + gcy[k]*ct - cy*st*gth;
+            double gFzw = s*(gcy[k]*st + cy*ct*gth);
+            double gNyw = -s*(gN[k]*st + N*ct*gth);
+            double gNzw = gN[k]*ct - N*st*gth;
+            double lat_k = gFyw + gNyw;
+            double lon_k = gFxw + lat_k*psi + (Fyw + Nyw)*ePsi;
+
+            dFY[k] += lat_k;
+            dFZ[k] += gFzw + gNzw;
+            dTPHI[k] += s*gaw[k]*(s*cy*st + N*ct - (Fyw + Nyw)*phi) +
+                    s*aw*(gFzw + gNzw - lat_k*phi - (Fyw + Nyw)*ePhi);
+            dTCHI[k] += - gradius[k]*(Fxw + (Fyw + Nyw)*psi) - radius*lon_k;
+            dTPSI[k] += - s*gaw[k]*(Fxw + (Fyw + Nyw)*psi) - s*aw*lon_k;
+        }
+
+        return GSL_SUCCESS;
+    }
+
+    /**
+     * Partials of the connector forces and moments w.r.t. the variables partialJacobianIdx
+     * (of the wheelset and of the bogie frame), by forward automatic differentiation.
+     * dConn[6*k+i] is the partial of the component i w.r.t. partialJacobianIdx[k].
+     */
+    int WheelSetComponent::connector_partials(const double y[], double dConn[]){
+        int errCode = GSL_SUCCESS;
+        int N_VAR = this->get_generalModel()->get_N_DOF();
+
+        ADScalar* adY = this->wsAdY;
+        for (int i = 0; i < N_VAR; i++)
+            adY[i] = y[i];
+
+        int nIdx = this->partialJacobianIdx.size();
+        for (int first = 0; first < nIdx; first += AD_WIDTH){
+            int width = std::min(AD_WIDTH, nIdx - first);
+            for (int k = 0; k < width; k++)
+                adY[this->partialJacobianIdx[first+k]].setDerivative(k, 1.0);
+
+            BodyKinematics<ADScalar> loc;
+            BodyKinematics<ADScalar> up;
+            this->kinematics(adY, loc);
+            this->bogieFrame->kinematics(adY, up);
+            ADScalar fm[6];
+            errCode = this->connector->getForcesAndMoments(UP, loc, up, fm);
+            if (errCode != GSL_SUCCESS){
+                return errCode;
+            }
+
+            for (int k = 0; k < width; k++){
+                for (int i = 0; i < 6; i++)
+                    dConn[6*(first+k)+i] = fm[i].derivative(k);
+                adY[this->partialJacobianIdx[first+k]].setDerivative(k, 0.0);
+            }
+        }
+
+        return errCode;
+    }
+
+    template<class T>
+    void WheelSetComponent::kinematics(const T y[], BodyKinematics<T>& k){
+        const T* ly = &(y[this->get_startingDOF()]);
+        k.trans.setSmallRotation(ly[PHI], 0.0, ly[PSI]);
+        k.dtrans.setSkew(ly[PHIDOT], 0.0, ly[PSIDOT]);
+        k.r.set(0.0, ly[Y], ly[Z]);
+        k.dr.set(0.0, ly[YDOT], ly[ZDOT]);
+    }
+
+    template void WheelSetComponent::kinematics<double>(const double y[], BodyKinematics<double>& k);
+    template void WheelSetComponent::kinematics<ADScalar>(const ADScalar y[], BodyKinematics<ADScalar>& k);
+
+    /**
+     * Compare the analytic Jacobian J with the numerical one and report the largest
+     * relative deviation when it exceeds JAC_CHECK_TOL.
+     */
+    int WheelSetComponent::jac_check(double t, const double y[], gsl_matrix* J){
+        int errCode = GSL_SUCCESS;
+
+        gsl_matrix* Jnum = gsl_matrix_calloc(J->size1, J->size2);
+        errCode = this->jac_numerical(t,y,Jnum);
+        if (errCode != GSL_SUCCESS){
+            gsl_matrix_free(Jnum);
+            return errCode;
+        }
+
+        double maxDev = 0.0;
+        int iMax = 0;
+        int jMax = 0;
+        for (int i = 0; i < this->get_N_DOF(); i++){
+            for (std::vector<int>::iterator iter = this->partialJacobianIdx.begin();
+                    iter != this->partialJacobianIdx.end(); ++iter){
+                double num = gsl_matrix_get(Jnum, i, *iter);
+                double dev = fabs(gsl_matrix_get(J, i, *iter) - num) / (1.0 + fabs(num));
+                if (dev > maxDev){
+                    maxDev = dev;
+                    iMax = i;
+                    jMax = *iter;
+                }
+            }
+        }
+
+        this->jac_check_counter++;
+        if (maxDev > JAC_CHECK_TOL){
+            this->jac_check_failures++;
+            std::stringstream* out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+            *out << this->get_name() << ": Analytic Jacobian check at t = " << t
+                    << ": relative deviation " << maxDev
+                    << " in d" << *(this->DOF_Names[iMax]) << "/dy[" << jMax << "]"
+                    << " (analytic " << gsl_matrix_get(J, iMax, jMax)
+                    << ", numerical " << gsl_matrix_get(Jnum, iMax, jMax) << ")" << std::endl;
+            PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+            delete out;
+        }
+
+        gsl_matrix_free(Jnum);
+        return errCode;
+    }
+
     inline double WheelSetComponent::xi_flx(double psi, double psidot, double phidot,
             double ydot, double beta, double rl, double al){
         double v = this->getExternalComponents()->get_v();
@@ -35,6 +35,7 @@
 #define	WHEELSETCOMPONENT_H
 
 #include "Component.h"
+#include "ContactKernel.h"
 #include "enumDeclarations.h"
 
 #include <stdio.h>
@@ -67,7 +68,7 @@ namespace DYTSI_Modelling {
                 double mu,
                 double G,
                 ExternalComponents* externalComponents,
-                std::vector<RSGEOTable*> rsgeo_table_list,
+                std::vector<const RSGEOTable*> rsgeo_table_list,
                 std::string name,
                 GeneralModel* gm,
                 bool isFixed = false);
@@ -93,14 +94,7 @@ namespace DYTSI_Modelling {
         // Implementation of virtual Component classes
         int computeFun( double t, double y[], double f[] );
         int computeJac( double t, double y[], double* dfdy, double dfdt[]);
-        void updateTransformationMatrix( gsl_matrix* mat, const double y[]);
-        void updateDTransformationMatrix( gsl_matrix* mat, const double y[]);
-        void updateDisplacementVector( gsl_vector* vec, const double y[] );
-        void updateDDisplacementVector( gsl_vector* vec, const double y[] );
-        void updateTransformationMatrix( gsl_matrix* mat, double y[]);
-        void updateDTransformationMatrix( gsl_matrix* mat, double y[]);
-        void updateDisplacementVector( gsl_vector* vec, double y[] );
-        void updateDDisplacementVector( gsl_vector* vec, double y[] );
+        template<class T> void kinematics(const T y[], BodyKinematics<T>& k);
         
         int get_N_DOF() { return N_DOF; }
 
@@ -110,6 +104,16 @@ namespace DYTSI_Modelling {
         const double* getCurrentY();
         void init();
         std::string printCounters();
+        Component* clone(GeneralModel* gm, ExternalComponents* externalComponents);
+        void setupWorkspace(ModelArena* arena);
+
+        // Contact forces of the wheels of all the wheelsets evaluated in one batch (see
+        // GeneralModel::evaluateContacts): the contacts are appended to the kernel, and
+        // the results are used by the next evaluation of the right hand side.
+        int getMaxContacts(){ return 2 * rsgeo_table_list.size(); }
+        int gatherContacts(double t, const double y[], ContactKernel* kernel);
+        void scatterContacts(ContactKernel* kernel);
+        void releaseContacts(){ contactsReady = false; }
 
         // Extension of the connection function
         void setConnection(Connector* connector,
@@ -145,13 +149,20 @@ namespace DYTSI_Modelling {
         double a;
 
         double MAX_DISPL;
-        std::vector<RSGEOTable*> rsgeo_table_list;
+        std::vector<const RSGEOTable*> rsgeo_table_list; // Shared, read-only
+        int rsgeoHint[2];   // Interval of the last table lookup for each wheel
         bool recalc;
         double **rsgeodata; // [2][N_COLS_RSGEO]
         double **c_forces;   // 2x3
         double **n_forces;   // 2x2
         double **torques;    // 2x3
 
+        // Contacts of this wheelset alone, and range of its contacts in the last gathered batch
+        ContactKernel contactKernel;
+        int contactsBegin;
+        int contactsEnd;
+        bool contactsReady;
+
         // Shortcuts
         WheelSetBogieFrameConnector *connector;
         BogieFrameComponent *bogieFrame;
@@ -160,26 +171,31 @@ namespace DYTSI_Modelling {
         const double* upY;
         double* locF;
 
-        gsl_matrix* locTransformationMatrix;
-        gsl_matrix* locDTransformationMatrix;
-        gsl_matrix* upTransformationMatrix;
-        gsl_matrix* upDTransformationMatrix;
-        gsl_vector* locDisp;
-        gsl_vector* locDDisp;
-        gsl_vector* upDisp;
-        gsl_vector* upDDisp;
+        // Displacements and rotations of the wheelset and of the bogie frame
+        BodyKinematics<double> locKin;
+        BodyKinematics<double> upKin;
 
-        // Centrifugal forces and moments
-        gsl_vector* vecForceAndMoment;
+        // Comparisons between analytic and numerical Jacobian (JAC_CHECK mode)
+        unsigned long int jac_check_counter;
+        unsigned long int jac_check_failures;
 
         // Private methods
         int find_contact_forces(double t);
-        int find_rsgeodata(double t, RSGEOTable* rsg);
-        int SHE(double t, int wheel, double *out); 
+        int find_rsgeodata(double t, const RSGEOTable* rsg);
+        void creepages(int wheel, double radius, double aw, double delta, double xi[3]);
         void dynamic_update( double t, int wheel );
         void dynamic_aux( double radius, double aw, double at, double zt, double delta, double y_lat,
             double z_ver, double phi, int wheel);
 
+        // Analytic Jacobian
+        int jac_analytic(double t, const double y[], gsl_matrix* J);
+        int jac_check(double t, const double y[], gsl_matrix* J);
+        int contact_partials(const RSGEOTable* rsg, int wheel, double dFY[], double dFZ[],
+            double dTPHI[], double dTCHI[], double dTPSI[]);
+        int connector_partials(const double y[], double dConn[]);
+        // Workspace of the connector partials (6 per column of partialJacobianIdx)
+        double* wsConn;
+
         // Inline functions
         double xi_flx(double psi, double psidot, double phidot, double ydot, double beta, double rl, double al); 
         double xi_frx(double psi, double psidot, double phidot, double ydot, double beta, double rr, double ar); 
@@ -198,7 +214,7 @@ namespace DYTSI_Modelling {
 
     protected:
         int computeConnectorsForcesAndMoments();
-        gsl_vector* computeCentrifugalForceAndMoment();
+        void computeCentrifugalForceAndMoment(double forceAndMoment[6]);
         int rhs(double t, const double y[], gsl_matrix* rightHandSide); // TODO finish BETA
     };
 }
@@ -0,0 +1,160 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+
+#include "WorkerPool.h"
+
+#include <unistd.h>
+
+namespace DYTSI_Modelling {
+
+    // The deepest fan-out of the component tree is four wheel sets, and the
+    // thread calling fork() always takes part in the evaluation.
+    const int MAX_WORKERS = 3;
+    // Initial capacity of the queue
+    const int QUEUE_CAPACITY = 16;
+
+    WorkerPool::WorkerPool(int nWorkers) {
+        this->nWorkers = (nWorkers > 0) ? nWorkers : 0;
+        this->shutdown = false;
+        this->queue.resize(QUEUE_CAPACITY);
+        this->queueHead = 0;
+        this->queueSize = 0;
+
+        pthread_mutex_init(&this->mutex, NULL);
+        pthread_cond_init(&this->workAvailable, NULL);
+        pthread_cond_init(&this->jobDone, NULL);
+
+        for (int i = 0; i < this->nWorkers; i++){
+            pthread_t threadId;
+            if (pthread_create(&threadId, NULL, WorkerPool::EntryPoint, this) != 0)
+                break;
+            this->workers.push_back(threadId);
+        }
+        this->nWorkers = this->workers.size();
+    }
+
+    WorkerPool::~WorkerPool() {
+        pthread_mutex_lock(&this->mutex);
+        this->shutdown = true;
+        pthread_cond_broadcast(&this->workAvailable);
+        pthread_mutex_unlock(&this->mutex);
+
+        for (unsigned int i = 0; i < this->workers.size(); i++)
+            pthread_join(this->workers[i], NULL);
+
+        pthread_cond_destroy(&this->jobDone);
+        pthread_cond_destroy(&this->workAvailable);
+        pthread_mutex_destroy(&this->mutex);
+    }
+
+    int WorkerPool::defaultNumberOfWorkers(){
+        long nProcs = sysconf(_SC_NPROCESSORS_ONLN);
+        if (nProcs <= 1)
+            return 0;
+        return (nProcs - 1 < MAX_WORKERS) ? (int)(nProcs - 1) : MAX_WORKERS;
+    }
+
+    void WorkerPool::fork(TaskGroup& group, Task* task, void* arg){
+        // Without workers the task is executed straight away
+        if (this->nWorkers == 0){
+            task->Execute(arg);
+            return;
+        }
+
+        Job job = {task, arg, &group};
+        pthread_mutex_lock(&this->mutex);
+        group.pending++;
+        this->pushJob(job);
+        pthread_cond_signal(&this->workAvailable);
+        pthread_mutex_unlock(&this->mutex);
+    }
+
+    void WorkerPool::join(TaskGroup& group){
+        pthread_mutex_lock(&this->mutex);
+        while (group.pending > 0){
+            if (this->queueSize > 0){
+                // Help with the queued work instead of sleeping
+                Job job = this->popJob();
+                this->runJob(job);
+            } else {
+                pthread_cond_wait(&this->jobDone, &this->mutex);
+            }
+        }
+        pthread_mutex_unlock(&this->mutex);
+    }
+
+    /*static */
+    void* WorkerPool::EntryPoint(void* pthis){
+        WorkerPool* pool = (WorkerPool*)pthis;
+        pool->workerLoop();
+        return NULL;
+    }
+
+    void WorkerPool::workerLoop(){
+        pthread_mutex_lock(&this->mutex);
+        while (true){
+            while ((this->queueSize == 0) && !this->shutdown)
+                pthread_cond_wait(&this->workAvailable, &this->mutex);
+            if ((this->queueSize == 0) && this->shutdown)
+                break;
+            Job job = this->popJob();
+            this->runJob(job);
+        }
+        pthread_mutex_unlock(&this->mutex);
+    }
+
+    void WorkerPool::runJob(Job& job){
+        pthread_mutex_unlock(&this->mutex);
+        job.task->Execute(job.arg);
+        pthread_mutex_lock(&this->mutex);
+
+        job.group->pending--;
+        if (job.group->pending == 0)
+            pthread_cond_broadcast(&this->jobDone);
+    }
+
+    void WorkerPool::pushJob(const Job& job){
+        unsigned int capacity = this->queue.size();
+        if (this->queueSize == capacity){
+            // Unroll the ring into a larger one
+            std::vector<Job> larger(2 * capacity);
+            for (unsigned int i = 0; i < this->queueSize; i++)
+                larger[i] = this->queue[(this->queueHead + i) % capacity];
+            this->queue.swap(larger);
+            this->queueHead = 0;
+            capacity = this->queue.size();
+        }
+        this->queue[(this->queueHead + this->queueSize) % capacity] = job;
+        this->queueSize++;
+    }
+
+    WorkerPool::Job WorkerPool::popJob(){
+        Job job = this->queue[this->queueHead];
+        this->queueHead = (this->queueHead + 1) % this->queue.size();
+        this->queueSize--;
+        return job;
+    }
+}
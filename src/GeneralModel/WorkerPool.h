@@ -0,0 +1,105 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+
+#ifndef WORKERPOOL_H
+#define	WORKERPOOL_H
+
+#include <pthread.h>
+
+#include <vector>
+
+namespace DYTSI_Modelling {
+
+    /**
+     * Unit of work that can be dispatched on a WorkerPool.
+     */
+    class Task {
+    public:
+        virtual ~Task() {}
+        virtual void Execute(void*) = 0;
+    };
+
+    /**
+     * Pool of long-lived worker threads used to evaluate independent subtrees
+     * of the component tree in THREADS mode. The threads are created once and
+     * parked on a condition variable between evaluations.
+     *
+     * Work is submitted with fork() and collected with join() on a TaskGroup.
+     * While waiting in join() the calling thread executes queued tasks itself,
+     * so nested fork/join (car body -> bogie frames -> wheel sets) never
+     * deadlocks, whatever the number of workers.
+     */
+    class WorkerPool {
+    public:
+        struct TaskGroup {
+            int pending;
+            TaskGroup() : pending(0) {}
+        };
+
+        WorkerPool(int nWorkers);
+        virtual ~WorkerPool();
+
+        void fork(TaskGroup& group, Task* task, void* arg);
+        void join(TaskGroup& group);
+
+        int get_nWorkers(){ return nWorkers; }
+
+        // Number of workers suited for the component tree on this machine
+        static int defaultNumberOfWorkers();
+
+    private:
+        struct Job {
+            Task* task;
+            void* arg;
+            TaskGroup* group;
+        };
+
+        int nWorkers;
+        bool shutdown;
+
+        // Ring of the queued jobs (reallocated only when full, so that the
+        // steady state fork/join does not allocate)
+        std::vector<Job> queue;
+        unsigned int queueHead;
+        unsigned int queueSize;
+        std::vector<pthread_t> workers;
+
+        pthread_mutex_t mutex;
+        pthread_cond_t workAvailable;
+        pthread_cond_t jobDone;
+
+        static void* EntryPoint(void* pthis);
+        void workerLoop();
+        // Run a job and release its group. Called (and returns) with the mutex locked.
+        void runJob(Job& job);
+        // Queue operations, with the mutex locked
+        void pushJob(const Job& job);
+        Job popJob();
+    };
+}
+
+#endif	/* WORKERPOOL_H */
+
@@ -38,6 +38,11 @@ namespace DYTSI_Modelling {
     enum RelativeComponentPosition { UP, LL, LT };
     enum ComponentPosition { LEADING, TRAILING };
 
+    enum ExecMode { NO_THREADS, THREADS };
+    enum JacobianMode { JAC_NUMERICAL, JAC_ANALYTIC, JAC_CHECK, JAC_COLORED, JAC_AUTOMATIC };
+    enum FDScheme { FD_FORWARD, FD_CENTRAL };
+    enum FDStepType { FD_STEP_ABSOLUTE, FD_STEP_RELATIVE };
+
     enum InterpolationTypes { INTP_LINEAR, INTP_CUBICSPLINE, INTP_AKIMA };
     enum FunctionTypes { FT_LINEAR, FT_PIECEWISELINEAR, FT_PWLEVENT };
 
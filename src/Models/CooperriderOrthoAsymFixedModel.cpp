@@ -34,7 +34,7 @@
 #include "CooperriderOrthoAsymFixedModel.h"
 
 #include "../Application/Input/XMLaux.h"
-#include "../Application/Input/RSGEOTableReader.h"
+#include "../Application/Input/RSGEOTableRegistry.h"
 #include "../Application/PrintingHandler.h"
 
 #include <gsl/gsl_vector.h>
@@ -51,6 +51,10 @@ namespace DYTSI_Models {
     CooperriderOrthoAsymFixedModel::~CooperriderOrthoAsymFixedModel() {
     }
 
+    DYTSI_Modelling::GeneralModel* CooperriderOrthoAsymFixedModel::newInstance(){
+        return new CooperriderOrthoAsymFixedModel(*this);
+    }
+
     std::vector<DYTSI_Modelling::Component*> CooperriderOrthoAsymFixedModel::getComponentList(){
         std::vector<DYTSI_Modelling::Component*> out;
 
@@ -759,8 +763,8 @@ namespace DYTSI_Models {
             bool LT_isFixed = false;
             bool TL_isFixed = true;
             bool TT_isFixed = true;
-            std::vector<DYTSI_Modelling::RSGEOTable*> rsgeo_table;
-            DYTSI_Input::RSGEOTableReader::read(rsgeo_table, this->getRSGEO_path(), '#');
+            std::vector<const DYTSI_Modelling::RSGEOTable*> rsgeo_table;
+            DYTSI_Input::RSGEOTableRegistry::get(rsgeo_table, this->getRSGEO_path(), '#');
 
             DYTSI_Modelling::WheelSetComponent *llwheelset;
             DYTSI_Modelling::WheelSetComponent *ltwheelset;
@@ -281,6 +281,7 @@ namespace DYTSI_Models {
 		bool setupModel(XERCES_CPP_NAMESPACE::DOMElement* el);
 		bool setupStaticLoads();
 		bool loadStartingValues(XERCES_CPP_NAMESPACE::DOMElement* el, std::vector<double>& startingValues);
+		DYTSI_Modelling::GeneralModel* newInstance();
 
 	};
 }
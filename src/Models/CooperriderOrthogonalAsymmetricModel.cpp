@@ -34,7 +34,7 @@
 #include "CooperriderOrthogonalAsymmetricModel.h"
 
 #include "../Application/Input/XMLaux.h"
-#include "../Application/Input/RSGEOTableReader.h"
+#include "../Application/Input/RSGEOTableRegistry.h"
 #include "../Application/PrintingHandler.h"
 
 #include <gsl/gsl_vector.h>
@@ -51,6 +51,10 @@ namespace DYTSI_Models {
     CooperriderOrthogonalAsymmetricModel::~CooperriderOrthogonalAsymmetricModel() {
     }
 
+    DYTSI_Modelling::GeneralModel* CooperriderOrthogonalAsymmetricModel::newInstance(){
+        return new CooperriderOrthogonalAsymmetricModel(*this);
+    }
+
     std::vector<DYTSI_Modelling::Component*> CooperriderOrthogonalAsymmetricModel::getComponentList(){
         std::vector<DYTSI_Modelling::Component*> out;
 
@@ -752,8 +756,8 @@ namespace DYTSI_Models {
             double a = 0.75;
             double mu = 0.15;
             double G = 2.1e11/(2*(1-0.27));
-            std::vector<DYTSI_Modelling::RSGEOTable*> rsgeo_table;
-            DYTSI_Input::RSGEOTableReader::read(rsgeo_table, this->getRSGEO_path(), '#');
+            std::vector<const DYTSI_Modelling::RSGEOTable*> rsgeo_table;
+            DYTSI_Input::RSGEOTableRegistry::get(rsgeo_table, this->getRSGEO_path(), '#');
 
             DYTSI_Modelling::WheelSetComponent *llwheelset;
             DYTSI_Modelling::WheelSetComponent *ltwheelset;
@@ -0,0 +1,87 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+
+#include "ConvergenceMonitor.h"
+
+#include "../GeneralModel/WheelSetComponent.h"
+#include "../Application/Input/XMLaux.h"
+#include "../Application/PrintingHandler.h"
+
+#include <sstream>
+
+namespace DYTSI_Solver{
+
+    ConvergenceMonitor::ConvergenceMonitor() {
+        this->enabled = false;
+    }
+
+    ConvergenceMonitor::~ConvergenceMonitor() {
+    }
+
+    /**
+     * Read the optional Convergence element of the solver element el:
+     * Tolerance (required), Window, MinTime and Cycles.
+     * @return the number of errors
+     */
+    int ConvergenceMonitor::load(XERCES_CPP_NAMESPACE::DOMElement* el){
+        XERCES_CPP_NAMESPACE::DOMNodeList* convList = XMLaux::getElementsByTagName(el, "Convergence");
+        if (convList->getLength() != 1)
+            return 0;
+        XERCES_CPP_NAMESPACE::DOMElement* convEl = (XERCES_CPP_NAMESPACE::DOMElement*) convList->item(0);
+
+        int error = 0;
+        error += XMLaux::loadDoubleProperty(convEl, "Tolerance", this->tolerance);
+
+        XERCES_CPP_NAMESPACE::DOMNodeList* windowList = XMLaux::getElementsByTagName(convEl, "Window");
+        if (windowList->getLength() == 1)
+            this->window = XMLaux::setValueToDouble(windowList->item(0));
+        XERCES_CPP_NAMESPACE::DOMNodeList* minTimeList = XMLaux::getElementsByTagName(convEl, "MinTime");
+        if (minTimeList->getLength() == 1)
+            this->minTime = XMLaux::setValueToDouble(minTimeList->item(0));
+        XERCES_CPP_NAMESPACE::DOMNodeList* cyclesList = XMLaux::getElementsByTagName(convEl, "Cycles");
+        if (cyclesList->getLength() == 1)
+            this->nCycles = (int) XMLaux::setValueToDouble(cyclesList->item(0));
+
+        if (error == 0 && (this->tolerance <= 0.0 || this->window <= 0.0 || this->minTime < 0.0 || this->nCycles < 2)){
+            error++;
+            std::stringstream* out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+            *out << "\t\t\tError in parsing the input file: " << std::endl;
+            *out << "\t\t\tThe property \"Convergence\" needs Tolerance > 0, Window > 0, MinTime >= 0 and Cycles >= 2" << std::endl;
+            PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+            delete out;
+        }
+
+        this->enabled = (error == 0);
+        return error;
+    }
+
+    void ConvergenceMonitor::start(DYTSI_Modelling::GeneralModel* gm, double t, const double* y){
+        const std::vector<DYTSI_Modelling::WheelSetComponent*>& wheelSets = gm->getWheelSetList();
+        int signal = wheelSets.empty() ? 0 :
+            wheelSets[0]->get_startingDOF() + DYTSI_Modelling::WheelSetComponent::Y;
+        RunClassifier::start(gm->get_N_DOF(), signal, t, y);
+    }
+}
@@ -0,0 +1,59 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+
+#ifndef CONVERGENCEMONITOR_H
+#define	CONVERGENCEMONITOR_H
+
+#include "RunClassifier.h"
+#include "../GeneralModel/GeneralModel.h"
+
+#include <xercesc/dom/DOM.hpp>
+
+namespace DYTSI_Solver{
+
+    /**
+     * Classification of the runs integrated by Solver::solve (see RunClassifier),
+     * used to stop a run as soon as it is settled. The monitored variable is the
+     * lateral displacement of the leading wheelset, or state 0.
+     * The monitor is configured by the optional Convergence element of the solver.
+     */
+    class ConvergenceMonitor : public RunClassifier {
+    public:
+        ConvergenceMonitor();
+        virtual ~ConvergenceMonitor();
+
+        int load(XERCES_CPP_NAMESPACE::DOMElement* el);
+        bool isEnabled(){ return enabled; }
+
+        void start(DYTSI_Modelling::GeneralModel* gm, double t, const double* y);
+
+    private:
+        bool enabled;
+    };
+}
+
+#endif	/* CONVERGENCEMONITOR_H */
+
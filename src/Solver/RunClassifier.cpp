@@ -0,0 +1,196 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+
+#include "RunClassifier.h"
+
+#include <math.h>
+
+namespace DYTSI_Solver{
+
+    const std::string* RunClassifier::RunClassNames[N_RUN_CLASS] = {
+        new std::string("UNDECIDED"), new std::string("STABLE"), new std::string("PERIODIC") };
+
+    RunClassifier::RunClassifier() {
+        this->tolerance = 0.0;
+        this->window = 1.0;
+        this->minTime = 0.0;
+        this->nCycles = 3;
+        this->N_DOF = 0;
+        this->signal = 0;
+        this->runClass = RUN_UNDECIDED;
+    }
+
+    RunClassifier::RunClassifier(double tolerance, double window, double minTime, int nCycles) {
+        this->tolerance = tolerance;
+        this->window = window;
+        this->minTime = minTime;
+        this->nCycles = nCycles;
+        this->N_DOF = 0;
+        this->signal = 0;
+        this->runClass = RUN_UNDECIDED;
+    }
+
+    RunClassifier::~RunClassifier() {
+    }
+
+    void RunClassifier::start(int N_DOF, int signal, double t, const double* y){
+        this->N_DOF = N_DOF;
+        this->signal = signal;
+
+        this->runClass = RUN_UNDECIDED;
+        this->tStart = t;
+        this->tNow = t;
+
+        this->yWindow.assign(y, y + this->N_DOF);
+        this->tWindow = t;
+
+        this->sTime[2] = t;
+        this->sValue[2] = y[this->signal];
+        this->nSamples = 1;
+        this->hasPeak = false;
+        this->hasTrough = false;
+        this->amplitudes.clear();
+        this->periods.clear();
+    }
+
+    bool RunClassifier::update(double t, const double* y){
+        this->tNow = t;
+        bool stable = this->checkEquilibrium(t, y);
+        bool periodic = this->checkCycles(t, y[this->signal]);
+        if (t - this->tStart < this->minTime)
+            return false;
+
+        if (stable)
+            this->runClass = RUN_STABLE;
+        else if (periodic)
+            this->runClass = RUN_PERIODIC;
+        return this->runClass != RUN_UNDECIDED;
+    }
+
+    RunSummary RunClassifier::getSummary(int index){
+        RunSummary summary;
+        summary.index = index;
+        summary.runClass = this->runClass;
+        summary.tEnd = this->tNow;
+        bool cycles = (this->runClass != RUN_STABLE);
+        summary.amplitude = (cycles && !this->amplitudes.empty()) ? this->amplitudes.back() : 0.0;
+        summary.period = (cycles && !this->periods.empty()) ? this->periods.back() : 0.0;
+        summary.growth = 0.0;
+        if (cycles && this->amplitudes.size() > 1 && this->amplitudes.front() > 0.0)
+            summary.growth = this->amplitudes.back() / this->amplitudes.front();
+        return summary;
+    }
+
+    /**
+     * True if the states did not move more than the tolerance for a whole window.
+     */
+    bool RunClassifier::checkEquilibrium(double t, const double* y){
+        double dev = 0.0;
+        for (int i = 0; i < this->N_DOF; i++){
+            double d = fabs(y[i] - this->yWindow[i]) / (1.0 + fabs(this->yWindow[i]));
+            if (d > dev) dev = d;
+        }
+        if (dev > this->tolerance){
+            // Restart the window from the current state
+            this->yWindow.assign(y, y + this->N_DOF);
+            this->tWindow = t;
+            return false;
+        }
+        return (t - this->tWindow >= this->window);
+    }
+
+    /**
+     * Add the sample s of the signal and look for an extremum in the middle one of
+     * the last three samples. True if the last cycles are settled.
+     */
+    bool RunClassifier::checkCycles(double t, double s){
+        this->sTime[0] = this->sTime[1]; this->sValue[0] = this->sValue[1];
+        this->sTime[1] = this->sTime[2]; this->sValue[1] = this->sValue[2];
+        this->sTime[2] = t; this->sValue[2] = s;
+        if (this->nSamples < 3){
+            this->nSamples++;
+            if (this->nSamples < 3) return false;
+        }
+
+        double t0 = this->sTime[0], t1 = this->sTime[1], t2 = this->sTime[2];
+        double s0 = this->sValue[0], s1 = this->sValue[1], s2 = this->sValue[2];
+        bool isPeak = (s1 >= s0) && (s1 > s2);
+        bool isTrough = (s1 <= s0) && (s1 < s2);
+        if (!isPeak && !isTrough)
+            return false;
+        if (!(t1 > t0) || !(t2 > t1))
+            return false;
+
+        // Vertex of the parabola through the three samples
+        double d01 = (s1 - s0) / (t1 - t0);
+        double a = ((s2 - s1) / (t2 - t1) - d01) / (t2 - t0);
+        double tExt = t1;
+        double sExt = s1;
+        if (a != 0.0){
+            tExt = 0.5 * (t0 + t1) - 0.5 * d01 / a;
+            if (tExt >= t0 && tExt <= t2)
+                sExt = s0 + d01 * (tExt - t0) + a * (tExt - t0) * (tExt - t1);
+            else
+                tExt = t1;
+        }
+
+        if (isTrough){
+            this->lastTrough = sExt;
+            this->hasTrough = true;
+            return false;
+        }
+
+        if (this->hasTrough){
+            this->amplitudes.push_back(0.5 * (sExt - this->lastTrough));
+            if ((int) this->amplitudes.size() > this->nCycles)
+                this->amplitudes.erase(this->amplitudes.begin());
+        }
+        if (this->hasPeak){
+            this->periods.push_back(tExt - this->lastPeakTime);
+            if ((int) this->periods.size() > this->nCycles)
+                this->periods.erase(this->periods.begin());
+        }
+        this->lastPeakTime = tExt;
+        this->hasPeak = true;
+
+        return ((int) this->amplitudes.size() == this->nCycles) && ((int) this->periods.size() == this->nCycles) &&
+                this->settled(this->amplitudes) && this->settled(this->periods);
+    }
+
+    /**
+     * True if the values are equal within the relative tolerance.
+     */
+    bool RunClassifier::settled(const std::vector<double>& values){
+        double vMin = values[0], vMax = values[0], mean = 0.0;
+        for (unsigned int i = 0; i < values.size(); i++){
+            if (values[i] < vMin) vMin = values[i];
+            if (values[i] > vMax) vMax = values[i];
+            mean += values[i];
+        }
+        mean /= values.size();
+        return (mean > 0.0) && (vMax - vMin <= this->tolerance * mean);
+    }
+}
@@ -0,0 +1,106 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+
+#ifndef RUNCLASSIFIER_H
+#define	RUNCLASSIFIER_H
+
+#include <string>
+#include <vector>
+
+namespace DYTSI_Solver{
+
+    enum RunClass {RUN_UNDECIDED, RUN_STABLE, RUN_PERIODIC};
+
+    // Classification of one run (see RunClassifier)
+    struct RunSummary {
+        int index;
+        RunClass runClass;
+        double tEnd;
+        double amplitude;
+        double period;
+        double growth; // Last over first amplitude of the monitored cycles (0 if less than two)
+    };
+
+    /**
+     * Online classification of the motion of a run, from the states after each step:
+     *  - RUN_STABLE: over a window of Window seconds no state moves from the state at
+     *    the start of the window more than Tolerance (relative to 1 + |y_i|);
+     *  - RUN_PERIODIC: the last Cycles cycles of the monitored variable have
+     *    amplitudes and periods equal within the relative Tolerance. The extrema are
+     *    refined by the parabola through the last three steps.
+     * No decision is taken before MinTime seconds from the start of the run.
+     * It does not depend on the model (see ConvergenceMonitor).
+     */
+    class RunClassifier {
+    public:
+        RunClassifier();
+        RunClassifier(double tolerance, double window, double minTime, int nCycles);
+        virtual ~RunClassifier();
+
+        // Start a run with N_DOF states, monitoring the cycles of y[signal]
+        void start(int N_DOF, int signal, double t, const double* y);
+        // Add the state after a successful step. True when the run can be stopped
+        bool update(double t, const double* y);
+        RunSummary getSummary(int index);
+
+        static const int N_RUN_CLASS = 3;
+        static const std::string* RunClassNames[N_RUN_CLASS];
+
+    protected:
+        double tolerance;
+        double window;
+        double minTime;
+        int nCycles;
+
+    private:
+        int N_DOF;
+        int signal; // Index of the monitored variable in y
+        RunClass runClass;
+        double tStart;
+        double tNow;
+
+        // Equilibrium: reference state of the current window
+        std::vector<double> yWindow;
+        double tWindow;
+
+        // Cycles: last three samples of the signal and the extrema found
+        double sTime[3];
+        double sValue[3];
+        int nSamples;
+        double lastPeakTime;
+        bool hasPeak;
+        double lastTrough;
+        bool hasTrough;
+        std::vector<double> amplitudes;
+        std::vector<double> periods;
+
+        bool checkEquilibrium(double t, const double* y);
+        bool checkCycles(double t, double s);
+        bool settled(const std::vector<double>& values);
+    };
+}
+
+#endif	/* RUNCLASSIFIER_H */
@@ -0,0 +1,270 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ */
+
+/**************************************************
+ * Source file for block sparse LU class          *
+ **************************************************/
+
+#include "blocklu.h"
+
+#include <set>
+
+// Constructor
+BlockLUfactorize::BlockLUfactorize(int dim,
+                                   const std::vector<int> &blockStart,
+                                   const std::vector<int> &blockSize,
+                                   const std::vector< std::vector<int> > &coupling)
+{
+  n = dim;
+  nb = blockStart.size();
+  start = blockStart;
+  size = blockSize;
+  Symbolic(coupling);
+}
+
+// Destructor
+BlockLUfactorize::~BlockLUfactorize(){}
+
+// Minimum degree ordering of the (symmetrized) block graph.
+// Eliminating a block couples all its remaining neighbours (fill in).
+void BlockLUfactorize::Symbolic(const std::vector< std::vector<int> > &coupling)
+{
+  int i, j, k, p;
+  std::vector< std::set<int> > adj(nb);
+  std::vector<bool> eliminated(nb, false);
+
+  for (i=0; i<nb; i++)
+    for (j=0; j<(int)coupling[i].size(); j++)
+      if (coupling[i][j] != i){
+        adj[i].insert(coupling[i][j]);
+        adj[coupling[i][j]].insert(i);
+      }
+
+  order.resize(nb);
+  coupled.assign(nb, std::vector<int>());
+  for (p=0; p<nb; p++){
+    k = -1;
+    for (i=0; i<nb; i++)
+      if (!eliminated[i] && (k<0 || adj[i].size()<adj[k].size()))
+        k = i;
+    order[p] = k;
+    eliminated[k] = true;
+    coupled[k].assign(adj[k].begin(), adj[k].end());
+    for (i=0; i<(int)coupled[k].size(); i++){
+      int a = coupled[k][i];
+      adj[a].erase(k);
+      for (j=0; j<(int)coupled[k].size(); j++)
+        if (coupled[k][j] != a)
+          adj[a].insert(coupled[k][j]);
+    }
+  }
+
+  // Storage of the non zero blocks
+  int nValues = 0, nInverse = 0, maxSize = 0;
+  offset.assign(nb*nb, -1);
+  invOffset.resize(nb);
+  for (k=0; k<nb; k++){
+    offset[k*nb+k] = nValues;
+    nValues += size[k]*size[k];
+    invOffset[k] = nInverse;
+    nInverse += size[k]*size[k];
+    if (size[k] > maxSize)
+      maxSize = size[k];
+    for (i=0; i<(int)coupled[k].size(); i++){
+      j = coupled[k][i];
+      offset[k*nb+j] = nValues;
+      nValues += size[k]*size[j];
+      offset[j*nb+k] = nValues;
+      nValues += size[j]*size[k];
+    }
+  }
+  values.resize(nValues);
+  inverse.resize(nInverse);
+  work.resize(2*maxSize*maxSize);
+  x.resize(n);
+}
+
+// Gauss-Jordan inversion with partial pivoting of the diagonal block k
+int BlockLUfactorize::InvertBlock(int k)
+{
+  int i, j, r, piv;
+  int m = size[k];
+  double *a = &work[0];
+  double *inv = &inverse[invOffset[k]];
+  double *akk = &values[offset[k*nb+k]];
+
+  for (i=0; i<m*m; i++){
+    a[i] = akk[i];
+    inv[i] = 0.0;
+  }
+  for (i=0; i<m; i++)
+    inv[i*m+i] = 1.0;
+
+  for (j=0; j<m; j++){
+    // Locate Pivot Element
+    piv = j;
+    for (r=j+1; r<m; r++)
+      if (fabs(a[r*m+j]) > fabs(a[piv*m+j]))
+        piv = r;
+    if (fabs(a[piv*m+j]) < DBL_EPSILON)
+      return SINGUL;
+    if (piv != j)
+      for (i=0; i<m; i++){
+        double temp = a[j*m+i]; a[j*m+i] = a[piv*m+i]; a[piv*m+i] = temp;
+        temp = inv[j*m+i]; inv[j*m+i] = inv[piv*m+i]; inv[piv*m+i] = temp;
+      }
+    double a_jj = a[j*m+j];
+    for (i=0; i<m; i++){
+      a[j*m+i] /= a_jj;
+      inv[j*m+i] /= a_jj;
+    }
+    for (r=0; r<m; r++){
+      if (r == j) continue;
+      double f = a[r*m+j];
+      if (f == 0.0) continue;
+      for (i=0; i<m; i++){
+        a[r*m+i] -= f*a[j*m+i];
+        inv[r*m+i] -= f*inv[j*m+i];
+      }
+    }
+  }
+  return OK;
+}
+
+// Decompose mat
+void BlockLUfactorize::Decompose(DMatrix &mat)
+{
+  int i, j, k, p, r, c, l;
+
+  // Gather the non zero blocks
+  const double *m = mat.getData();
+  for (i=0; i<nb; i++)
+    for (j=0; j<nb; j++){
+      double *aij = (offset[i*nb+j] < 0) ? NULL : &values[offset[i*nb+j]];
+      if (aij == NULL) continue;
+      for (r=0; r<size[i]; r++)
+        for (c=0; c<size[j]; c++)
+          aij[r*size[j]+c] = m[(start[i]+r)*n + start[j]+c];
+    }
+
+  // Block elimination
+  for (p=0; p<nb; p++){
+    k = order[p];
+    if (InvertBlock(k) == SINGUL){
+      std::cout << "SDIRK: Warning in BlockLUfactorize::Decompose: Matrix singular\n";
+      exit(0);
+    }
+    double *inv = &inverse[invOffset[k]];
+    for (l=0; l<(int)coupled[k].size(); l++){
+      i = coupled[k][l];
+      // Multiplier L_ik = A_ik inv(A_kk), stored in place of A_ik
+      double *aik = &values[offset[i*nb+k]];
+      double *lik = &work[0];
+      for (r=0; r<size[i]; r++)
+        for (c=0; c<size[k]; c++){
+          double sum = 0.0;
+          for (int s=0; s<size[k]; s++)
+            sum += aik[r*size[k]+s]*inv[s*size[k]+c];
+          lik[r*size[k]+c] = sum;
+        }
+      for (r=0; r<size[i]*size[k]; r++)
+        aik[r] = lik[r];
+      // Schur complement A_ij -= L_ik A_kj
+      for (int q=0; q<(int)coupled[k].size(); q++){
+        j = coupled[k][q];
+        double *akj = &values[offset[k*nb+j]];
+        double *aij = &values[offset[i*nb+j]];
+        for (r=0; r<size[i]; r++)
+          for (int s=0; s<size[k]; s++){
+            double f = aik[r*size[k]+s];
+            if (f == 0.0) continue;
+            for (c=0; c<size[j]; c++)
+              aij[r*size[j]+c] -= f*akj[s*size[j]+c];
+          }
+      }
+    }
+  }
+}
+
+// Solve with respect to vec.
+// On return, vec contains the solution
+void BlockLUfactorize::Solve(DVector &vec)
+{
+  SolveVector(vec.getVector());
+}
+
+// Solve wrt. v (0-based)
+void BlockLUfactorize::SolveVector(double *v)
+{
+  int i, j, k, p, r, c, l;
+
+  for (i=0; i<n; i++)
+    x[i] = v[i];
+
+  // Forward substitution
+  for (p=0; p<nb; p++){
+    k = order[p];
+    for (l=0; l<(int)coupled[k].size(); l++){
+      i = coupled[k][l];
+      double *lik = &values[offset[i*nb+k]];
+      for (r=0; r<size[i]; r++)
+        for (c=0; c<size[k]; c++)
+          x[start[i]+r] -= lik[r*size[k]+c]*x[start[k]+c];
+    }
+  }
+
+  // Backward substitution
+  for (p=nb-1; p>=0; p--){
+    k = order[p];
+    double *t = &work[0];
+    for (r=0; r<size[k]; r++)
+      t[r] = x[start[k]+r];
+    for (l=0; l<(int)coupled[k].size(); l++){
+      j = coupled[k][l];
+      double *akj = &values[offset[k*nb+j]];
+      for (r=0; r<size[k]; r++)
+        for (c=0; c<size[j]; c++)
+          t[r] -= akj[r*size[j]+c]*x[start[j]+c];
+    }
+    double *inv = &inverse[invOffset[k]];
+    for (r=0; r<size[k]; r++){
+      double sum = 0.0;
+      for (c=0; c<size[k]; c++)
+        sum += inv[r*size[k]+c]*t[c];
+      x[start[k]+r] = sum;
+    }
+  }
+
+  for (i=0; i<n; i++)
+    v[i] = x[i];
+}
+
+// Number of stored non zero blocks
+int BlockLUfactorize::GetNumberOfBlocks()
+{
+  int nBlocks = 0;
+  for (int i=0; i<nb*nb; i++)
+    if (offset[i] >= 0)
+      nBlocks++;
+  return nBlocks;
+}
@@ -0,0 +1,86 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ */
+
+/**************************************************
+ * Include file for block sparse LU class         *
+ **************************************************/
+
+#ifndef __blocklu_h
+#define __blocklu_h
+
+#include "linsolver.h"
+
+#include <vector>
+
+// Solves a linear system with a block sparse matrix.
+// The unknowns are split in blocks of consecutive indices, and the couplings list
+// for every block row the block columns that are (structurally) non zero.
+// The blocks are eliminated in minimum degree order, such that a tree of couplings
+// (car body - bogie frames - wheel sets) is factorized without fill in. Only the
+// non zero blocks are stored and factorized, the pivoting is within the diagonal blocks.
+class BlockLUfactorize : public LinearSolver
+{
+private:
+  // Size
+  int n;
+  // Number of blocks
+  int nb;
+  // First index (0-based) and size of the blocks
+  std::vector<int> start, size;
+  // Elimination order of the blocks
+  std::vector<int> order;
+  // Blocks coupled to each block when it is eliminated
+  std::vector< std::vector<int> > coupled;
+  // Offset of the block (i,j) in values (-1 if the block is zero)
+  std::vector<int> offset;
+  // Non zero blocks (row major). After the decomposition the blocks below
+  // the diagonal hold the multipliers A_ik inv(A_kk)
+  std::vector<double> values;
+  // Inverses of the diagonal blocks and their offsets
+  std::vector<double> inverse;
+  std::vector<int> invOffset;
+  // Scratch space
+  std::vector<double> work;
+  std::vector<double> x;
+  // Compute the elimination order and the fill in
+  void Symbolic(const std::vector< std::vector<int> > &coupling);
+  // Invert the diagonal block k
+  int InvertBlock(int k);
+  // Solve wrt. v (0-based). On return, v contains the solution
+  void SolveVector(double *v);
+public:
+  // Constructor
+  BlockLUfactorize(int dim,
+                   const std::vector<int> &blockStart,
+                   const std::vector<int> &blockSize,
+                   const std::vector< std::vector<int> > &coupling);
+  // Destructor
+  ~BlockLUfactorize();
+  // Decompose mat (mat is not modified)
+  void Decompose(DMatrix &mat);
+  // Solve wrt. vec
+  void Solve(DVector &vec);
+  // Number of stored non zero blocks
+  int GetNumberOfBlocks();
+};
+#endif
@@ -0,0 +1,178 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ */
+
+/**************************************************
+ * Source file for contiguous dense LU class      *
+ **************************************************/
+
+#include "denselu.h"
+
+#include <stdint.h>
+
+// Row padding and alignment (in doubles, 64 bytes)
+#define DENSELU_ALIGN 8
+// Width of the panels of the blocked decomposition
+#define DENSELU_PANEL 32
+
+// Constructor
+DenseLUfactorize::DenseLUfactorize(int dim)
+{
+  n = dim;
+  ld = ((n + DENSELU_ALIGN - 1) / DENSELU_ALIGN) * DENSELU_ALIGN;
+  memory = new double[ld*n + DENSELU_ALIGN];
+  uintptr_t addr = (uintptr_t) memory;
+  uintptr_t bytes = DENSELU_ALIGN * sizeof(double);
+  lu = (double*) ((addr + bytes - 1) / bytes * bytes);
+  for (int i=0; i<ld*n; i++)
+    lu[i] = 0.0;
+  perm.resize(n);
+  work.resize(n);
+}
+
+// Destructor
+DenseLUfactorize::~DenseLUfactorize()
+{
+  delete [] memory;
+}
+
+// Factorize the columns k0..k0+kb-1 of the rows k0..n-1.
+// The row interchanges are applied to the whole rows.
+int DenseLUfactorize::FactorPanel(int k0, int kb)
+{
+  int i, j, k, p;
+  double maxsofar, a;
+
+  for (k=k0; k<k0+kb; k++){
+    // Pivot search
+    p = k;
+    maxsofar = fabs(lu[k*ld+k]);
+    for (i=k+1; i<n; i++){
+      a = fabs(lu[i*ld+k]);
+      if (a > maxsofar){
+        maxsofar = a;
+        p = i;
+      }
+    }
+    if (maxsofar == 0.0)
+      return k;
+    if (p != k){
+      double *rk = &lu[k*ld];
+      double *rp = &lu[p*ld];
+      for (j=0; j<n; j++){
+        a = rk[j]; rk[j] = rp[j]; rp[j] = a;
+      }
+      i = perm[k]; perm[k] = perm[p]; perm[p] = i;
+    }
+
+    // Multipliers and update of the rest of the panel
+    const double *rk = &lu[k*ld];
+    double inv = 1.0 / rk[k];
+    for (i=k+1; i<n; i++){
+      double *ri = &lu[i*ld];
+      double l = ri[k] * inv;
+      ri[k] = l;
+      for (j=k+1; j<k0+kb; j++)
+        ri[j] -= l*rk[j];
+    }
+  }
+  return -1;
+}
+
+// Decompose mat
+void DenseLUfactorize::Decompose(DMatrix &mat)
+{
+  int i, j, k, k0, kb, j0, j1;
+
+  const double *m = mat.getData();
+  for (i=0; i<n; i++){
+    perm[i] = i;
+    for (j=0; j<n; j++)
+      lu[i*ld+j] = m[i*n+j];
+  }
+
+  for (k0=0; k0<n; k0+=DENSELU_PANEL){
+    kb = (n-k0 < DENSELU_PANEL) ? n-k0 : DENSELU_PANEL;
+
+    if (FactorPanel(k0, kb) >= 0){
+      std::cout << "SDIRK: Warning in DenseLUfactorize::Decompose: Matrix singular\n";
+      exit(0);
+    }
+
+    // Rows of U right of the panel: U12 = inv(L11) A12
+    for (k=k0; k<k0+kb; k++){
+      const double *rk = &lu[k*ld];
+      for (i=k+1; i<k0+kb; i++){
+        double *ri = &lu[i*ld];
+        double l = ri[k];
+        for (j=k0+kb; j<n; j++)
+          ri[j] -= l*rk[j];
+      }
+    }
+
+    // Trailing update A22 -= L21 U12, by stripes of columns that fit in cache
+    for (j0=k0+kb; j0<n; j0+=8*DENSELU_PANEL){
+      j1 = (n < j0+8*DENSELU_PANEL) ? n : j0+8*DENSELU_PANEL;
+      for (i=k0+kb; i<n; i++){
+        double *ri = &lu[i*ld];
+        for (k=k0; k<k0+kb; k++){
+          double l = ri[k];
+          const double *rk = &lu[k*ld];
+          for (j=j0; j<j1; j++)
+            ri[j] -= l*rk[j];
+        }
+      }
+    }
+  }
+}
+
+// Solve wrt. vec. On return, vec contains the solution
+void DenseLUfactorize::Solve(DVector &vec)
+{
+  int i, k;
+  double *b = vec.getVector();
+  double *x = &work[0];
+
+  for (i=0; i<n; i++)
+    x[i] = b[perm[i]];
+
+  // Forward substitution (unit lower triangular)
+  for (i=1; i<n; i++){
+    const double *ri = &lu[i*ld];
+    double xi = x[i];
+    for (k=0; k<i; k++)
+      xi -= ri[k]*x[k];
+    x[i] = xi;
+  }
+
+  // Backward substitution
+  for (i=n-1; i>=0; i--){
+    const double *ri = &lu[i*ld];
+    double xi = x[i];
+    for (k=i+1; k<n; k++)
+      xi -= ri[k]*x[k];
+    x[i] = xi / ri[i];
+  }
+
+  for (i=0; i<n; i++)
+    b[i] = x[i];
+}
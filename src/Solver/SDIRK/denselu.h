@@ -0,0 +1,70 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ */
+
+/**************************************************
+ * Include file for contiguous dense LU class     *
+ **************************************************/
+
+#ifndef __denselu_h
+#define __denselu_h
+
+#include "linsolver.h"
+
+#include <vector>
+
+// Solves a linear system with a dense matrix.
+// The factors are stored in one contiguous, aligned, row major array (rows padded
+// to DENSELU_ALIGN doubles), so that the inner loops run over consecutive memory
+// and can be vectorized. The decomposition is a right looking LU with partial
+// pivoting by panels of DENSELU_PANEL columns, such that the trailing update
+// reuses each panel while it is in cache. The solve works in place.
+class DenseLUfactorize : public LinearSolver
+{
+private:
+  // Size
+  int n;
+  // Leading dimension (padded row length)
+  int ld;
+  // Allocated memory and aligned factors: L (unit diagonal) below and U above
+  double *memory;
+  double *lu;
+  // Permutation: row i of the factors is row perm[i] of the matrix
+  std::vector<int> perm;
+  // Scratch space for the permuted right hand sides
+  std::vector<double> work;
+  // Factorize the panel of columns k0..k0+kb-1. Returns the singular column or -1
+  int FactorPanel(int k0, int kb);
+  // Not copyable: memory is owned
+  DenseLUfactorize(const DenseLUfactorize &);
+  DenseLUfactorize &operator=(const DenseLUfactorize &);
+public:
+  // Constructor
+  DenseLUfactorize(int dim);
+  // Destructor
+  ~DenseLUfactorize();
+  // Decompose mat (mat is not modified)
+  void Decompose(DMatrix &mat);
+  // Solve wrt. vec
+  void Solve(DVector &vec);
+};
+#endif
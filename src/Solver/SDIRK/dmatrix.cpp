@@ -32,27 +32,20 @@
 // Constructors
 // Specifying index limits
 DMatrix::DMatrix(int x_lo, int x_hi, int y_lo, int y_hi){
-  x1 = x_lo;
-  x2 = x_hi;
-  y1 = y_lo;
-  y2 = y_hi;
-  Dimension(x1, x2, y1, y2);
-  DimOk = TRUE;
+  DimOk = FALSE;
+  Dimension(x_lo, x_hi, y_lo, y_hi);
 }
 
 // Specifying dimension
 DMatrix::DMatrix(int n, int m){
-  x1 = 1;
-  x2 = n;
-  y1 = 1;
-  y2 = m;
-  Dimension(x1, x2, y1, y2);
-  DimOk = TRUE;
+  DimOk = FALSE;
+  Dimension(1, n, 1, m);
 }
 
 // Empty matrix
 DMatrix::DMatrix(){
-  x1 = x2 = y1 = y2 = 0;
+  x1 = x2 = y1 = y2 = nc = 0;
+  mat = memory = NULL;
   DimOk = FALSE;
 }
 
@@ -60,70 +53,46 @@ DMatrix::DMatrix(){
 // Needed, since the = operator is overloaded
 DMatrix::DMatrix(const DMatrix & m)
 {
-  x1 = m.x1;
-  x2 = m.x2;
-  y1 = m.y1;
-  y2 = m.y2;
-  
-  // Allocate memory 
-  unsigned size = x2 - x1 + 1;
-  mat = new double* [size];
-  if(mat == NULL)
-    ErrorHandler(M_ALLOC);
-  size = y2 - y1 + 1;
-  for(int i=0; i<=x2-x1; i++){
-    mat[i] = new double[size];
-    if(mat[i] == NULL)
-      ErrorHandler(M_ALLOC);
-  }
+  DimOk = FALSE;
+  Dimension(m.x1, m.x2, m.y1, m.y2);
 
   // Copy values
-  for(int i = 0; i <= x2-x1; i++)
-    for(int j = 0; j <= y2-y1; j++)
-      mat[i][j] = m.mat[i][j];
-  DimOk = TRUE;
+  for(int i = 0; i < (x2-x1+1)*nc; i++)
+    mat[i] = m.mat[i];
 }
 
 // Allocate memory to empty matrix (normal init)
 void DMatrix::Dimension(int x_lo, int x_hi, int y_lo, int y_hi){
+  if (DimOk) delete [] memory;
   x1 = x_lo;
   x2 = x_hi;
   y1 = y_lo;
   y2 = y_hi;
+  nc = y2 - y1 + 1;
   DimOk = TRUE;
   
-  // Allocate memory
-  unsigned size = x2 - x1 + 1;
-  mat = new double* [size];
+  // Allocate memory (initial value: Zero)
+  mat = AlignedAlloc((x2 - x1 + 1) * nc, memory);
   if(mat == NULL)
     ErrorHandler(M_ALLOC);
-  size = y2 - y1 + 1;
-  for(int i=0; i<=x2-x1; i++){
-    mat[i] = new double[size];
-    if(mat[i] == NULL)
-      ErrorHandler(M_ALLOC);
-  }
-
-  // Initial value: Zero
-  for(int i = 0; i <= x2-x1; i++)
-    for(int j = 0; j <= y2-y1; j++)
-      mat[i][j] = 0.;
 }
 
 // Destructor
 DMatrix::~DMatrix(){
-  if(DimOk){
-    for(int i=x2-x1 ; i>=0; i--)
-      delete mat[i];
-    delete mat;
-  }
+  if(DimOk)
+    delete [] memory;
 }
 
 // Index operator
 double& DMatrix::operator ()(int index_x, int index_y){
   if( (index_x<x1) || (index_x>x2) || (index_y<y1) || (index_y>y2))
     ErrorHandler(M_RANGE);
-  return( (double&) mat[index_x - x1][index_y - y1]);
+  return( (double&) mat[(index_x - x1)*nc + index_y - y1]);
+}
+
+// Contiguous storage
+double* DMatrix::getData(){
+  return mat;
 }
 
 // = method
@@ -132,9 +101,8 @@ DMatrix& DMatrix::operator = (const DMatrix& m)
   if(x1 != m.x1 || x2 != m.x2 || y1 != m.y1 || y2 != m.y2)
     ErrorHandler(M_NOT_IDENT);
 
-  for(int i = 0; i <= x2-x1; i++)
-    for(int j = 0; j <= y2-y1; j++)
-      mat[i][j] = m.mat[i][j];
+  for(int i = 0; i < (x2-x1+1)*nc; i++)
+    mat[i] = m.mat[i];
   return *this;
 }
 
@@ -144,9 +112,8 @@ DMatrix& DMatrix::operator += (const DMatrix& m)
   if(x1 != m.x1 || x2 != m.x2 || y1 != m.y1 || y2 != m.y2)
     ErrorHandler(M_NOT_IDENT);
   
-  for(int i=0; i<=x2-x1; i++)
-    for(int j=0; j<=y2-y1; j++)
-      mat[i][j] += m.mat[i][j];
+  for(int i = 0; i < (x2-x1+1)*nc; i++)
+    mat[i] += m.mat[i];
   return *this;
 }
 
@@ -156,9 +123,8 @@ DMatrix& DMatrix::operator -= (const DMatrix& m)
   if(x1 != m.x1 || x2 != m.x2 || y1 != m.y1 || y2 != m.y2)
     ErrorHandler(M_NOT_IDENT);
 
-  for(int i = 0; i <= x2-x1; i++)
-    for(int j = 0; j <= y2-y1; j++)
-      mat[i][j] -= m.mat[i][j];
+  for(int i = 0; i < (x2-x1+1)*nc; i++)
+    mat[i] -= m.mat[i];
   return *this;
 }
 
@@ -169,9 +135,8 @@ DMatrix DMatrix::operator+(const DMatrix& m)
     ErrorHandler(M_NOT_IDENT);
   DMatrix temp(m.x1, m.x2, m.y1, m.y2);
 
-  for(int i=0; i<=(m.x2-m.x1); i++)
-    for(int j=0; j<=(m.y2-m.y1); j++)
-      temp.mat[i][j] = m.mat[i][j] + mat[i][j];
+  for(int i = 0; i < (x2-x1+1)*nc; i++)
+    temp.mat[i] = m.mat[i] + mat[i];
   return temp;
 }
 
@@ -182,9 +147,8 @@ DMatrix DMatrix::operator-(const DMatrix& m)
     ErrorHandler(M_NOT_IDENT);
   DMatrix temp(m.x1, m.x2, m.y1, m.y2);
 
-  for(int i=0; i<=(m.x2-m.x1); i++)
-    for(int j=0; j<=(m.y2-m.y1); j++)
-      temp.mat[i][j] = m.mat[i][j] - mat[i][j];
+  for(int i = 0; i < (x2-x1+1)*nc; i++)
+    temp.mat[i] = m.mat[i] - mat[i];
   return temp;
 }
 
@@ -219,7 +183,7 @@ std::ostream& operator << (std::ostream& os, const DMatrix& m)
 {
   for (int i=m.x1; i<=m.x2; i++)
     for (int j=m.y1; j<=m.y2; j++){
-      os << "(" << i << "," << j << ")=" << m.mat[i-1][j-1] << "   ";
+      os << "(" << i << "," << j << ")=" << m.mat[(i-m.x1)*m.nc + j-m.y1] << "   ";
       if (j==m.y2)
 	os << "\n";
     }
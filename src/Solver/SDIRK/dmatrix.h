@@ -37,8 +37,12 @@ class DMatrix
 private:
   // Matrix dimension:  (x2-x1+1) X (y2-y1+1)
   int x1, x2, y1, y2;
-  // Pointer to the elements in the matrix
-  double **mat;
+  // Number of columns (row length of the storage)
+  int nc;
+  // Elements, row major in one contiguous aligned block
+  double *mat;
+  // Allocated memory
+  double *memory;
   // Boolean indicating wheather the dimension of the vector is okay or not
   BOOL DimOk;
   // Error handler
@@ -58,6 +62,9 @@ public:
   static void SetErrorHandler(void(*user_handler)(MatError err));
   // () operator overloaded as matrix subscript operator
   double& operator ()(int index_x, int index_y);
+  // Contiguous row major storage of the elements. It can be passed to the
+  // model as a C array or viewed with gsl_matrix_view_array
+  double* getData();
   // Assignment methods
   DMatrix& operator =  (const DMatrix& m);
   DMatrix& operator += (const DMatrix& m);
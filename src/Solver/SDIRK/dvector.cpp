@@ -34,19 +34,28 @@
 // Constructors
 // Specifying index limits
 DVector::DVector(int lo, int hi){
+  DimOk = FALSE;
   Dimension(lo, hi);
-  DimOk = TRUE;
 }
 // Specifying size
 DVector::DVector(int size){
+  DimOk = FALSE;
   Dimension(1, size);
-  DimOk = TRUE;
 }
 // Unspecified index limits
 DVector::DVector(){
   upper = lower = 0;
+  vec = memory = NULL;
   DimOk = FALSE;
 }
+// View of external storage
+DVector::DVector(double *data, int size){
+  lower = 1;
+  upper = size;
+  vec = data;
+  memory = NULL;
+  DimOk = TRUE;
+}
 
 // Copy constructor
 // Needed, since the = operator is overloaded
@@ -55,9 +64,7 @@ DVector::DVector(const DVector & v)
   upper = v.upper;
   lower = v.lower;
   unsigned size = upper - lower + 1;
-  vec = new double[size];
-  for (int i=0; i<size; i++)
-    vec[i]=0.;
+  vec = AlignedAlloc(size, memory);
   if (vec == NULL)
     ErrorHandler(V_ALLOC);
 
@@ -69,19 +76,20 @@ DVector::DVector(const DVector & v)
 
 // Destructor
 DVector::~DVector(){
-  if (DimOk) delete vec;
+  if (DimOk) delete [] memory;
 }
 
 // Initializing the vector. Alloating memory.
 void DVector::Dimension(int lo, int hi){
   unsigned size;
+  if (DimOk) delete [] memory;
   upper = hi;
   lower = lo;
   DimOk = TRUE;
   size = upper - lower + 1;
-  vec = new double[size];
-  for (int i=0; i<size; i++)
-    vec[i]=0.;
+  vec = AlignedAlloc(size, memory);
+  if (vec == NULL)
+    ErrorHandler(V_ALLOC);
 }
 
 // Calculate the norm of the vector
@@ -198,7 +206,8 @@ std::ostream& operator << (std::ostream& os, const DVector& v)
 }
 
 void DVector::setVector(double* vec){
-    delete[] this->vec;
+    if (DimOk) delete[] this->memory;
+    this->memory = NULL;
     this->vec = vec;
 }
 
@@ -37,8 +37,10 @@ class DVector
 private:
   // Upper and lower limits for index
   int upper, lower;
-  // Pointer to the elements of the vector
+  // Pointer to the elements of the vector (contiguous, aligned)
   double *vec;
+  // Allocated memory (NULL if vec is external storage)
+  double *memory;
   // Boolean indicating wheather the dimension of the vector is okay or not
   BOOL DimOk;
   // Pointer to errorhandler
@@ -48,6 +50,8 @@ public:
   DVector(int lo, int hi);
   DVector(int size);
   DVector();
+  // View of the external storage data[0..size-1] (indices 1..size)
+  DVector(double *data, int size);
   // Copy constructor
   DVector(const DVector& v);
   // Destructor
@@ -70,7 +74,9 @@ public:
   // Flush to ostream
   friend std::ostream& operator << (std::ostream& os, const DVector& v);
 
+  // Use the external storage vec (not owned) for the elements
   void setVector(double *vec);
+  // Contiguous storage of the elements
   double* getVector();
 };
 #endif
@@ -34,13 +34,13 @@
 // Constructors
 // Specifying index limits
 IVector::IVector(int lo, int hi){
+  DimOk = FALSE;
   Dimension(lo, hi);
-  DimOk = TRUE;
 }
 // Specifying size
 IVector::IVector(int size){
+  DimOk = FALSE;
   Dimension(1, size);
-  DimOk = TRUE;
 }
 // Unspecified index limits
 IVector::IVector(){
@@ -69,12 +69,13 @@ IVector::IVector(const IVector & v)
 
 // Destructor
 IVector::~IVector(){
-  if (DimOk) delete vec;
+  if (DimOk) delete [] vec;
 }
 
 // Initializing the vector. Alloating memory.
 void IVector::Dimension(int lo, int hi){
   unsigned size;
+  if (DimOk) delete [] vec;
   upper = hi;
   lower = lo;
   DimOk = TRUE;
@@ -0,0 +1,44 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ */
+
+/**************************************************
+ * Include file for the linear solver interface   *
+ **************************************************/
+
+#ifndef __linsolver_h
+#define __linsolver_h
+
+#include "dmatrix.h"
+#include "dvector.h"
+
+// Interface of the solvers of the linear systems of the Newton iterations
+class LinearSolver
+{
+public:
+  virtual ~LinearSolver(){}
+  // Decompose mat
+  virtual void Decompose(DMatrix &mat) = 0;
+  // Solve wrt. vec. On return, vec contains the solution
+  virtual void Solve(DVector &vec) = 0;
+};
+#endif
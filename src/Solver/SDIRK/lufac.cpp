@@ -33,7 +33,7 @@
 
 // Prototypes
 int LU_decompose(DMatrix &a, IVector &index, int n);
-int LU_solve(DMatrix &a, DVector &b, int n, IVector &index);
+int LU_solve(DMatrix &a, DVector &b, int n, IVector &index, DVector &temp);
 
 // Constructor
 LUfactorize::LUfactorize(int dim)
@@ -47,6 +47,8 @@ LUfactorize::LUfactorize(int dim)
 
   b.Dimension(1,n);
   b = DVector(n);
+
+  temp.Dimension(1,n);
 }
 
 // Destructor
@@ -72,7 +74,7 @@ void LUfactorize::Decompose(DMatrix &mat)
 void LUfactorize::Solve(DVector &vec)
 {
   b = vec;
-  int cond = LU_solve(a, b, n, index);
+  int cond = LU_solve(a, b, n, index, temp);
   vec = b;
 }
 
@@ -142,13 +144,12 @@ int LU_decompose(DMatrix &a, IVector &index, int n)
 
 /* LU_solve
  * Solves a linear system, which is decomposed using LU_decompose.
- * The output is the solution vector.
+ * The output is the solution vector. temp is a work vector of size n.
  */
-int LU_solve(DMatrix &a, DVector &b, int n, IVector &index)
+int LU_solve(DMatrix &a, DVector &b, int n, IVector &index, DVector &temp)
 {
   int i, j, ii, jj;
   double p_sum;
-  DVector temp(n);
 
   /* Forward substitution */
   for (i=1; i<=n; i++) {
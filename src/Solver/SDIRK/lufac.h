@@ -30,12 +30,11 @@
 #ifndef __lufac_h
 #define __lufac_h
 
-#include "dmatrix.h"
-#include "dvector.h"
+#include "linsolver.h"
 #include "ivector.h"
 
 // Solves a linear system
-class LUfactorize
+class LUfactorize : public LinearSolver
 {
 private:
   // Size
@@ -46,6 +45,8 @@ private:
   DMatrix a;
   // RHS vector b
   DVector b;
+  // Work vector of the permutation
+  DVector temp;
 public:
   // Constructor
   LUfactorize(int dim);
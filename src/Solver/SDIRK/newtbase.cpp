@@ -32,18 +32,33 @@
 // Constructor
 NewtonRaphsonBase::NewtonRaphsonBase
 (double accur, int dimen,
- int(* fun)(double t, DVector &y, DVector &f),
- int(* jac)(double t, DVector &y, DMatrix &j)
+ int(* fun)(double t, DVector &y, DVector &f, void *params),
+ int(* jac)(double t, DVector &y, DMatrix &j, void *params),
+ void *params
  )
 {
   Eps = accur;
   N = dimen;
   UserF = fun;
   UserJacobi = jac;
+  UserParams = params;
   Jacobi.Dimension(1,N,1,N);
   LinSolver = new LUfactorize(N);
 }
 
+// Destructor
+NewtonRaphsonBase::~NewtonRaphsonBase()
+{
+  delete LinSolver;
+}
+
+// Replace the linear system solver
+void NewtonRaphsonBase::SetLinearSolver(LinearSolver *solver)
+{
+  delete LinSolver;
+  LinSolver = solver;
+}
+
 // Dummy function to avoid all the warnings
 // Exact definition if found in the source of the derived: sdirknewt.cc
 void NewtonRaphsonBase::NewtonMatrix(DMatrix &jacobi)
@@ -42,16 +42,24 @@ protected:
   // Jacobi matrix
   DMatrix Jacobi;
   // Pointer to usersupplied ODE system
-  int(* UserF)(double t, DVector & y, DVector &f);
+  int(* UserF)(double t, DVector & y, DVector &f, void *params);
   // Pointer to usersupplied Jacobian
-  int(* UserJacobi)(double t, DVector &y, DMatrix &jacobi);
+  int(* UserJacobi)(double t, DVector &y, DMatrix &jacobi, void *params);
+  // User context passed to the ODE system and to the Jacobian
+  void *UserParams;
   // Pointer to the linear system solver
-  LUfactorize *LinSolver;
+  LinearSolver *LinSolver;
 public:
   // Constructor
   NewtonRaphsonBase(double accur, int dimen,
-		    int(* fun)(double t, DVector &y, DVector &f),
-		    int(* jac)(double t, DVector &y, DMatrix &j));
+		    int(* fun)(double t, DVector &y, DVector &f, void *params),
+		    int(* jac)(double t, DVector &y, DMatrix &j, void *params),
+		    void *params);
+  // Destructor
+  ~NewtonRaphsonBase();
+  // Replace the linear system solver (dense LU by default). The solver is owned
+  // by the iterator.
+  void SetLinearSolver(LinearSolver *solver);
   // Calculate the Newton matrix  
   virtual void NewtonMatrix(DMatrix &jacobi);
   // Calculate an initial guess for the iterations
@@ -50,10 +50,12 @@ static void DefaultErrorHandler(RKError err)
 
 // Constructor
 RKbase::RKbase(double accur, int num_ode,
-               int(* fun)(double t, DVector &y, DVector &f) )
+               int(* fun)(double t, DVector &y, DVector &f, void *params),
+               void *params )
 {
   N = num_ode;
   UserF = fun;
+  UserParams = params;
   AssignHandler(&DefaultErrorHandler);
   Error.Dimension(1,N);
   StepY.Dimension(1,N);
@@ -45,7 +45,9 @@ protected:
   DMatrix K;
   DVector Error, StepY;
   // Pointer to righthand side function
-  int(* UserF)(double t, DVector &y_in, DVector &y_out);
+  int(* UserF)(double t, DVector &y_in, DVector &y_out, void *params);
+  // User context passed to the righthand side function
+  void *UserParams;
   // Pointer to errorhandler
   void( *ErrorHandler)(RKError err);
   // Butcher Tableau
@@ -60,7 +62,8 @@ protected:
 public:
   // Constructor
   RKbase(double accur, int num_ode,
-	 int(* fun)(double t, DVector &y, DVector &f) );
+	 int(* fun)(double t, DVector &y, DVector &f, void *params),
+	 void *params );
   // Integrate the system, one RK iteration
   virtual int Integrate(double &t, double &h, DVector &y) = 0;
   // Assign a user errorhandler
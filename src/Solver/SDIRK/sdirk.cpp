@@ -33,11 +33,12 @@
 // Constructor
 Sdirk::Sdirk(double accur,
 	     int num_ode,
-             int(* fun)(double t, DVector &y, DVector &f),
-             int(* jac)(double t, DVector &y, DMatrix &j),
+             int(* fun)(double t, DVector &y, DVector &f, void *params),
+             int(* jac)(double t, DVector &y, DMatrix &j, void *params),
+             void *params,
              StepControlType ctrl,
              SDIRKMethodType methodType)
- : RKbase(accur, num_ode, fun)
+ : RKbase(accur, num_ode, fun, params)
 { 
   if (accur*DEF_NEWTON_FAC<=DBL_EPSILON){
     std::cout << "SDIRK: Error in constructor.\nEps must be " << 1/DEF_NEWTON_FAC;
@@ -45,13 +46,15 @@ Sdirk::Sdirk(double accur,
     exit(0);
   }
   // An instance of the SdirkNewtonRaphson class
-  Newton = new SdirkNewtonRaphson(this, accur, num_ode, fun, jac);
+  Newton = new SdirkNewtonRaphson(this, accur, num_ode, fun, jac, params);
   if (Newton==NULL)
     ErrorHandler(SE_ALLOC);
   // Select Butcher Tableau
   SelectMethod(methodType, Method);
   // Placeholders for coefficients
   OldK.Dimension(1, Method.stage, 1, num_ode);
+  YTemp.Dimension(1, num_ode);
+  KTemp.Dimension(1, num_ode);
   K.Dimension(1, Method.stage, 1, num_ode);
   
   switch(ctrl){
@@ -271,6 +274,7 @@ void Sdirk::Reset()
   Info.NumOfGoodStep = 0;
   Info.NumOfBadStep = 0;
   Info.NumOfNewtonDivergens = 0;
+  Newton->Reset();
   StepControl->Reset();
 }
 
@@ -280,12 +284,19 @@ void Sdirk::SetEps(double eps)
   StepControl->SetEps(eps);
 };
 
+// Set the solver of the linear systems of the Newton iterations
+void Sdirk::SetLinearSolver(LinearSolver *solver)
+{
+  Newton->SetLinearSolver(solver);
+};
+
 // Get information on the recent integration
 void Sdirk::GetInfo(SdirkInfoType &p)
 {
   p.NumOfGoodStep        = Info.NumOfGoodStep;
   p.NumOfBadStep         = Info.NumOfBadStep;
   p.NumOfNewtonDivergens = Info.NumOfNewtonDivergens;
+  Newton->GetInfo(p);
   p.MaxError = StepControl->GetMaxError();
 }
 
@@ -297,6 +308,9 @@ void Sdirk::ShowInfo()
   std::cout << "SDIRK: Accepted steps  : " << p.NumOfGoodStep << "\n";
   std::cout << "SDIRK: Rejected steps  : " << p.NumOfBadStep << "\n";
   std::cout << "SDIRK: Divergent steps : " << p.NumOfNewtonDivergens << "\n";
+  std::cout << "SDIRK: Jacobians       : " << p.NumOfJacobians << "\n";
+  std::cout << "SDIRK: Factorizations  : " << p.NumOfFactorizations << "\n";
+  std::cout << "SDIRK: Max Jacobian age: " << p.MaxJacobiAge << "\n";
   std::cout << "SDIRK: Maxsimal error  : " << p.MaxError << "\n";
 }
 
@@ -320,6 +334,7 @@ int Sdirk::Integrate(DVector &T, double &h, DVector &y, long &Nstep)
   Info.NumOfGoodStep = 0;
   Info.NumOfBadStep = 0;
   Info.NumOfNewtonDivergens = 0;
+  Newton->Reset();
 
   // Call Integrate until T[2] is reached
   t = T[1];
@@ -347,16 +362,18 @@ int Sdirk::Integrate(double &t, double &h, DVector &y)
 {
   int i, j, num_iteration, stage;
   BOOL step_ok, divergens;
-  DVector y_temp(N), k_temp(N);
+  DVector &y_temp = YTemp, &k_temp = KTemp;
   double it_speed;
   int errCode = GSL_SUCCESS;
   
   StepY = y;
+  if (rktype == IMPLICIT)
+    Newton->NewStep();
 
   if(FirstStep){
     StepH = h;
     StepX = t;
-    errCode = UserF(StepX, y, k_temp);
+    errCode = UserF(StepX, y, k_temp, UserParams);
     if (errCode != GSL_SUCCESS)
         return errCode;
     for(i=1; i<=N; i++)
@@ -394,7 +411,7 @@ int Sdirk::Integrate(double &t, double &h, DVector &y)
 	Info.NumOfNewtonDivergens++;
       }
       else{
-	errCode = UserF(StepX, y_temp, k_temp);
+	errCode = UserF(StepX, y_temp, k_temp, UserParams);
         if (errCode != GSL_SUCCESS)
             return errCode;
 	for (i=1; i<=N; i++)
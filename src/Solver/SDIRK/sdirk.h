@@ -46,6 +46,8 @@ private:
   SdirkNewtonRaphson *Newton;
   // Iteration matrix
   DMatrix OldK;
+  // Stage values and derivatives (work space of Integrate)
+  DVector YTemp, KTemp;
   // Boolean. Is this iteration the first iteration?
   BOOL FirstStep;
   // Declare an SdirkInfoType instance named 'Info'
@@ -69,8 +71,9 @@ public:
   // Constructor
   Sdirk(double accur,
 	int num_ode,
-	int(* fun)(double t, DVector &y, DVector &f),
-	int(* jac)(double t, DVector &y, DMatrix &j),
+	int(* fun)(double t, DVector &y, DVector &f, void *params),
+	int(* jac)(double t, DVector &y, DMatrix &j, void *params),
+	void *params,
 	StepControlType ctrl,
         SDIRKMethodType methodType);
   // Destructor
@@ -85,6 +88,8 @@ public:
   void Reset();
   // Set new value for Eps
   void SetEps(double eps);
+  // Set the solver of the linear systems of the Newton iterations
+  void SetLinearSolver(LinearSolver *solver);
   // Get information about the recent integration
   void GetInfo(SdirkInfoType &p);
   // Show information in a nice way
@@ -35,37 +35,85 @@
 SdirkNewtonRaphson::SdirkNewtonRaphson
 (Sdirk *p, double accur,
  int dimen,
- int(*fun)(double t, DVector &y, DVector &f),
- int(*jac)(double t, DVector &y, DMatrix &jacobi))
-  : NewtonRaphsonBase(accur,dimen, fun, jac)
+ int(*fun)(double t, DVector &y, DVector &f, void *params),
+ int(*jac)(double t, DVector &y, DMatrix &jacobi, void *params),
+ void *params)
+  : NewtonRaphsonBase(accur,dimen, fun, jac, params)
 {
   Integrator = p;
+  UserJac.Dimension(1,N,1,N);
+  YTry.Dimension(1,N);
+  Reset();
 }
 
-// Calculate Newton-Raphson matrix
-int SdirkNewtonRaphson::NewtonMatrix(int stage, DVector &y)
+// Evaluate the Jacobian in y
+int SdirkNewtonRaphson::UpdateJacobi(DVector &y)
+{
+  int errCode = UserJacobi(Integrator->StepX, y, UserJac, UserParams);
+  if (errCode != GSL_SUCCESS)
+    return errCode;
+  HaveJacobi = TRUE;
+  JacobiFresh = TRUE;
+  JacobiStale = FALSE;
+  JacobiAge = 0;
+  NumOfJacobians++;
+  // The factorization belongs to the old Jacobian
+  HaveFactor = FALSE;
+  return errCode;
+}
+
+// Calculate and factorize the Newton-Raphson matrix I - h*gamma*J
+void SdirkNewtonRaphson::NewtonMatrix(int stage)
 {
   int i, j;
-  double gamma, x;
-  int errCode = GSL_SUCCESS;
+  double hgamma;
   
-  x = Integrator->StepX + Integrator->Method.c[stage] * Integrator->StepH;
-  gamma = Integrator->Method.a(stage, stage);
-  
-  errCode = UserJacobi(Integrator->StepX, y, Jacobi);
-  if (errCode != GSL_SUCCESS)
-      return errCode;
+  hgamma = Integrator->StepH * Integrator->Method.a(stage, stage);
   
   for (i=1; i<=N; i++){
     for (j=1; j<=N; j++){
-      Jacobi(i, j) *= Integrator->StepH*gamma;
+      Jacobi(i, j) = - hgamma * UserJac(i, j);
       if(j==i)
-	Jacobi(i, j) = 1.0 - Jacobi(i, j);
-      else
-	Jacobi(i, j) *= -1.0;
+	Jacobi(i, j) += 1.0;
     }
   }
-  return errCode;
+  LinSolver->Decompose(Jacobi);
+  HaveFactor = TRUE;
+  FactorHGamma = hgamma;
+  NumOfFactorizations++;
+}
+
+// A new step begins
+void SdirkNewtonRaphson::NewStep()
+{
+  JacobiFresh = FALSE;
+  if (HaveJacobi){
+    JacobiAge++;
+    if (JacobiAge > MaxJacobiAge)
+      MaxJacobiAge = JacobiAge;
+  }
+}
+
+// Forget the Jacobian and reset the counters
+void SdirkNewtonRaphson::Reset()
+{
+  HaveJacobi = FALSE;
+  JacobiFresh = FALSE;
+  JacobiStale = FALSE;
+  HaveFactor = FALSE;
+  FactorHGamma = 0.0;
+  JacobiAge = 0;
+  NumOfJacobians = 0;
+  NumOfFactorizations = 0;
+  MaxJacobiAge = 0;
+}
+
+// Get the Jacobian counters
+void SdirkNewtonRaphson::GetInfo(SdirkInfoType &p)
+{
+  p.NumOfJacobians      = NumOfJacobians;
+  p.NumOfFactorizations = NumOfFactorizations;
+  p.MaxJacobiAge        = MaxJacobiAge;
 }
 
 // Calculate an initial guess for the Newton-Raphson iterations
@@ -95,7 +143,7 @@ int SdirkNewtonRaphson::NewtonFunction(DVector &y_in,
   int errCode = GSL_SUCCESS;
   
   x = Integrator->StepX + Integrator->Method.c[stage] * Integrator->StepH;
-  errCode = UserF(x, y_in, g_out);
+  errCode = UserF(x, y_in, g_out, UserParams);
   if (errCode != GSL_SUCCESS)
       return errCode;
 
@@ -111,38 +159,40 @@ int SdirkNewtonRaphson::NewtonFunction(DVector &y_in,
 }
 
 // Perform Newton-Raphson iteration
+// The Jacobian is evaluated only when there is none, when it is older than
+// DEF_MAX_JACOBI_AGE steps or when an iteration with it converged slowly or
+// diverged. The Newton matrix is refactorized only when h*gamma changes by
+// more than DEF_REFACTOR_H.
 int SdirkNewtonRaphson::Iterate(int stage, DVector &y_out, double &it_speed, int &div)
 {
   int i, j ;
   BOOL divergens;
-  double roc, new_norm, old_norm, c, sig;
+  double roc, new_norm, old_norm, c, sig, hgamma;
   int p;
-  DVector y_try(N);
+  DVector &y_try = YTry;
   int errCode = GSL_SUCCESS;
 
   // In first step, no initial guess is given
-  if(Integrator->FirstStep){
+  if(Integrator->FirstStep)
     y_out = Integrator->StepY;
-    LastH = Integrator->StepH;
-  }
-  else{
+  else
     InitialGuess(stage, y_out);
-    ThisH = Integrator->StepH;
-  }
 
-  // We avoid to calculate the Jacobian if the step length is unchanged
-  if(stage == 2 && ThisH != LastH){
-    errCode = NewtonMatrix(stage, y_out);
+  if(!HaveJacobi || JacobiStale || JacobiAge > DEF_MAX_JACOBI_AGE){
+    errCode = UpdateJacobi(y_out);
     if (errCode != GSL_SUCCESS)
         return errCode;
-    LinSolver->Decompose(Jacobi);
   }
+  hgamma = Integrator->StepH * Integrator->Method.a(stage, stage);
+  if(!HaveFactor || fabs(hgamma - FactorHGamma) > DEF_REFACTOR_H*fabs(FactorHGamma))
+    NewtonMatrix(stage);
 
   divergens = FALSE;  
 
   // To avoid it_speed to be undefined in case of convergens in 
   // first iteration already, it_speed is set to the machine number
   it_speed = DBL_EPSILON;
+  roc = 0.0;
 
   // First iteration
   i = 1;
@@ -180,11 +230,12 @@ int SdirkNewtonRaphson::Iterate(int stage, DVector &y_out, double &it_speed, int
       new_norm = y_try.Norm(NT_TWO);
       roc = new_norm / old_norm;
       it_speed = roc;
-      if (roc>DEF_NEW_JACOBI_ROC && roc<DEF_DIVERGENS_ROC){
-	errCode = NewtonMatrix(stage, y_out);
+      // Slow convergence: a Jacobian from an earlier step is replaced
+      if (roc>DEF_NEW_JACOBI_ROC && roc<DEF_DIVERGENS_ROC && !JacobiFresh){
+	errCode = UpdateJacobi(y_out);
         if (errCode != GSL_SUCCESS)
             return errCode;
-	LinSolver->Decompose(Jacobi);
+	NewtonMatrix(stage);
       }
       i++;
       if (roc>DEF_DIVERGENS_ROC || i>DEF_MAX_ITERATIONS)
@@ -192,7 +243,11 @@ int SdirkNewtonRaphson::Iterate(int stage, DVector &y_out, double &it_speed, int
       old_norm = new_norm;
     }
   }
-    LastH = ThisH;
+
+    // A divergence or a slow convergence with a Jacobian from an earlier
+    // step asks for a new one
+    if ((divergens || roc>DEF_SLOW_ROC) && !JacobiFresh)
+        JacobiStale = TRUE;
 
     if (divergens)
         div = -1;
@@ -201,4 +256,3 @@ int SdirkNewtonRaphson::Iterate(int stage, DVector &y_out, double &it_speed, int
     
   return errCode;
 }
-
@@ -43,12 +43,27 @@ private:
   BOOL FirstStep;
   // Pointer to the Sdirk class
   Sdirk *Integrator;
-  // Step length variables
-  double ThisH, LastH;
+  // Jacobian of the ODE system. It is kept across the iterations, the stages
+  // and the steps (modified Newton) and the Newton matrix is built from it.
+  DMatrix UserJac;
+  // Newton correction (work space of Iterate)
+  DVector YTry;
+  // Is there a Jacobian? Was it evaluated during the current step?
+  // Must it be recalculated before the next iteration?
+  BOOL HaveJacobi, JacobiFresh, JacobiStale;
+  // Is there a factorization? h*gamma of the factorized Newton matrix
+  BOOL HaveFactor;
+  double FactorHGamma;
+  // Number of steps since the Jacobian was evaluated
+  unsigned long int JacobiAge;
+  // Counters
+  unsigned long int NumOfJacobians, NumOfFactorizations, MaxJacobiAge;
   // Perform the Newton-Raphson iteration
   int NewtonFunction(DVector &y_in, int stage, DVector &g_out);
-  // Calculate the Newton-Raphson matrix
-  int NewtonMatrix(int stage, DVector &y);
+  // Evaluate the Jacobian in y
+  int UpdateJacobi(DVector &y);
+  // Calculate and factorize the Newton-Raphson matrix
+  void NewtonMatrix(int stage);
   // Calculate an initial guess for the iteration
   void InitialGuess(int stage, DVector &guess);
 public:
@@ -56,9 +71,16 @@ public:
   SdirkNewtonRaphson(Sdirk *p,
 		     double accur,
 		     int dimen,
-		     int(* fun)(double t, DVector &y, DVector &f),
-		     int(* jac)(double t, DVector &y, DMatrix &j));
+		     int(* fun)(double t, DVector &y, DVector &f, void *params),
+		     int(* jac)(double t, DVector &y, DMatrix &j, void *params),
+		     void *params);
   // Calculate an iteration
   int Iterate(int stage, DVector &y_out, double &it_speed, int &div);
+  // Tell the iterator that a new step begins (ages the Jacobian)
+  void NewStep();
+  // Forget the Jacobian and reset the counters
+  void Reset();
+  // Get the Jacobian counters
+  void GetInfo(SdirkInfoType &p);
 };
 #endif
@@ -43,6 +43,8 @@ protected:
 public:
   // Constructor
   StepControlBase(double deps, int iorder, int in);
+  // Destructor (the derived controls are deleted through the base)
+  virtual ~StepControlBase(){};
   // Set tolerance
   void SetEps(double deps);
   // Calculate the estimated maximal error
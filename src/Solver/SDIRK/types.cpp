@@ -44,6 +44,16 @@ double UnitRoundoff(void)
   return(u);
 }
 
-
-
-
+// Allocate size doubles aligned to DEF_ALIGN bytes
+double *AlignedAlloc(unsigned size, double *&memory)
+{
+  unsigned pad = DEF_ALIGN/sizeof(double);
+  memory = new double[size + pad];
+  if (memory == NULL)
+    return NULL;
+  unsigned long addr = (unsigned long) memory;
+  double *aligned = (double*) ((addr + DEF_ALIGN - 1) / DEF_ALIGN * DEF_ALIGN);
+  for (unsigned i=0; i<size; i++)
+    aligned[i] = 0.;
+  return aligned;
+}
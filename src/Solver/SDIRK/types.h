@@ -44,6 +44,16 @@
 #define DEF_NEW_JACOBI_ROC 0.65
 // Maximal number of iterations performed in the Newton iteration
 #define DEF_MAX_ITERATIONS 20
+// The Newton matrix I - h*gamma*J is refactorized (with the same Jacobian) if
+// h*gamma changed by more than DEF_REFACTOR_H relative to the factorized one
+#define DEF_REFACTOR_H     0.05
+// The Jacobian is recalculated at the next stage if a converged iteration had
+// ROC >= DEF_SLOW_ROC
+#define DEF_SLOW_ROC       0.05
+// Maximal number of steps a Jacobian is kept
+#define DEF_MAX_JACOBI_AGE 50
+// Alignment (in bytes) of the storage of DVector and DMatrix
+#define DEF_ALIGN          64
 // DBL_EPSILON is not defined on all systems
 #ifndef DBL_EPSILON
 #define DBL_EPSILON 2.2204e-16
@@ -58,12 +68,18 @@ enum NormType        {NT_ONE, NT_TWO, NT_INF};
 enum StepControlType {SC_PRIM, SC_ORDINARE, SC_PI, SC_WATTS};
 enum SDIRKMethodType {NT1,JKT,RKF34};
 enum RKType          {EXPLICIT,IMPLICIT};
+enum LinearSolverType {LS_BLOCK, LS_DENSE, LS_LU};
 
 struct SdirkInfoType{
   unsigned long int NumOfGoodStep, NumOfBadStep, NumOfNewtonDivergens;
+  unsigned long int NumOfJacobians, NumOfFactorizations, MaxJacobiAge;
   double MaxError;
 };
 
+// Allocate size doubles aligned to DEF_ALIGN bytes, initialized to zero.
+// memory receives the pointer to release with delete []
+double *AlignedAlloc(unsigned size, double *&memory);
+
 struct PiCoefType{
   double Proportional, Integral, ThetaMax, Rho;
 };
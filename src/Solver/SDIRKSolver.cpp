@@ -32,23 +32,25 @@
  */
 
 #include "SDIRKSolver.h"
+#include "SDIRK/blocklu.h"
+#include "SDIRK/denselu.h"
 
 #include "gsl_odeiv_ext.h"
 
 #include "../Application/Input/XMLaux.h"
+#include "../Application/PrintingHandler.h"
 
 #include <sstream>
 
 namespace DYTSI_Solver {
 
-    DYTSI_Modelling::GeneralModel* locModel;
-
-    int funBinder(double t, DVector &y, DVector &f);
-    int jacBinder(double t, DVector &y, DMatrix &dfdy);
+    // The binders receive the model as user context (as in gsl_odeiv2_system),
+    // wrapped in SDIRKBinderParams
+    int funBinder(double t, DVector &y, DVector &f, void *params);
+    int jacBinder(double t, DVector &y, DMatrix &dfdy, void *params);
 
     SDIRKSolver::SDIRKSolver(DYTSI_Modelling::GeneralModel* gm, XERCES_CPP_NAMESPACE::DOMElement* el, int& error, SDIRKMethodType type)
     : Solver(gm, el, error){
-        locModel = gm;
         this->methodType = type;
 
         error += XMLaux::loadDoubleProperty(el, "InitStepLength", this->initStep);
@@ -56,6 +58,27 @@ namespace DYTSI_Solver {
         error += XMLaux::loadDoubleProperty(el, "AbsPrecision", this->absPrecision);
         error += XMLaux::loadDoubleProperty(el, "JacStoreFrequency", this->jacStoreFrequency);
 
+        // Optional: solver of the linear systems of the Newton iterations (Block, Dense or LU)
+        this->linearSolverType = LS_BLOCK;
+        XERCES_CPP_NAMESPACE::DOMNodeList* linSolverList = XMLaux::getElementsByTagName(el, "LinearSolver");
+        if (linSolverList->getLength() == 1){
+            std::string linSolver = XMLaux::setValueToString(linSolverList->item(0));
+            if (linSolver == "Block")
+                this->linearSolverType = LS_BLOCK;
+            else if (linSolver == "Dense")
+                this->linearSolverType = LS_DENSE;
+            else if (linSolver == "LU")
+                this->linearSolverType = LS_LU;
+            else {
+                error++;
+                std::stringstream* out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+                *out << "\t\t\tError in parsing the input file: " << std::endl;
+                *out << "\t\t\tThe property \"LinearSolver\" must be Block, Dense or LU" << std::endl;
+                PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+                delete out;
+            }
+        }
+
     }
 
     SDIRKSolver::~SDIRKSolver() {
@@ -72,8 +95,23 @@ namespace DYTSI_Solver {
     int SDIRKSolver::setup(){
         int n_var = this->model->get_N_DOF();
 
+        this->binderParams.model = this->model;
+        this->binderParams.dfdt.resize(n_var);
         this->SDIRKInstance = new Sdirk(
-                this->absPrecision, n_var, &funBinder, &jacBinder, SC_PI, this->methodType);
+                this->absPrecision, n_var, &funBinder, &jacBinder, &this->binderParams, SC_PI, this->methodType);
+
+        // Factorize the Newton matrix by blocks following the coupling of the components
+        // (if the pattern covers the model, otherwise by the contiguous dense LU), or
+        // keep the original Doolittle LU (LS_LU)
+        DYTSI_Modelling::JacobianPattern* pattern = this->model->getJacobianPattern();
+        int patternDOF = 0;
+        for (int i = 0; i < pattern->getNumberOfBlocks(); i++)
+            patternDOF += pattern->getBlockSize(i);
+        if (this->linearSolverType == LS_BLOCK && pattern->getNumberOfBlocks() > 0 && patternDOF == n_var)
+            this->SDIRKInstance->SetLinearSolver(new BlockLUfactorize(n_var,
+                    pattern->getBlockStarts(), pattern->getBlockSizes(), pattern->getCouplings()));
+        else if (this->linearSolverType != LS_LU)
+            this->SDIRKInstance->SetLinearSolver(new DenseLUfactorize(n_var));
 
         this->settedUp = true;
 
@@ -82,13 +120,10 @@ namespace DYTSI_Solver {
 
     int SDIRKSolver::evolve(double* t, double tf, double* h, double* yVec){
         int errCode = GSL_SUCCESS;
-        locModel = this->model;
         int n_var = this->model->get_N_DOF();
 
-        // Copy standard vector to DVector
-        DVector y(n_var);
-        for(int i = 0; i < n_var; i++)
-            y[i+1] = yVec[i];
+        // The integrator works directly on the state of the caller
+        DVector y(yVec, n_var);
 
         double finalTime = tf;
 
@@ -105,10 +140,6 @@ namespace DYTSI_Solver {
         }
         *t += *h;
 
-        // Copy back the values of y
-        for(int i = 0; i < n_var; i++)
-            yVec[i] = y[i+1];
-
         return errCode;
     }
 
@@ -126,6 +157,9 @@ namespace DYTSI_Solver {
         out << "Good Steps: " << info.NumOfGoodStep << std::endl;
         out << "Bad Steps: " << info.NumOfBadStep << std::endl;
         out << "Newton divergence: " << info.NumOfNewtonDivergens << std::endl;
+        out << "Jacobian evaluations: " << info.NumOfJacobians << std::endl;
+        out << "Newton matrix factorizations: " << info.NumOfFactorizations << std::endl;
+        out << "Max Jacobian age (steps): " << info.MaxJacobiAge << std::endl;
         out << "Max Error: " << info.MaxError << std::endl;
         std::string outStr = out.str();
         return outStr;
@@ -135,26 +169,18 @@ namespace DYTSI_Solver {
         return false;
     }
 
-    int funBinder(double t, DVector &y, DVector &f){
-        int status = locModel->computeFun(t, y.getVector(), f.getVector());
+    int funBinder(double t, DVector &y, DVector &f, void *params){
+        DYTSI_Modelling::GeneralModel* model = ((SDIRKBinderParams*) params)->model;
+        int status = model->computeFun(t, y.getVector(), f.getVector());
 
         return status;
     }
 
-    int jacBinder(double t, DVector &y, DMatrix &dfdy){
-        int n_var = locModel->get_N_DOF();
-
-        double* dfdyVec = new double[n_var*n_var];
-        double* dfdtVec = new double[n_var];
-
-        int status = locModel->computeJac(t, y.getVector(), dfdyVec, dfdtVec);
-
-        for(int i = 0; i < n_var; i++)
-            for(int j = 0; j < n_var; j++)
-                dfdy(i+1,j+1) = dfdyVec[(i*n_var)+j];
-
-        delete[] dfdyVec;
-        delete[] dfdtVec;
+    // The model writes the Jacobian straight into the contiguous storage of dfdy
+    int jacBinder(double t, DVector &y, DMatrix &dfdy, void *params){
+        SDIRKBinderParams* binderParams = (SDIRKBinderParams*) params;
+        int status = binderParams->model->computeJac(t, y.getVector(), dfdy.getData(),
+                &binderParams->dfdt[0]);
 
         return status;
     }
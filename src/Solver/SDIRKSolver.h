@@ -38,7 +38,15 @@
 
 #include "SDIRK/sdirk.h"
 
+#include <vector>
+
 namespace DYTSI_Solver {
+    // User context of the binders: the model and the scratch space of the Jacobian
+    struct SDIRKBinderParams {
+        DYTSI_Modelling::GeneralModel* model;
+        std::vector<double> dfdt;
+    };
+
     class SDIRKSolver : public Solver {
     public:
         SDIRKSolver(DYTSI_Modelling::GeneralModel* gm, XERCES_CPP_NAMESPACE::DOMElement* el, int& error, SDIRKMethodType type);
@@ -56,9 +64,12 @@ namespace DYTSI_Solver {
     private:
         Sdirk *SDIRKInstance;
         SDIRKMethodType methodType;
+        LinearSolverType linearSolverType;
 
         bool isFirstStep;
 
+        SDIRKBinderParams binderParams;
+
     };
 }
 
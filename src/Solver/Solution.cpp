@@ -40,30 +40,61 @@ namespace DYTSI_Solver{
     Solution::Solution(DYTSI_Modelling::GeneralModel* gm, DYTSI_Output::OutputHandler* outputHandler) {
         this->gm = gm;
         this->outputHandler = outputHandler;
+        this->entry = NULL;
+
+        // Without an output the entries are kept, to be appended to another solution
+        this->storedRuns = (outputHandler != NULL) ? outputHandler->getStoredRuns() : 0;
 
         this->reset();
+
+        if (this->isStreaming()){
+            this->entry = new double[this->getN_VARS()];
+            for (int i = 0; i < this->storedRuns; i++)
+                this->statusRing.push_back(new double[this->gm->get_N_DOF()]);
+            this->ringRunIndex.resize(this->storedRuns);
+        }
     }
 
     Solution::~Solution() {
-        delete &header;
-        delete &solList;
-        delete &statusList;
-        delete &componentsStartingPosition;
+        for (unsigned int i = 0; i < this->solList.size(); i++)
+            delete [] this->solList[i];
+        for (unsigned int i = 0; i < this->statusList.size(); i++)
+            delete [] this->statusList[i];
+        for (unsigned int i = 0; i < this->jacList.size(); i++)
+            delete [] this->jacList[i];
+        for (unsigned int i = 0; i < this->statusRing.size(); i++)
+            delete [] this->statusRing[i];
+        if (this->entry != NULL)
+            delete [] this->entry;
     }
 
     void Solution::reset(){
+        for (unsigned int i = 0; i < this->solList.size(); i++)
+            delete [] this->solList[i];
+        for (unsigned int i = 0; i < this->statusList.size(); i++)
+            delete [] this->statusList[i];
+        for (unsigned int i = 0; i < this->jacList.size(); i++)
+            delete [] this->jacList[i];
+
         this->header.clear();
         this->solList.clear();
         this->statusList.clear();
         this->jacList.clear();
+        this->runList.clear();
         this->componentList.clear();
+        this->nEntries = 0;
+        this->nJacobians = 0;
+        this->ringLast = -1;
+        this->ringSize = 0;
 
         this->setComponentList();
         this->setHeader();
         this->N_VARS = this->getHeader().size();
 
-        this->outputHandler->reset();
-        this->outputHandler->writeSolutionHeader(this->getHeader());
+        if (this->outputHandler != NULL){
+            this->outputHandler->reset();
+            this->outputHandler->writeSolutionHeader(this->getHeader());
+        }
     }
 
     std::vector<std::string> Solution::getHeader(){
@@ -82,8 +113,31 @@ namespace DYTSI_Solver{
         return this->N_VARS;
     }
 
+    double* Solution::getLastStatus(){
+        if (this->isStreaming())
+            return (this->ringSize > 0) ? this->statusRing[this->ringLast] : NULL;
+        return (this->statusList.size() > 0) ? this->statusList.back() : NULL;
+    }
+
+    /**
+     * Copy y in the ring slot of the run index, taking the next slot
+     * (the oldest run) if index is a new run.
+     */
+    void Solution::storeStatus(int index, const double* y){
+        if (this->ringSize == 0 || this->ringRunIndex[this->ringLast] != index){
+            this->ringLast = (this->ringLast + 1) % this->storedRuns;
+            this->ringRunIndex[this->ringLast] = index;
+            if (this->ringSize < this->storedRuns)
+                this->ringSize++;
+        }
+        // y can be the stored state itself (restart from getLastStatus())
+        double* status = this->statusRing[this->ringLast];
+        if (status != y)
+            memcpy(status, y, this->gm->get_N_DOF() * sizeof(double));
+    }
+
     void Solution::addEntry(int index, double t, double* y, double h){
-        double* e = new double[this->getN_VARS()];
+        double* e = this->isStreaming() ? this->entry : new double[this->getN_VARS()];
 
         // Set Index
         e[this->indexPosition] = index;
@@ -105,10 +159,18 @@ namespace DYTSI_Solver{
             comp->getStatus( t, y, &e[compStartPosition] );
         }
 
-        this->solList.push_back(e);
+        this->nEntries++;
 
         // Write to file
-        this->outputHandler->writeSolutionEntry(e, this->N_VARS);
+        if (this->outputHandler != NULL)
+            this->outputHandler->writeSolutionEntry(e, this->N_VARS);
+
+        if (this->isStreaming()){
+            this->storeStatus(index, y);
+            return;
+        }
+
+        this->solList.push_back(e);
 
         // Store the status y
         double* status = new double[this->gm->get_N_DOF()];
@@ -118,6 +180,12 @@ namespace DYTSI_Solver{
 
     void Solution::addJacobian(double* dfdy){
         int N_DOF = this->gm->get_N_DOF();
+        this->nJacobians++;
+
+        if (this->isStreaming()){
+            this->outputHandler->writeJacobian(dfdy, N_DOF, this->nJacobians);
+            return;
+        }
 
         // Copy the actual jacobian
         double* jac = new double[N_DOF * N_DOF];
@@ -127,7 +195,68 @@ namespace DYTSI_Solver{
         this->jacList.push_back(jac);
 
         // Write to file
-        this->outputHandler->writeJacobian(jac, N_DOF, this->jacList.size());
+        if (this->outputHandler != NULL)
+            this->outputHandler->writeJacobian(jac, N_DOF, this->nJacobians);
+    }
+
+    void Solution::addRunSummary(const RunSummary& summary){
+        this->runList.push_back(summary);
+
+        // Write to file
+        if (this->outputHandler != NULL)
+            this->outputHandler->writeRunSummary(summary.index, *ConvergenceMonitor::RunClassNames[summary.runClass],
+                    summary.tEnd, summary.amplitude, summary.period);
+    }
+
+    /**
+     * Move all the entries, status, jacobians and run summaries of sol at the end of this
+     * solution, writing them to the output. sol is left empty.
+     * The two solutions must refer to models with the same structure and sol
+     * must keep its history (no output handler). If this solution is streaming
+     * the entries are released once written.
+     */
+    void Solution::append(Solution& sol){
+        int N_DOF = this->gm->get_N_DOF();
+
+        for (unsigned int i = 0; i < sol.solList.size(); i++){
+            this->nEntries++;
+            if (this->outputHandler != NULL)
+                this->outputHandler->writeSolutionEntry(sol.solList[i], this->N_VARS);
+            if (this->isStreaming()){
+                this->storeStatus((int) sol.solList[i][this->indexPosition], sol.statusList[i]);
+                delete [] sol.solList[i];
+                delete [] sol.statusList[i];
+            } else {
+                this->solList.push_back(sol.solList[i]);
+                this->statusList.push_back(sol.statusList[i]);
+            }
+        }
+        for (unsigned int i = 0; i < sol.jacList.size(); i++){
+            this->nJacobians++;
+            if (this->outputHandler != NULL)
+                this->outputHandler->writeJacobian(sol.jacList[i], N_DOF, this->nJacobians);
+            if (this->isStreaming())
+                delete [] sol.jacList[i];
+            else
+                this->jacList.push_back(sol.jacList[i]);
+        }
+
+        for (unsigned int i = 0; i < sol.runList.size(); i++)
+            this->addRunSummary(sol.runList[i]);
+
+        sol.solList.clear();
+        sol.statusList.clear();
+        sol.jacList.clear();
+        sol.runList.clear();
+        sol.nEntries = 0;
+        sol.nJacobians = 0;
+
+        this->flush();
+    }
+
+    void Solution::flush(){
+        if (this->outputHandler != NULL)
+            this->outputHandler->flush();
     }
 
     void Solution::setComponentList(){
@@ -35,6 +35,7 @@
 #define	SOLUTION_H
 
 #include "../GeneralModel/GeneralModel.h"
+#include "ConvergenceMonitor.h"
 
 #include <vector>
 #include <string>
@@ -44,6 +45,18 @@ namespace DYTSI_Output{
 }
 
 namespace DYTSI_Solver{
+    /**
+     * List of the entries computed by the solver. Each entry is written to the
+     * output handler as soon as it is added. If the output handler is NULL
+     * the entries are only kept in memory (see append()).
+     *
+     * If the output handler asks for a bounded number of stored runs, the
+     * solution is streaming: the entries and the Jacobians are only written,
+     * and the last state of each of the most recent runs is kept in a ring
+     * (the newest one is returned by getLastStatus()), so long sweeps run in
+     * constant memory.
+     * The solution and status lists are then empty.
+     */
     class Solution {
     public:
         Solution(DYTSI_Modelling::GeneralModel* gm, DYTSI_Output::OutputHandler* outputHandler);
@@ -55,8 +68,18 @@ namespace DYTSI_Solver{
         std::vector<double*> getSolutionList();
         std::vector<double*> getStatusList();
         int getN_VARS();
+        bool isStreaming(){ return storedRuns > 0; }
+        long getNumberOfEntries(){ return nEntries; }
+        // Last state added (NULL if the solution is empty)
+        double* getLastStatus();
         void addEntry(int index, double t, double* y, double h);
         void addJacobian(double* dfdy);
+        // Classification of a run, kept (one per run) and written to the output
+        void addRunSummary(const RunSummary& summary);
+        const std::vector<RunSummary>& getRunList(){ return runList; }
+        void append(Solution& sol);
+        // Write the buffered entries to the output (at the end of each run)
+        void flush();
         
     private:
         int N_VARS;
@@ -74,6 +97,20 @@ namespace DYTSI_Solver{
         std::vector<double*> statusList;
 
         std::vector<double*> jacList;
+        std::vector<RunSummary> runList;
+
+        // Streaming mode (storedRuns > 0): the entry is built in a single buffer and
+        // the last state of the storedRuns most recent runs is kept in the ring
+        int storedRuns;
+        long nEntries;
+        int nJacobians;
+        double* entry;
+        std::vector<double*> statusRing;
+        std::vector<int> ringRunIndex;
+        int ringLast;
+        int ringSize;
+
+        void storeStatus(int index, const double* y);
 
         std::vector<DYTSI_Modelling::Component*> componentList;
         std::vector<int> componentsStartingPosition;
@@ -45,6 +45,86 @@
 namespace DYTSI_Solver{
     Solver::Solver(DYTSI_Modelling::GeneralModel* gm, XERCES_CPP_NAMESPACE::DOMElement* el, int& error) {
         this->model = gm;
+        this->verbose = true;
+
+        // Optional: Jacobian of the model (Numerical, Analytic, Check, Colored or Automatic)
+        XERCES_CPP_NAMESPACE::DOMNodeList* jacModeList = XMLaux::getElementsByTagName(el, "JacobianMode");
+        if (jacModeList->getLength() == 1){
+            std::string jacMode = XMLaux::setValueToString(jacModeList->item(0));
+            if (jacMode == "Numerical")
+                gm->setJacobianMode(DYTSI_Modelling::JAC_NUMERICAL);
+            else if (jacMode == "Analytic")
+                gm->setJacobianMode(DYTSI_Modelling::JAC_ANALYTIC);
+            else if (jacMode == "Check")
+                gm->setJacobianMode(DYTSI_Modelling::JAC_CHECK);
+            else if (jacMode == "Colored")
+                gm->setJacobianMode(DYTSI_Modelling::JAC_COLORED);
+            else if (jacMode == "Automatic")
+                gm->setJacobianMode(DYTSI_Modelling::JAC_AUTOMATIC);
+            else {
+                error++;
+                std::stringstream* out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+                *out << "\t\t\tError in parsing the input file: " << std::endl;
+                *out << "\t\t\tThe property \"JacobianMode\" must be Numerical, Analytic, Check, Colored or Automatic" << std::endl;
+                PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+                delete out;
+            }
+        }
+
+        // Optional: finite differences of the numerical Jacobians
+        XERCES_CPP_NAMESPACE::DOMNodeList* fdSchemeList = XMLaux::getElementsByTagName(el, "FDScheme");
+        if (fdSchemeList->getLength() == 1){
+            std::string fdScheme = XMLaux::setValueToString(fdSchemeList->item(0));
+            if (fdScheme == "Forward")
+                gm->getColoredJacobian()->setScheme(DYTSI_Modelling::FD_FORWARD);
+            else if (fdScheme == "Central")
+                gm->getColoredJacobian()->setScheme(DYTSI_Modelling::FD_CENTRAL);
+            else {
+                error++;
+                std::stringstream* out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+                *out << "\t\t\tError in parsing the input file: " << std::endl;
+                *out << "\t\t\tThe property \"FDScheme\" must be Forward or Central" << std::endl;
+                PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+                delete out;
+            }
+        }
+        XERCES_CPP_NAMESPACE::DOMNodeList* fdStepTypeList = XMLaux::getElementsByTagName(el, "FDStepType");
+        if (fdStepTypeList->getLength() == 1){
+            std::string fdStepType = XMLaux::setValueToString(fdStepTypeList->item(0));
+            if (fdStepType == "Absolute")
+                gm->getColoredJacobian()->setStepType(DYTSI_Modelling::FD_STEP_ABSOLUTE);
+            else if (fdStepType == "Relative")
+                gm->getColoredJacobian()->setStepType(DYTSI_Modelling::FD_STEP_RELATIVE);
+            else {
+                error++;
+                std::stringstream* out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+                *out << "\t\t\tError in parsing the input file: " << std::endl;
+                *out << "\t\t\tThe property \"FDStepType\" must be Absolute or Relative" << std::endl;
+                PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+                delete out;
+            }
+        }
+        XERCES_CPP_NAMESPACE::DOMNodeList* fdStepList = XMLaux::getElementsByTagName(el, "FDStep");
+        if (fdStepList->getLength() == 1){
+            double fdStep = XMLaux::setValueToDouble(fdStepList->item(0));
+            if (fdStep > 0.0)
+                gm->getColoredJacobian()->setStep(fdStep);
+            else {
+                error++;
+                std::stringstream* out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+                *out << "\t\t\tError in parsing the input file: " << std::endl;
+                *out << "\t\t\tThe property \"FDStep\" must be positive" << std::endl;
+                PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+                delete out;
+            }
+        }
+
+        // Optional: stop the runs of solve() once the motion is settled
+        error += this->convergence.load(el);
+    }
+
+    void Solver::setVerbose(bool verbose){
+        this->verbose = verbose;
     }
 
     Solver::~Solver() {
@@ -72,34 +152,39 @@ namespace DYTSI_Solver{
         double h = this->initStep;
         int n_var = this->model->get_N_DOF();
         int status = GSL_SUCCESS;
+        bool converged = false;
 
         double t = tspan->getStartValue();  // init time
         double tf = tspan->getEndValue(); // final time
         double totIntegTime = tf - t;
 
         // display info
-        out = new std::stringstream(std::stringstream::in|std::stringstream::out);
-        *out << "|============================================" << std::endl;
-        *out << "|           Solver call information           " << std::endl;
-        *out << "|============================================" << std::endl;
-        *out << "|  Time Span:          \t[" << t << "," << tf << "]" << std::endl;
-        *out << "|  Initial Step Length:\t" << this->initStep << std::endl;
-        *out << "|============================================" << std::endl;
-        *out << "|           System Properties                " << std::endl;
-        *out << "|============================================" << std::endl;
-        *out << "|  Speed:              \t" << this->model->getExternalComponents()->get_v() << std::endl;
-        *out << "|  Radius:              \t" << this->model->getExternalComponents()->get_R() << std::endl;
-        *out << "|  Phi_se:             \t" << this->model->getExternalComponents()->get_Phi_se() << std::endl;
-        *out << "|============================================" << std::endl << std::endl;
-        PrintingHandler::printOut(out, PrintingHandler::STDOUT);
-        delete out;
+        if (this->verbose){
+            out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+            *out << "|============================================" << std::endl;
+            *out << "|           Solver call information           " << std::endl;
+            *out << "|============================================" << std::endl;
+            *out << "|  Time Span:          \t[" << t << "," << tf << "]" << std::endl;
+            *out << "|  Initial Step Length:\t" << this->initStep << std::endl;
+            *out << "|============================================" << std::endl;
+            *out << "|           System Properties                " << std::endl;
+            *out << "|============================================" << std::endl;
+            *out << "|  Speed:              \t" << this->model->getExternalComponents()->get_v() << std::endl;
+            *out << "|  Radius:              \t" << this->model->getExternalComponents()->get_R() << std::endl;
+            *out << "|  Phi_se:             \t" << this->model->getExternalComponents()->get_Phi_se() << std::endl;
+            *out << "|============================================" << std::endl << std::endl;
+            PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+            delete out;
+        }
 
         // Store the elapsed time for this solution
         std::ostringstream* elapsedTime = new std::ostringstream();
         boost::progress_timer progressTimer(*elapsedTime);
 
-        // Show the progress display
-        boost::progress_display show_progress( 100 );
+        // Show the progress display (discarded if not verbose or if the output is buffered)
+        std::ostringstream quietProgress;
+        boost::progress_display show_progress( 100,
+                (this->verbose && !PrintingHandler::isBuffering()) ? std::cout : quietProgress );
 
         // Copy initial conditions
         double *y = (double*)malloc(n_var*sizeof(double));
@@ -107,6 +192,8 @@ namespace DYTSI_Solver{
 
         // Store initial conditions
         sol.addEntry(index, t, y, h);
+        if (this->convergence.isEnabled())
+            this->convergence.start(this->model, t, y);
         tOutput = t + this->storeFrequency;
         tOutputJac = t + this->jacStoreFrequency;
         tProgressUpdate = t + totIntegTime/100.0;
@@ -117,7 +204,7 @@ namespace DYTSI_Solver{
             PrintingHandler::printOut(out, PrintingHandler::STDOUT);
             delete out;
         } else {
-            while ((t < tf) && (status == GSL_SUCCESS)){
+            while ((t < tf) && (status == GSL_SUCCESS) && !converged){
               iterCounter++;
               if (this->useDriver()){
                   // Step to the next output time
@@ -163,6 +250,9 @@ namespace DYTSI_Solver{
                       ++show_progress;
                       tProgressUpdate += totIntegTime / 100.0;
                   }
+
+                  if (this->convergence.isEnabled())
+                      converged = this->convergence.update(t, y);
               }
             } // End While
             // Store last entry
@@ -171,18 +261,39 @@ namespace DYTSI_Solver{
             if (status == GSL_SUCCESS)
                 ++show_progress;
 
+            // Classification of the run
+            if (this->convergence.isEnabled()){
+                RunSummary summary = this->convergence.getSummary(index);
+                sol.addRunSummary(summary);
+                if (this->verbose){
+                    out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+                    *out << std::endl << "Run " << index << ": " << *ConvergenceMonitor::RunClassNames[summary.runClass]
+                            << " at t = " << summary.tEnd;
+                    if (summary.runClass == RUN_PERIODIC)
+                        *out << " (amplitude " << summary.amplitude << ", period " << summary.period << ")";
+                    *out << std::endl;
+                    PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+                    delete out;
+                }
+            }
+
             // Show the elapsed time
             progressTimer.~progress_timer();
-            out = new std::stringstream(std::stringstream::in|std::stringstream::out);
-            *out << "Elapsed time for the solution: " << elapsedTime->str() << std::endl;
-            *out << "Model Counters: " << std::endl;
-            *out << this->model->printCounters();
-            *out << "Solver Counters: " << std::endl;
-            *out << this->showInfo();
-            PrintingHandler::printOut(out, PrintingHandler::STDOUT);
-            delete out;
+            if (this->verbose){
+                out = new std::stringstream(std::stringstream::in|std::stringstream::out);
+                *out << "Elapsed time for the solution: " << elapsedTime->str() << std::endl;
+                *out << "Model Counters: " << std::endl;
+                *out << this->model->printCounters();
+                *out << "Solver Counters: " << std::endl;
+                *out << this->showInfo();
+                PrintingHandler::printOut(out, PrintingHandler::STDOUT);
+                delete out;
+            }
         }
 
+        // The entries of the run are written to the output
+        sol.flush();
+
         return status;
     }
 
@@ -248,8 +359,10 @@ namespace DYTSI_Solver{
         std::ostringstream* elapsedTime = new std::ostringstream();
         boost::progress_timer progressTimer(*elapsedTime);
 
-        // Show the progress display
-        boost::progress_display show_progress( 100 );
+        // Show the progress display (discarded if the output is buffered)
+        std::ostringstream quietProgress;
+        boost::progress_display show_progress( 100,
+                PrintingHandler::isBuffering() ? quietProgress : std::cout );
 
         // Copy initial conditions
         double *y = (double*)malloc(n_var*sizeof(double));
@@ -345,6 +458,9 @@ namespace DYTSI_Solver{
             delete out;
         }
 
+        // The entries of the run are written to the output
+        sol.flush();
+
         return status;
     }
 
@@ -398,8 +514,10 @@ namespace DYTSI_Solver{
 		std::ostringstream* elapsedTime = new std::ostringstream();
 		boost::progress_timer progressTimer(*elapsedTime);
 
-		// Show the progress display
-		boost::progress_display show_progress( 100 );
+		// Show the progress display (discarded if the output is buffered)
+		std::ostringstream quietProgress;
+		boost::progress_display show_progress( 100,
+				PrintingHandler::isBuffering() ? quietProgress : std::cout );
 
 		// Copy initial conditions
 		double *y = (double*)malloc(n_var*sizeof(double));
@@ -487,6 +605,9 @@ namespace DYTSI_Solver{
 			delete out;
 		}
 
+		// The entries of the run are written to the output
+		sol.flush();
+
 		return status;
     }
 
@@ -35,6 +35,7 @@
 #define	SOLVER_H
 
 #include "Solution.h"
+#include "ConvergenceMonitor.h"
 #include "../GeneralModel/GeneralModel.h"
 #include "../Application/Input/Range.h"
 #include "../Application/Input/TransientCurve.h"
@@ -61,6 +62,9 @@ namespace DYTSI_Solver{
         int solveRamping(int index, double* y0, DYTSI_Input::Range *speedRange, Solution& sol);
 
         std::string getSolverInformation();
+        void setVerbose(bool verbose);
+        // solve() classifies each run (see ConvergenceMonitor)
+        bool isMonitoringConvergence(){ return convergence.isEnabled(); }
 
         virtual std::string getSolverName() const = 0;
         virtual const gsl_odeiv2_step_type* getStepType() = 0;
@@ -71,6 +75,7 @@ namespace DYTSI_Solver{
         virtual bool useDriver() = 0;
     protected:
         bool settedUp;
+        bool verbose; // Print the call information and the progress of solve()
 
         double absPrecision;
         double relPrecision;
@@ -78,6 +83,9 @@ namespace DYTSI_Solver{
         double storeFrequency;
         double jacStoreFrequency;
 
+        // Early termination of solve() on settled motion (optional)
+        ConvergenceMonitor convergence;
+
         DYTSI_Modelling::GeneralModel* model;
     };
 }
@@ -0,0 +1,175 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+
+/*
+ * Checks of the binary solution files: round trip of BinarySolutionWriter and
+ * BinarySolutionReader, reading of a file that is still being written, recovery
+ * of a file without a valid footer and the rejected inputs.
+ */
+#include "../Application/Output/BinarySolutionWriter.h"
+#include "../Application/Output/BinarySolutionReader.h"
+#include "TestCheck.h"
+
+#include <stdio.h>
+#include <unistd.h>
+#include <vector>
+#include <string>
+
+using namespace DYTSI_Output;
+
+// Running mode of PrintingHandler (defined in main.cpp for DYTSI)
+int RunningMode_graphics = false;
+
+static const char FILE_NAME[] = "BinarySolutionTest.bin";
+static const int N_RUNS = 3;
+// Rows of the runs: more than one chunk, a single row and an exact number of chunks
+static const int RUN_ROWS[N_RUNS] = {BinarySolutionWriter::CHUNK_ROWS + 904, 1, 2 * BinarySolutionWriter::CHUNK_ROWS};
+
+static std::vector<std::string> columnNames(){
+    std::vector<std::string> names;
+    names.push_back("t");
+    names.push_back("Index");
+    names.push_back("x");
+    return names;
+}
+
+static void entry(int run, int i, double e[3]){
+    e[0] = 0.01 * i;
+    e[1] = run;
+    e[2] = 1000.0 * run + i;
+}
+
+// Check the column x of a run against the values written, up to nRows rows
+static bool checkRun(BinarySolutionReader& reader, int run, int nRows){
+    int x = reader.getColumnIndex("x");
+    std::vector<BinarySolutionReader::ColumnView> views = reader.getColumnViews(x, run);
+    int i = 0;
+    for (unsigned int v = 0; v < views.size(); v++){
+        if (views[v].runIndex != run)
+            return false;
+        for (int j = 0; j < views[v].size; j++, i++){
+            double e[3];
+            entry(run, i, e);
+            if (views[v].data[j] != e[2])
+                return false;
+        }
+    }
+    return i == nRows;
+}
+
+static void testRoundTrip(){
+    BinarySolutionWriter writer;
+    check(writer.open(FILE_NAME, columnNames(), "Index"), "writer open");
+    long nRows = 0;
+    double e[3];
+    for (int run = 0; run < N_RUNS; run++)
+        for (int i = 0; i < RUN_ROWS[run]; i++){
+            entry(run, i, e);
+            writer.addEntry(e);
+            nRows++;
+        }
+
+    // Readable up to the last flush while the writer is open
+    writer.flush();
+    entry(N_RUNS, 0, e);
+    writer.addEntry(e);
+    {
+        BinarySolutionReader reader;
+        check(reader.open(FILE_NAME), "reader open while writing");
+        check(reader.getNumberOfRows() == nRows, "rows up to the flush");
+    }
+    writer.close();
+    nRows++;
+
+    BinarySolutionReader reader;
+    check(reader.open(FILE_NAME), "reader open");
+    check(reader.getNumberOfColumns() == 3 && reader.getColumnNames() == columnNames(), "column names");
+    check(reader.getColumnIndex("Index") == 1 && reader.getColumnIndex("y") == -1, "column indices");
+    check(reader.getNumberOfRows() == nRows, "number of rows");
+    bool runsOk = true;
+    for (int run = 0; run < N_RUNS; run++)
+        runsOk = runsOk && checkRun(reader, run, RUN_ROWS[run]);
+    check(runsOk, "values of the runs");
+    check(checkRun(reader, N_RUNS, 1), "values after the flush");
+
+    // All the chunks, in the order of writing
+    std::vector<BinarySolutionReader::ColumnView> t = reader.getColumnViews(0);
+    long i = 0;
+    bool timeOk = true;
+    for (unsigned int v = 0; v < t.size(); v++)
+        for (int j = 0; j < t[v].size; j++, i++)
+            if (i < RUN_ROWS[0])
+                timeOk = timeOk && t[v].data[j] == 0.01 * i;
+    check(timeOk && i == nRows, "column over all the chunks");
+}
+
+static void testRecovery(){
+    // Without the footer and the index, the complete chunks are scanned
+    BinarySolutionWriter writer;
+    writer.open(FILE_NAME, columnNames(), "Index");
+    double e[3];
+    for (int run = 0; run < N_RUNS; run++)
+        for (int i = 0; i < RUN_ROWS[run]; i++){
+            entry(run, i, e);
+            writer.addEntry(e);
+        }
+    writer.close();
+
+    FILE* f = fopen(FILE_NAME, "r+b");
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fclose(f);
+    check(truncate(FILE_NAME, size - 8) == 0, "truncate");
+
+    BinarySolutionReader reader;
+    check(reader.open(FILE_NAME), "reader open without footer");
+    bool runsOk = true;
+    for (int run = 0; run < N_RUNS; run++)
+        runsOk = runsOk && checkRun(reader, run, RUN_ROWS[run]);
+    check(runsOk, "values of the runs without footer");
+}
+
+static void testRejected(){
+    BinarySolutionWriter writer;
+    check(!writer.open(FILE_NAME, columnNames(), "Run"), "writer open with an unknown index column");
+
+    FILE* f = fopen(FILE_NAME, "wb");
+    fprintf(f, "\"t\"\t\"Index\"\t\"x\"\n");
+    fclose(f);
+    BinarySolutionReader reader;
+    check(!reader.open(FILE_NAME), "reader open of a text file");
+    check(!reader.open("BinarySolutionTest.missing"), "reader open of a missing file");
+}
+
+int main(int argc, char *argv[])
+{
+    testRoundTrip();
+    testRecovery();
+    testRejected();
+    remove(FILE_NAME);
+
+    return checkReport("Binary solution files");
+}
@@ -0,0 +1,108 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+
+/*
+ * Checks of the forward automatic differentiation (Dual): the derivatives of
+ * functions using all the operators and the elementary functions against
+ * central finite differences.
+ */
+#include "../GeneralModel/Dual.h"
+#include "TestCheck.h"
+
+#include <stdio.h>
+#include <math.h>
+
+using namespace DYTSI_Modelling;
+
+static const int NVARS = 3;
+static const int NFUNS = 4;
+
+// Generic functions of three variables, as in the right hand sides
+template<typename T>
+static void functions(const T x[NVARS], T f[NFUNS]){
+    f[0] = x[0] * x[1] - x[2] / x[0] + 2.0 * x[1] - 1.0 / x[2];
+    f[1] = sqrt(x[0] * x[0] + x[1] * x[1]) * exp(- x[2]) + log(x[0]);
+    f[2] = sin(x[0]) * cos(x[1]) + atan(x[2] - 3.0) + pow(x[1], 2.5);
+    T d = x[1] - x[0];
+    f[3] = (d > 0.0) ? fabs(d) * x[2] : - d / (1.0 + x[2]);
+    f[3] += x[0];
+    f[3] -= 0.5 * x[1];
+    f[3] *= x[2];
+    f[3] /= x[0];
+}
+
+template<int N>
+static void testPoint(const double x0[NVARS], const char* where){
+    // Seeds: the derivative i is with respect to the variable i % NVARS
+    Dual<N> x[NVARS];
+    for (int j = 0; j < NVARS; j++){
+        x[j] = Dual<N>(x0[j]);
+        for (int i = 0; i < N; i++)
+            x[j].setDerivative(i, (i % NVARS == j) ? 1.0 : 0.0);
+    }
+    Dual<N> f[NFUNS];
+    functions(x, f);
+
+    double fd[NFUNS];
+    functions(x0, fd);
+    char what[96];
+    for (int k = 0; k < NFUNS; k++){
+        snprintf(what, sizeof(what), "Dual<%d> value of f%d at %s", N, k, where);
+        check(fabs(f[k].value() - fd[k]) <= 1e-14 * fmax(1.0, fabs(fd[k])), what);
+    }
+
+    // Central differences
+    for (int j = 0; j < NVARS; j++){
+        double h = 1e-6 * fmax(1.0, fabs(x0[j]));
+        double xp[NVARS], xm[NVARS], fp[NFUNS], fm[NFUNS];
+        for (int l = 0; l < NVARS; l++)
+            xp[l] = xm[l] = x0[l];
+        xp[j] += h;
+        xm[j] -= h;
+        functions(xp, fp);
+        functions(xm, fm);
+        for (int k = 0; k < NFUNS; k++){
+            double fdDer = (fp[k] - fm[k]) / (2.0 * h);
+            for (int i = j; i < N; i += NVARS){
+                snprintf(what, sizeof(what), "Dual<%d> df%d/dx%d at %s", N, k, j, where);
+                check(fabs(f[k].derivative(i) - fdDer) <= 1e-7 * fmax(1.0, fabs(fdDer)), what);
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const double a[NVARS] = {0.7, 1.3, 2.1};
+    const double b[NVARS] = {2.5, 0.4, 0.9};
+    testPoint<1>(a, "a");
+    testPoint<3>(a, "a");
+    testPoint<AD_WIDTH>(a, "a");
+    testPoint<3>(b, "b");
+    testPoint<AD_WIDTH>(b, "b");
+
+    return checkReport("Dual");
+}
@@ -0,0 +1,188 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+
+/*
+ * Checks of the SDIRK linear solvers: DenseLUfactorize and BlockLUfactorize
+ * against LUfactorize, on dense and block sparse systems, and of the storage of
+ * DMatrix and DVector.
+ */
+#include "../Solver/SDIRK/lufac.h"
+#include "../Solver/SDIRK/denselu.h"
+#include "../Solver/SDIRK/blocklu.h"
+#include "TestCheck.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+
+// Max difference of the solutions of the system mat x = rhs of two solvers,
+// relative to the max of the first solution
+static double compareSolvers(LinearSolver& ref, LinearSolver& solver, DMatrix& mat, DVector& rhs, int n){
+    DVector xRef(rhs);
+    DVector x(rhs);
+    // LUfactorize overwrites the matrix with the factors
+    DMatrix matRef(mat);
+    ref.Decompose(matRef);
+    ref.Solve(xRef);
+    solver.Decompose(mat);
+    solver.Solve(x);
+    double diff = 0.0, norm = 0.0;
+    for (int i = 1; i <= n; i++){
+        diff = fmax(diff, fabs(x[i] - xRef[i]));
+        norm = fmax(norm, fabs(xRef[i]));
+    }
+    return diff / norm;
+}
+
+// Max residual |mat x - rhs| relative to the max of rhs
+static double residual(LinearSolver& solver, DMatrix& mat, DVector& rhs, int n){
+    DVector x(rhs);
+    solver.Decompose(mat);
+    solver.Solve(x);
+    double res = 0.0, norm = 0.0;
+    for (int i = 1; i <= n; i++){
+        double r = -rhs[i];
+        for (int j = 1; j <= n; j++)
+            r += mat(i,j) * x[j];
+        res = fmax(res, fabs(r));
+        norm = fmax(norm, fabs(rhs[i]));
+    }
+    return res / norm;
+}
+
+static double randomValue(){
+    return 2.0 * rand() / RAND_MAX - 1.0;
+}
+
+static void testDense(int n){
+    DMatrix mat(n, n);
+    DVector rhs(n);
+    // Random matrix: the partial pivoting is exercised
+    for (int i = 1; i <= n; i++){
+        for (int j = 1; j <= n; j++)
+            mat(i,j) = randomValue();
+        rhs[i] = randomValue();
+    }
+    LUfactorize ref(n);
+    DenseLUfactorize dense(n);
+    char what[64];
+    snprintf(what, sizeof(what), "DenseLU against LU, n = %d", n);
+    check(compareSolvers(ref, dense, mat, rhs, n) < 1e-9, what);
+    snprintf(what, sizeof(what), "DenseLU residual, n = %d", n);
+    check(residual(dense, mat, rhs, n) < 1e-10, what);
+
+    // The factors are reused for a second right hand side
+    DVector rhs2(n);
+    for (int i = 1; i <= n; i++)
+        rhs2[i] = randomValue();
+    DVector x(rhs2), xRef(rhs2);
+    DMatrix matRef(mat);
+    ref.Decompose(matRef);
+    dense.Decompose(mat);
+    dense.Solve(x);
+    ref.Solve(xRef);
+    double diff = 0.0;
+    for (int i = 1; i <= n; i++)
+        diff = fmax(diff, fabs(x[i] - xRef[i]));
+    snprintf(what, sizeof(what), "DenseLU second solve, n = %d", n);
+    check(diff < 1e-9, what);
+}
+
+// Blocks of a train model: car body, two bogie frames and two wheel sets per bogie frame
+static void testBlock(){
+    const int nb = 7;
+    const int bs[nb] = {6, 4, 4, 8, 8, 8, 8};
+    const int parent[nb] = {-1, 0, 0, 1, 1, 2, 2};
+    std::vector<int> blockStart(nb), blockSize(nb);
+    std::vector< std::vector<int> > coupling(nb);
+    int n = 0;
+    for (int b = 0; b < nb; b++){
+        blockStart[b] = n;
+        blockSize[b] = bs[b];
+        n += bs[b];
+        coupling[b].push_back(b);
+        if (parent[b] >= 0){
+            coupling[b].push_back(parent[b]);
+            coupling[parent[b]].push_back(b);
+        }
+    }
+
+    DMatrix mat(n, n);
+    DVector rhs(n);
+    for (int bi = 0; bi < nb; bi++)
+        for (unsigned int c = 0; c < coupling[bi].size(); c++){
+            int bj = coupling[bi][c];
+            for (int i = 0; i < bs[bi]; i++)
+                for (int j = 0; j < bs[bj]; j++)
+                    mat(blockStart[bi] + i + 1, blockStart[bj] + j + 1) = randomValue();
+        }
+    // Diagonal blocks well conditioned
+    for (int i = 1; i <= n; i++){
+        mat(i,i) += 8.0;
+        rhs[i] = randomValue();
+    }
+
+    LUfactorize ref(n);
+    BlockLUfactorize block(n, blockStart, blockSize, coupling);
+    check(block.GetNumberOfBlocks() == nb + 2 * (nb - 1), "BlockLU without fill in on a tree");
+    check(compareSolvers(ref, block, mat, rhs, n) < 1e-9, "BlockLU against LU");
+    check(residual(block, mat, rhs, n) < 1e-10, "BlockLU residual");
+}
+
+static void testStorage(){
+    // DMatrix: contiguous row major
+    DMatrix mat(3, 5);
+    for (int i = 1; i <= 3; i++)
+        for (int j = 1; j <= 5; j++)
+            mat(i,j) = 10 * i + j;
+    double* data = mat.getData();
+    bool rowMajor = true;
+    for (int i = 1; i <= 3; i++)
+        for (int j = 1; j <= 5; j++)
+            rowMajor = rowMajor && data[(i-1)*5 + j-1] == mat(i,j);
+    check(rowMajor, "DMatrix row major storage");
+
+    // DVector: view of an external storage
+    double values[4] = {1.0, 2.0, 3.0, 4.0};
+    DVector view(values, 4);
+    view[2] = 20.0;
+    check(values[1] == 20.0 && view[4] == 4.0 && view.getVector() == values, "DVector view");
+}
+
+int main(int argc, char *argv[])
+{
+    srand(12345);
+    testStorage();
+    // Sizes smaller and larger than the panel width
+    testDense(1);
+    testDense(7);
+    testDense(50);
+    testDense(131);
+    testBlock();
+
+    return checkReport("Linear solvers");
+}
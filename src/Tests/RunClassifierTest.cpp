@@ -0,0 +1,100 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+
+/*
+ * Checks of the classification of the runs (RunClassifier) on synthetic motions
+ * sampled with irregular steps: damped, periodic, growing to a limit cycle,
+ * slowly decaying and at rest.
+ */
+#include "../Solver/RunClassifier.h"
+#include "TestCheck.h"
+
+#include <stdio.h>
+#include <math.h>
+
+using namespace DYTSI_Solver;
+
+static const double TOLERANCE = 1e-3;
+static const double WINDOW = 1.0;
+static const double MIN_TIME = 0.5;
+static const int CYCLES = 3;
+static const double T_END = 15.0;
+
+// Run the classifier on the motion y[1] = f(t), y[0] = f(t) / 2, until it stops or T_END
+static RunSummary classify(double (*f)(double)){
+    RunClassifier classifier(TOLERANCE, WINDOW, MIN_TIME, CYCLES);
+    double t = 0.0;
+    double y[2] = {0.5 * f(t), f(t)};
+    classifier.start(2, 1, t, y);
+    bool stop = false;
+    while (t < T_END && !stop){
+        t += 0.001 + 0.0005 * sin(37.0 * t);
+        y[0] = 0.5 * f(t);
+        y[1] = f(t);
+        stop = classifier.update(t, y);
+    }
+    return classifier.getSummary(7);
+}
+
+static const double FREQUENCY = 1.7;
+
+static double damped(double t){ return 0.01 * exp(-3.0 * t) * sin(2.0 * M_PI * 2.0 * t); }
+static double periodic(double t){ return 0.005 * sin(2.0 * M_PI * FREQUENCY * t); }
+static double growing(double t){ return 0.005 * (1.0 - exp(-0.7 * t)) * sin(2.0 * M_PI * FREQUENCY * t); }
+static double slowlyDecaying(double t){ return 0.01 * exp(-0.05 * t) * sin(2.0 * M_PI * 2.0 * t); }
+static double atRest(double t){ return 0.002; }
+
+int main(int argc, char *argv[])
+{
+    RunSummary s = classify(damped);
+    check(s.runClass == RUN_STABLE, "damped motion is STABLE");
+    check(s.tEnd < 5.0, "damped motion stops early");
+    check(s.amplitude == 0.0 && s.period == 0.0, "no cycles in a STABLE summary");
+    check(s.index == 7, "index of the summary");
+
+    s = classify(periodic);
+    check(s.runClass == RUN_PERIODIC, "periodic motion is PERIODIC");
+    check(s.tEnd < 5.0, "periodic motion stops early");
+    check(fabs(s.amplitude - 0.005) < TOLERANCE * 0.005, "amplitude of the cycle");
+    check(fabs(s.period - 1.0 / FREQUENCY) < TOLERANCE / FREQUENCY, "period of the cycle");
+    check(fabs(s.growth - 1.0) < TOLERANCE, "growth of the cycle");
+
+    s = classify(growing);
+    check(s.runClass == RUN_PERIODIC, "motion growing to a limit cycle is PERIODIC");
+    check(fabs(s.amplitude - 0.005) < 10 * TOLERANCE * 0.005, "amplitude of the limit cycle");
+    check(s.growth >= 1.0, "growth towards the limit cycle");
+
+    s = classify(slowlyDecaying);
+    check(s.runClass == RUN_UNDECIDED, "slowly decaying motion is UNDECIDED");
+    check(s.tEnd >= T_END, "slowly decaying motion runs to the end");
+    check(s.growth < 1.0, "decay of the cycles");
+
+    s = classify(atRest);
+    check(s.runClass == RUN_STABLE, "motion at rest is STABLE");
+    check(s.tEnd >= MIN_TIME && s.tEnd >= WINDOW && s.tEnd < WINDOW + 0.01, "motion at rest stops after one window");
+
+    return checkReport("Run classification");
+}
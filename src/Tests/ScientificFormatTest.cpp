@@ -0,0 +1,132 @@
+/*
+ * This file is part of DYTSI.
+ *
+ * DYTSI is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DYTSI is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DYTSI.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * DYnamics Train SImulation (DYTSI)
+ * Copyright (C) 2011-2014 The Technical University of Denmark
+ * Scientific Computing Section
+ * Department of Applied Mathematics and Computer Science
+ *
+ * Author: Daniele Bigoni
+ * E-mail: dabi@dtu.dk
+ *
+ */
+
+/*
+ * Checks of formatScientific against printf("%.10e"): special values, the
+ * rounding at the powers of ten and random values over the whole range.
+ */
+#include "../Application/Output/ScientificFormat.h"
+#include "TestCheck.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+using namespace DYTSI_Output;
+
+// 0 if the outputs are equal, 1 if they differ by one in the last digit, 2 otherwise
+static int compare(double value){
+    char out[MAX_NUMBER_LENGTH + 1];
+    char ref[MAX_NUMBER_LENGTH + 1];
+    int n = formatScientific(value, out);
+    out[n] = '\0';
+    snprintf(ref, sizeof(ref), "%.10e", value);
+    if (strcmp(out, ref) == 0)
+        return 0;
+
+    double a = strtod(out, NULL);
+    double b = strtod(ref, NULL);
+    const char* e = strchr(ref, 'e');
+    if (e == NULL || strlen(out) != strlen(ref) || strchr(out, 'e') - out != e - ref)
+        return 2;
+    double ulp = pow(10.0, atoi(e + 1) - 10);
+    return (fabs(a - b) <= 1.5 * ulp) ? 1 : 2;
+}
+
+static void testExact(double value){
+    char what[64];
+    snprintf(what, sizeof(what), "formatScientific(%.17g) equal to %%.10e", value);
+    check(compare(value) == 0, what);
+}
+
+static double randomValue(){
+    return (double) rand() / RAND_MAX;
+}
+
+int main(int argc, char *argv[])
+{
+    // Special values and values left to snprintf
+    testExact(0.0);
+    testExact(-0.0);
+    testExact(1.0);
+    testExact(-1.0);
+    testExact(0.5);
+    testExact(123456.789);
+    testExact(-2.5e-7);
+    testExact(1e-12);
+    testExact(9.9999999e-13);
+    testExact(1e33);
+    testExact(-9.99e32);
+    testExact(1e-300);
+    testExact(DBL_MIN / 4.0);
+    testExact(DBL_MAX);
+    testExact(INFINITY);
+    testExact(-INFINITY);
+    testExact(NAN);
+
+    // Rounding to the next power of ten
+    testExact(9.99999999996);
+    testExact(9.99999999994);
+    testExact(-9.99999999996e-5);
+    testExact(9.99999999996e20);
+
+    // Powers of ten and their neighbours
+    for (int e = -12; e < 33; e++){
+        double p = pow(10.0, e);
+        testExact(p);
+        testExact(nextafter(p, 0.0));
+        testExact(nextafter(p, INFINITY));
+    }
+
+    // Integers (e.g. the run index) are exact
+    bool integersEqual = true;
+    for (int i = -100000; i <= 100000; i++)
+        integersEqual = integersEqual && compare(i) == 0;
+    check(integersEqual, "formatScientific of the integers");
+
+    // Random values: differences only by one in the last digit, close to ties
+    srand(12345);
+    const int N_RANDOM = 1000000;
+    int nEqual = 0, nLastDigit = 0, nWrong = 0;
+    for (int i = 0; i < N_RANDOM; i++){
+        double value = (1.0 + 9.0 * randomValue()) * pow(10.0, (int) (55 * randomValue()) - 16);
+        if (rand() % 2)
+            value = -value;
+        switch (compare(value)){
+            case 0: nEqual++; break;
+            case 1: nLastDigit++; break;
+            default: nWrong++;
+        }
+    }
+    check(nWrong == 0, "formatScientific of random values");
+    check(nLastDigit <= N_RANDOM / 10000, "formatScientific of random values, last digit");
+
+    printf("formatScientific: %d of %d random values equal, %d in the last digit\n",
+            nEqual, N_RANDOM, nLastDigit);
+    return checkReport("formatScientific");
+}
@@ -23,40 +23,32 @@
  * E-mail: dabi@dtu.dk
  *
  */
+#ifndef TESTCHECK_H
+#define	TESTCHECK_H
 
-/* 
- * File:   Thread.h
- * Author: s083781
- *
- * Created on April 12, 2011, 9:16 AM
- */
+#include <stdio.h>
 
-#ifndef THREAD_H
-#define	THREAD_H
-
-#include <pthread.h>
+/*
+ * Checks of the tests run by make check. Each failed check is printed, and the
+ * test returns checkReport(), which is nonzero if any check failed.
+ */
 
-namespace DYTSI_Modelling {
-    class Thread
-    {
-       public:
-          Thread();
-          int Start(void * arg);
-          void Join();
-       protected:
-          int Run(void * arg);
-          static void * EntryPoint(void*);
-          virtual void Setup();
-          virtual void Execute(void*) = 0;
-          void * Arg() const {return Arg_;}
-          void Arg(void* a){Arg_ = a;}
-       private:
-          pthread_t ThreadId_;
-          void * Arg_;
-          volatile bool m_running;
+inline int& checkFailures(){
+    static int failures = 0;
+    return failures;
+}
 
-    };
+inline void check(bool ok, const char* what){
+    if (!ok){
+        printf("FAIL: %s\n", what);
+        checkFailures()++;
+    }
 }
 
-#endif	/* THREAD_H */
+inline int checkReport(const char* name){
+    if (checkFailures() == 0)
+        printf("%s: all checks passed\n", name);
+    return (checkFailures() == 0) ? 0 : 1;
+}
 
+#endif	/* TESTCHECK_H */